@@ -12,6 +12,162 @@ function(copy_assets target asset_sources destination)
         COMMAND ${CMAKE_COMMAND} -E copy_directory ${asset_sources} "${destination}")
 endfunction()
 
+# Writes the source defining DotNameUtils::AssetIndex::detail::table() for one target: the asset
+# paths (relative to the asset directory, sorted) and their sizes as constexpr arrays. Each target
+# compiles its own copy, so the table is never selected by a per-target macro in a header. The file
+# is only touched when its content changes.
+function(generate_asset_index asset_source_dir asset_files output_source)
+    set(ASSET_RELATIVE_PATHS "")
+    foreach(ASSET_FILE ${asset_files})
+        file(RELATIVE_PATH ASSET_RELATIVE "${asset_source_dir}" "${ASSET_FILE}")
+        list(APPEND ASSET_RELATIVE_PATHS "${ASSET_RELATIVE}")
+    endforeach()
+    list(SORT ASSET_RELATIVE_PATHS)
+
+    set(INDEX_PATHS "")
+    set(INDEX_SIZES "")
+    foreach(ASSET_RELATIVE ${ASSET_RELATIVE_PATHS})
+        file(SIZE "${asset_source_dir}/${ASSET_RELATIVE}" ASSET_SIZE)
+        string(REPLACE "\\" "\\\\" ASSET_ESCAPED "${ASSET_RELATIVE}")
+        string(REPLACE "\"" "\\\"" ASSET_ESCAPED "${ASSET_ESCAPED}")
+        string(APPEND INDEX_PATHS "    \"${ASSET_ESCAPED}\",\n")
+        string(APPEND INDEX_SIZES "    ${ASSET_SIZE}u,\n")
+    endforeach()
+
+    set(INDEX_CONTENT "// Generated by cmake/tmplt-assets.cmake - do not edit\n")
+    string(APPEND INDEX_CONTENT "#include <Utils/Utils.hpp>\n\n")
+    if(ASSET_RELATIVE_PATHS)
+        string(APPEND INDEX_CONTENT "#include <iterator>\n\n")
+        string(APPEND INDEX_CONTENT "namespace {\n")
+        string(APPEND INDEX_CONTENT "  // Sorted by path, relative to the asset directory\n")
+        string(APPEND INDEX_CONTENT "  constexpr std::string_view kPaths[] = {\n${INDEX_PATHS}  };\n")
+        string(APPEND INDEX_CONTENT "  constexpr std::uint64_t kSizes[] = {\n${INDEX_SIZES}  };\n")
+        string(APPEND INDEX_CONTENT "} // namespace\n\n")
+        set(INDEX_TABLE "{ kPaths, kSizes, std::size (kPaths) }")
+    else()
+        set(INDEX_TABLE "{}")
+    endif()
+    string(APPEND INDEX_CONTENT "const DotNameUtils::AssetIndex::detail::Table&\n")
+    string(APPEND INDEX_CONTENT "DotNameUtils::AssetIndex::detail::table () {\n")
+    string(APPEND INDEX_CONTENT "  static constexpr Table generated${INDEX_TABLE};\n")
+    string(APPEND INDEX_CONTENT "  return generated;\n")
+    string(APPEND INDEX_CONTENT "}\n")
+
+    file(WRITE "${output_source}.tmp" "${INDEX_CONTENT}")
+    configure_file("${output_source}.tmp" "${output_source}" COPYONLY)
+    file(REMOVE "${output_source}.tmp")
+endfunction()
+
+# Builds the host tool and packs the asset directory into a single assets.pack next to the loose
+# assets. AssetContext resolves names through the pack first. Skipped when cross compiling (the tool
+# could not run on the build machine) and for Emscripten, which preloads the loose files.
+function(build_asset_pack target asset_source_dir asset_files destination install_destination)
+    if(CMAKE_CROSSCOMPILING OR DOTNAME_CROSSCOMPILING OR CMAKE_SYSTEM_NAME STREQUAL "Emscripten")
+        message(STATUS "Asset pack skipped, loose assets only")
+        return()
+    endif()
+
+    set(ASSET_PACK_TOOL ${target}-assetpack)
+    if(NOT TARGET ${ASSET_PACK_TOOL})
+        add_executable(${ASSET_PACK_TOOL} "${CMAKE_CURRENT_SOURCE_DIR}/../tools/AssetPackTool.cpp")
+        target_include_directories(${ASSET_PACK_TOOL} PRIVATE "${CMAKE_CURRENT_SOURCE_DIR}/../src")
+        target_compile_features(${ASSET_PACK_TOOL} PRIVATE cxx_std_17)
+    endif()
+
+    set(ASSET_PACK_FILE "${CMAKE_CURRENT_BINARY_DIR}/assets.pack")
+    add_custom_command(
+        OUTPUT "${ASSET_PACK_FILE}"
+        COMMAND ${ASSET_PACK_TOOL} "${asset_source_dir}" "${ASSET_PACK_FILE}"
+        DEPENDS ${ASSET_PACK_TOOL} ${asset_files}
+        COMMENT "Packing assets into assets.pack"
+        VERBATIM)
+    add_custom_target(${target}-assets-pack DEPENDS "${ASSET_PACK_FILE}")
+    add_dependencies(${target} ${target}-assets-pack)
+
+    # After copy_assets, so the pack lands in the already created asset directory
+    add_custom_command(
+        TARGET ${target}
+        POST_BUILD
+        COMMAND ${CMAKE_COMMAND} -E copy_if_different "${ASSET_PACK_FILE}" "${destination}")
+    install(FILES "${ASSET_PACK_FILE}" DESTINATION ${install_destination})
+endfunction()
+
+# Compresses the PNG/JPEG assets into KTX2 files next to the originals ("noise.png" ->
+# "noise.ktx2"), which TextureLoader uploads with glCompressedTexImage2D instead of decoding.
+# ASSET_KTX2_FORMAT picks BC1/BC3 ("bc", desktop GPUs) or ETC2 ("etc2", GL ES 3 / WebGL 2 class
+# devices); "none" disables the step. Skipped when cross compiling, like the asset pack.
+set(ASSET_KTX2_FORMAT
+    "bc"
+    CACHE STRING "Block compression of KTX2 texture assets: bc, etc2 or none")
+set_property(CACHE ASSET_KTX2_FORMAT PROPERTY STRINGS bc etc2 none)
+
+function(build_ktx2_textures target asset_source_dir asset_files destination install_destination)
+    if(ASSET_KTX2_FORMAT STREQUAL "none")
+        return()
+    endif()
+    if(CMAKE_CROSSCOMPILING OR DOTNAME_CROSSCOMPILING OR CMAKE_SYSTEM_NAME STREQUAL "Emscripten")
+        message(STATUS "KTX2 textures skipped, images are decoded at runtime")
+        return()
+    endif()
+
+    set(IMAGE_FILES ${asset_files})
+    list(FILTER IMAGE_FILES INCLUDE REGEX "\\.([Pp][Nn][Gg]|[Jj][Pp][Ee]?[Gg])$")
+    if(NOT IMAGE_FILES)
+        return()
+    endif()
+
+    # Only the encoder and the decoder, not CoreLib (GUI, logger, job system)
+    set(KTX2_TOOL ${target}-ktx2)
+    if(NOT TARGET ${KTX2_TOOL})
+        # Same package as CoreLib, only here for stb_image.h
+        CPMAddPackage(
+            NAME stb
+            GITHUB_REPOSITORY nothings/stb
+            GIT_TAG master)
+        set(KTX2_SOURCE_DIR "${CMAKE_CURRENT_SOURCE_DIR}/../src")
+        add_executable(
+            ${KTX2_TOOL}
+            "${CMAKE_CURRENT_SOURCE_DIR}/../tools/Ktx2Tool.cpp"
+            "${KTX2_SOURCE_DIR}/Assets/Ktx2.cpp"
+            "${KTX2_SOURCE_DIR}/Assets/BlockCompression.cpp"
+            "${KTX2_SOURCE_DIR}/Assets/ImageDecoder.cpp"
+            "${KTX2_SOURCE_DIR}/Assets/StbImage.cpp")
+        target_include_directories(${KTX2_TOOL} PRIVATE "${KTX2_SOURCE_DIR}" ${stb_SOURCE_DIR})
+        target_compile_features(${KTX2_TOOL} PRIVATE cxx_std_17)
+    endif()
+
+    set(KTX2_OUTPUTS "")
+    foreach(IMAGE_FILE ${IMAGE_FILES})
+        file(RELATIVE_PATH IMAGE_RELATIVE "${asset_source_dir}" "${IMAGE_FILE}")
+        get_filename_component(IMAGE_DIR "${IMAGE_RELATIVE}" DIRECTORY)
+        get_filename_component(IMAGE_STEM "${IMAGE_RELATIVE}" NAME_WLE)
+        if(IMAGE_DIR)
+            set(KTX2_RELATIVE "${IMAGE_DIR}/${IMAGE_STEM}.ktx2")
+        else()
+            set(KTX2_RELATIVE "${IMAGE_STEM}.ktx2")
+        endif()
+        set(KTX2_FILE "${CMAKE_CURRENT_BINARY_DIR}/ktx2/${KTX2_RELATIVE}")
+        get_filename_component(KTX2_FILE_DIR "${KTX2_FILE}" DIRECTORY)
+        add_custom_command(
+            OUTPUT "${KTX2_FILE}"
+            COMMAND ${CMAKE_COMMAND} -E make_directory "${KTX2_FILE_DIR}"
+            COMMAND ${KTX2_TOOL} --format ${ASSET_KTX2_FORMAT} --mips "${IMAGE_FILE}" "${KTX2_FILE}"
+            DEPENDS ${KTX2_TOOL} "${IMAGE_FILE}"
+            COMMENT "Compressing ${IMAGE_RELATIVE} to KTX2"
+            VERBATIM)
+        list(APPEND KTX2_OUTPUTS "${KTX2_FILE}")
+    endforeach()
+    add_custom_target(${target}-ktx2-textures DEPENDS ${KTX2_OUTPUTS})
+    add_dependencies(${target} ${target}-ktx2-textures)
+
+    # After copy_assets, the KTX2 tree mirrors the asset directory
+    add_custom_command(
+        TARGET ${target}
+        POST_BUILD
+        COMMAND ${CMAKE_COMMAND} -E copy_directory "${CMAKE_CURRENT_BINARY_DIR}/ktx2" "${destination}")
+    install(DIRECTORY "${CMAKE_CURRENT_BINARY_DIR}/ktx2/" DESTINATION ${install_destination})
+endfunction()
+
 function(apply_assets_processing_standalone)
 
     # Source destination
@@ -33,6 +189,12 @@ function(apply_assets_processing_standalone)
     # Check if assets exist
     file(GLOB_RECURSE ASSET_FILES "${ASSET_SOURCE_DIR}/*")
 
+    # Sorted asset index compiled into the binary, so startup can binary search the asset list
+    # instead of splitting and parsing UTILS_ASSET_FILES_DIVIDED_BY_COMMAS. Empty without assets.
+    set(ASSET_INDEX_SOURCE "${CMAKE_CURRENT_BINARY_DIR}/generated/AssetIndex.cpp")
+    generate_asset_index("${ASSET_SOURCE_DIR}" "${ASSET_FILES}" "${ASSET_INDEX_SOURCE}")
+    target_sources(${STANDALONE_NAME} PRIVATE "${ASSET_INDEX_SOURCE}")
+
     if(NOT ASSET_FILES)
         message(STATUS "No asset files found in ${ASSET_SOURCE_DIR}.")
         target_compile_definitions(
@@ -58,11 +220,16 @@ function(apply_assets_processing_standalone)
     # Copy and install assets
     copy_assets(${STANDALONE_NAME} "${ASSET_SOURCE_DIR}" "${ASSET_BUILD_DIR}")
     install(DIRECTORY ${ASSET_SOURCE_DIR} DESTINATION ${INSTALL_DESTINATION})
+    build_asset_pack(${STANDALONE_NAME} "${ASSET_SOURCE_DIR}" "${ASSET_FILES}" "${ASSET_BUILD_DIR}"
+                     "${INSTALL_DESTINATION}")
+    build_ktx2_textures(${STANDALONE_NAME} "${ASSET_SOURCE_DIR}" "${ASSET_FILES}" "${ASSET_BUILD_DIR}"
+                        "${INSTALL_DESTINATION}")
 
     # Set compilation definitions for asset paths
     target_compile_definitions(
         ${STANDALONE_NAME}
         PRIVATE UTILS_ASSET_PATH="${ASSET_PATH_DEFINE}"
                 UTILS_FIRST_ASSET_FILE="${FIRST_ASSET_FILE}"
-                UTILS_ASSET_FILES="${ASSET_FILE_NAMES_STR}")
+                UTILS_ASSET_FILES="${ASSET_FILE_NAMES_STR}"
+                UTILS_ASSET_FILES_DIVIDED_BY_COMMAS="${ASSET_FILE_NAMES_STR}")
 endfunction()
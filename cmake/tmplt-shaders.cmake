@@ -0,0 +1,111 @@
+# MIT License Copyright (c) 2024-2025 Tomáš Mark
+
+# Converts the bundled ShaderToy shaders (src/Shaders/Shadertoy/*.hpp) for every ShaderTarget at
+# build time. A host tool built from ShaderConvertor writes generated/ShaderTable.hpp, a constexpr
+# table with the converted sources, their hashes and the analysis, which is compiled into the
+# target (SHADER_TABLE_HEADER). Startup then only looks the shader up and compiles it.
+#
+# The tool has to run on the build machine. When cross compiling (and for Emscripten) point
+# SHADER_TABLE_TOOL at a host build of it, e.g. <host build>/CoreLib-shadertable; without one the
+# table is skipped and shaders are converted at runtime as before.
+set(SHADER_TABLE_TOOL
+    ""
+    CACHE FILEPATH "Host ShaderTableTool executable used when cross compiling")
+
+function(generate_shader_table target)
+    set(SHADER_TABLE_TOOL_COMMAND "${SHADER_TABLE_TOOL}")
+    if(NOT SHADER_TABLE_TOOL_COMMAND)
+        if(CMAKE_CROSSCOMPILING
+           OR DOTNAME_CROSSCOMPILING
+           OR CMAKE_SYSTEM_NAME STREQUAL "Emscripten")
+            message(STATUS "Shader table skipped, shaders are converted at runtime")
+            return()
+        endif()
+
+        # Only the converter, not the library it is generating data for
+        set(SHADER_TABLE_TOOL_COMMAND ${target}-shadertable)
+        if(NOT TARGET ${SHADER_TABLE_TOOL_COMMAND})
+            add_executable(
+                ${SHADER_TABLE_TOOL_COMMAND}
+                "${CMAKE_CURRENT_SOURCE_DIR}/tools/ShaderTableTool.cpp"
+                "${CMAKE_CURRENT_SOURCE_DIR}/src/Shaders/ShaderTable.cpp"
+                "${CMAKE_CURRENT_SOURCE_DIR}/src/Shaders/ShaderConvertor.cpp")
+            target_include_directories(${SHADER_TABLE_TOOL_COMMAND}
+                                       PRIVATE "${CMAKE_CURRENT_SOURCE_DIR}/src")
+            target_compile_features(${SHADER_TABLE_TOOL_COMMAND} PRIVATE cxx_std_17)
+        endif()
+    endif()
+
+    file(GLOB SHADERTOY_HEADERS CONFIGURE_DEPENDS
+         "${CMAKE_CURRENT_SOURCE_DIR}/src/Shaders/Shadertoy/*.hpp")
+    list(SORT SHADERTOY_HEADERS)
+
+    set(SHADER_TABLE_HEADER "${CMAKE_CURRENT_BINARY_DIR}/generated/ShaderTable.hpp")
+    add_custom_command(
+        OUTPUT "${SHADER_TABLE_HEADER}"
+        COMMAND ${CMAKE_COMMAND} -E make_directory "${CMAKE_CURRENT_BINARY_DIR}/generated"
+        COMMAND ${SHADER_TABLE_TOOL_COMMAND} "${SHADER_TABLE_HEADER}" ${SHADERTOY_HEADERS}
+        DEPENDS ${SHADER_TABLE_TOOL_COMMAND} ${SHADERTOY_HEADERS}
+        COMMENT "Converting bundled shaders into ShaderTable.hpp"
+        VERBATIM)
+
+    # Listed as a source so the table is generated before anything includes it
+    target_sources(${target} PRIVATE "${SHADER_TABLE_HEADER}")
+    set_source_files_properties(
+        "${CMAKE_CURRENT_SOURCE_DIR}/src/Shaders/ShaderTable.cpp"
+        PROPERTIES OBJECT_DEPENDS "${SHADER_TABLE_HEADER}")
+    target_compile_definitions(${target} PRIVATE SHADER_TABLE_HEADER="${SHADER_TABLE_HEADER}")
+endfunction()
+
+# Writes generated/ShadertoySources.hpp: every src/Shaders/Shadertoy/*.hpp that defines a
+# fragmentShaderToy<Name> is included and listed as { "<Name>", &::fragmentShaderToy<Name> }, which
+# ShaderRegistry registers on first use. Dropping a new header into the directory is enough to
+# make the shader known everywhere. Only touched when the content changes.
+function(generate_shadertoy_sources target)
+    file(GLOB SHADERTOY_HEADERS CONFIGURE_DEPENDS
+         "${CMAKE_CURRENT_SOURCE_DIR}/src/Shaders/Shadertoy/*.hpp")
+    list(SORT SHADERTOY_HEADERS)
+    # Renaming the variable inside a header has to regenerate the list as well
+    set_property(
+        DIRECTORY
+        APPEND
+        PROPERTY CMAKE_CONFIGURE_DEPENDS ${SHADERTOY_HEADERS})
+
+    set(SOURCES_INCLUDES "")
+    set(SOURCES_ENTRIES "")
+    foreach(SHADERTOY_HEADER ${SHADERTOY_HEADERS})
+        file(STRINGS "${SHADERTOY_HEADER}" SHADERTOY_DEFINITION
+             REGEX "const char\\* fragmentShaderToy[A-Za-z0-9_]+ *=" LIMIT_COUNT 1)
+        if(NOT SHADERTOY_DEFINITION MATCHES "fragmentShaderToy([A-Za-z0-9_]+)")
+            continue()
+        endif()
+        set(SHADERTOY_NAME "${CMAKE_MATCH_1}")
+        if(SHADERTOY_NAME STREQUAL "Template")
+            continue()
+        endif()
+        string(APPEND SOURCES_INCLUDES "#include \"${SHADERTOY_HEADER}\"\n")
+        string(APPEND SOURCES_ENTRIES
+               "    { \"${SHADERTOY_NAME}\", &::fragmentShaderToy${SHADERTOY_NAME} },\n")
+    endforeach()
+
+    set(SOURCES_HEADER "${CMAKE_CURRENT_BINARY_DIR}/generated/ShadertoySources.hpp")
+    set(SOURCES_CONTENT "// Generated by cmake/tmplt-shaders.cmake - do not edit\n")
+    string(APPEND SOURCES_CONTENT "#ifndef SHADERS_GENERATED_SHADERTOY_SOURCES_HPP\n")
+    string(APPEND SOURCES_CONTENT "#define SHADERS_GENERATED_SHADERTOY_SOURCES_HPP\n\n")
+    # The shader headers define globals, they are included at file scope, not inside the namespace
+    string(APPEND SOURCES_CONTENT "${SOURCES_INCLUDES}\n")
+    string(APPEND SOURCES_CONTENT "namespace ShadertoySources {\n")
+    string(APPEND SOURCES_CONTENT "  struct Entry {\n    const char* name;\n")
+    string(APPEND SOURCES_CONTENT "    const char* const* source;\n  };\n\n")
+    string(APPEND SOURCES_CONTENT "  // Sorted by file name, constant initialized\n")
+    string(APPEND SOURCES_CONTENT "  inline constexpr Entry kBundled[] = {\n")
+    string(APPEND SOURCES_CONTENT "${SOURCES_ENTRIES}  };\n")
+    string(APPEND SOURCES_CONTENT "} // namespace ShadertoySources\n\n")
+    string(APPEND SOURCES_CONTENT "#endif // SHADERS_GENERATED_SHADERTOY_SOURCES_HPP\n")
+
+    file(WRITE "${SOURCES_HEADER}.tmp" "${SOURCES_CONTENT}")
+    configure_file("${SOURCES_HEADER}.tmp" "${SOURCES_HEADER}" COPYONLY)
+    file(REMOVE "${SOURCES_HEADER}.tmp")
+
+    target_compile_definitions(${target} PRIVATE SHADERTOY_SOURCES_HEADER="${SOURCES_HEADER}")
+endfunction()
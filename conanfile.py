@@ -46,10 +46,8 @@ class ProjectTemplateRecipe(ConanFile):
         self.dotnameintegrated_update_cmake_presets()
         self.dotnameintegrated_patch_remove_stdcpp_from_system_libs()
 
-        # Copy ImGui bindings after tc.generate()
-        copy(self, "*opengl3*", 
-             os.path.join(self.dependencies["imgui"].package_folder, "res", "bindings"), 
-             os.path.join(self.source_folder, "src/bindings"))
+        # Copy ImGui bindings after tc.generate(). The OpenGL3 backend is a local fork in
+        # src/Gui/ImGuiOpenGL3Backend.*, copying the stock one would replace or duplicate it.
         copy(self, "*sdl2*", 
              os.path.join(self.dependencies["imgui"].package_folder, "res", "bindings"), 
              os.path.join(self.source_folder, "src/bindings"))
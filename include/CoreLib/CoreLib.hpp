@@ -12,13 +12,20 @@
 
 namespace dotname {
 
+  struct CoreLibOptions {
+    // Desktop only: SDL events and ImGui on the main thread, GL drawing on a render thread
+    bool threadedRendering = false;
+    // JobSystem::shared () workers, 0 picks one per core minus the main thread
+    unsigned jobWorkers = 0;
+  };
+
   class CoreLib {
 
     const std::string libName_ = std::string ("CoreLib v.") + CORELIB_VERSION;
 
   public:
     CoreLib ();
-    CoreLib (const std::filesystem::path& assetsPath);
+    CoreLib (const std::filesystem::path& assetsPath, const CoreLibOptions& options = {});
     ~CoreLib ();
   };
 
@@ -0,0 +1,167 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Byte-budgeted LRU cache of decoded assets with reference-counted handles
+
+#ifndef __ASSETCACHE_H__
+#define __ASSETCACHE_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+// Handles are shared_ptr<const T>. Eviction only drops the cache's reference, so a handle stays
+// valid for as long as somebody holds it. Entries that are still referenced outside the cache are
+// skipped by eviction - dropping them would free nothing - so the resident size can exceed the
+// budget while everything is in use.
+//
+// Keys are the asset path plus the decode parameters (see makeKey). Thread-safe; the factory in
+// getOrCreate runs outside the lock, concurrent misses for one key may both decode and the first
+// insert wins.
+template <typename T> class AssetCache {
+public:
+  using Handle = std::shared_ptr<const T>;
+
+  struct Stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+    std::size_t entries = 0;
+    std::size_t bytesResident = 0;
+    std::size_t bytesBudget = 0;
+  };
+
+  explicit AssetCache (std::size_t budgetBytes) : budget_ (budgetBytes) {
+  }
+
+  AssetCache (const AssetCache&) = delete;
+  AssetCache& operator= (const AssetCache&) = delete;
+
+  // "path#params"
+  static std::string makeKey (std::string_view path, std::string_view params) {
+    std::string key;
+    key.reserve (path.size () + params.size () + 1);
+    key.append (path).append (1, '#').append (params);
+    return key;
+  }
+
+  // nullptr on a miss
+  Handle find (const std::string& key) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = index_.find (key);
+    if (it == index_.end ()) {
+      ++stats_.misses;
+      return nullptr;
+    }
+    ++stats_.hits;
+    lru_.splice (lru_.begin (), lru_, it->second);
+    return it->second->value;
+  }
+
+  // Replaces an existing entry with the same key
+  Handle insert (const std::string& key, std::shared_ptr<const T> value, std::size_t bytes) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return insertLocked (key, std::move (value), bytes, true);
+  }
+
+  // factory () -> std::pair<std::shared_ptr<const T>, std::size_t bytes>, a null value is not
+  // cached and returned as is
+  template <typename Factory> Handle getOrCreate (const std::string& key, Factory&& factory) {
+    if (Handle hit = find (key)) {
+      return hit;
+    }
+    auto [value, bytes] = factory ();
+    if (!value) {
+      return nullptr;
+    }
+    std::lock_guard<std::mutex> lock (mutex_);
+    return insertLocked (key, std::move (value), bytes, false);
+  }
+
+  void erase (const std::string& key) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = index_.find (key);
+    if (it != index_.end ()) {
+      bytes_ -= it->second->bytes;
+      lru_.erase (it->second);
+      index_.erase (it);
+    }
+  }
+
+  void clear () {
+    std::lock_guard<std::mutex> lock (mutex_);
+    lru_.clear ();
+    index_.clear ();
+    bytes_ = 0;
+  }
+
+  void setBudget (std::size_t budgetBytes) {
+    std::lock_guard<std::mutex> lock (mutex_);
+    budget_ = budgetBytes;
+    trimLocked ();
+  }
+
+  Stats stats () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    Stats out = stats_;
+    out.entries = index_.size ();
+    out.bytesResident = bytes_;
+    out.bytesBudget = budget_;
+    return out;
+  }
+
+private:
+  struct Entry {
+    std::string key;
+    Handle value;
+    std::size_t bytes = 0;
+  };
+
+  Handle insertLocked (const std::string& key, std::shared_ptr<const T> value, std::size_t bytes,
+                       bool replace) {
+    auto it = index_.find (key);
+    if (it != index_.end ()) {
+      if (!replace) {
+        lru_.splice (lru_.begin (), lru_, it->second);
+        return it->second->value; // somebody else inserted it first
+      }
+      bytes_ -= it->second->bytes;
+      lru_.erase (it->second);
+      index_.erase (it);
+    }
+    lru_.push_front ({ key, std::move (value), bytes });
+    index_.emplace (key, lru_.begin ());
+    bytes_ += bytes;
+    Handle handle = lru_.front ().value;
+    trimLocked ();
+    return handle;
+  }
+
+  // Least recently used first, referenced entries are kept
+  void trimLocked () {
+    for (auto it = lru_.end (); bytes_ > budget_ && it != lru_.begin ();) {
+      --it;
+      if (it->value.use_count () > 1) {
+        continue;
+      }
+      bytes_ -= it->bytes;
+      index_.erase (it->key);
+      it = lru_.erase (it);
+      ++stats_.evictions;
+    }
+  }
+
+  mutable std::mutex mutex_;
+  std::list<Entry> lru_; // most recently used first
+  std::unordered_map<std::string, typename std::list<Entry>::iterator> index_;
+  std::size_t bytes_ = 0;
+  std::size_t budget_;
+  Stats stats_;
+};
+
+#endif // __ASSETCACHE_H__
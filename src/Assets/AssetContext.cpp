@@ -1,20 +1,50 @@
 #include "AssetContext.hpp"
+#include "AssetPack.hpp"
 
 namespace {
   std::filesystem::path g_assetsPath;
+  AssetPack g_assetPack;
 }
 
 namespace AssetContext {
 
   void clearAssetsPath (void) {
     g_assetsPath.clear ();
+    g_assetPack.close ();
   }
 
   void setAssetsPath (const std::filesystem::path& path) {
     g_assetsPath = path;
+    g_assetPack.close ();
+    std::error_code ec;
+    const std::filesystem::path packFile = path / AssetPackFormat::kFileName;
+    if (std::filesystem::is_regular_file (packFile, ec) && g_assetPack.open (packFile)) {
+      LOG_D_FMT ("Asset pack: {} ({} entries)", packFile.string (), g_assetPack.size ());
+    }
   }
 
   const std::filesystem::path& getAssetsPath () {
     return g_assetsPath;
   }
-}
\ No newline at end of file
+
+  const AssetPack* getAssetPack () {
+    return g_assetPack.isOpen () ? &g_assetPack : nullptr;
+  }
+
+  AssetBlob openAsset (std::string_view name) {
+    if (g_assetPack.isOpen ()) {
+      if (std::optional<std::string_view> packed = g_assetPack.data (name)) {
+        return AssetBlob (*packed);
+      }
+    }
+    return AssetBlob (DotNameUtils::FileIO::MappedFile (g_assetsPath / std::filesystem::path (name)));
+  }
+
+  std::optional<AssetBlob> tryOpenAsset (std::string_view name) {
+    try {
+      return openAsset (name);
+    } catch (const std::exception&) {
+      return std::nullopt;
+    }
+  }
+}
@@ -1,12 +1,83 @@
 #ifndef __ASSETCONTEXT_H__
 #define __ASSETCONTEXT_H__
 
+#include <Assets/AssetPack.hpp>
+
 #include <filesystem>
+#include <optional>
+#include <string_view>
 
 namespace AssetContext {
   void clearAssetsPath (void);
   void setAssetsPath (const std::filesystem::path& path);
   const std::filesystem::path& getAssetsPath ();
+
+  // Asset contents, either a view into the asset pack (valid until the assets path changes) or a
+  // loose file mapped on demand
+  class AssetBlob {
+  public:
+    AssetBlob () = default;
+
+    explicit AssetBlob (std::string_view packed) : view_ (packed), packed_ (true) {
+    }
+
+    explicit AssetBlob (DotNameUtils::FileIO::MappedFile file)
+        : file_ (std::move (file)), view_ (file_.view ()) {
+    }
+
+    AssetBlob (AssetBlob&& other) noexcept {
+      *this = std::move (other);
+    }
+
+    AssetBlob& operator= (AssetBlob&& other) noexcept {
+      if (this != &other) {
+        file_ = std::move (other.file_);
+        packed_ = other.packed_;
+        view_ = packed_ ? other.view_ : file_.view ();
+        other.view_ = {};
+      }
+      return *this;
+    }
+
+    const char* data () const {
+      return view_.data () != nullptr ? view_.data () : "";
+    }
+
+    std::size_t size () const {
+      return view_.size ();
+    }
+
+    bool empty () const {
+      return view_.empty ();
+    }
+
+    std::string_view view () const {
+      return view_;
+    }
+
+    const unsigned char* bytes () const {
+      return reinterpret_cast<const unsigned char*> (data ());
+    }
+
+    // True when served from assets.pack
+    bool isPacked () const {
+      return packed_;
+    }
+
+  private:
+    DotNameUtils::FileIO::MappedFile file_;
+    std::string_view view_;
+    bool packed_ = false;
+  };
+
+  // Pack first, then <assets path>/<name>. Throws std::ios_base::failure when neither exists.
+  AssetBlob openAsset (std::string_view name);
+
+  // Same lookup, nullopt instead of an exception
+  std::optional<AssetBlob> tryOpenAsset (std::string_view name);
+
+  // The pack opened by setAssetsPath, nullptr when the assets are loose files
+  const AssetPack* getAssetPack ();
 }
 
 #endif // __ASSETCONTEXT_H__
\ No newline at end of file
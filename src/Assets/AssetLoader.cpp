@@ -0,0 +1,201 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "AssetLoader.hpp"
+#include <Utils/Profiler.hpp>
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+AssetLoader::AssetLoader (std::size_t workers) {
+  workers_.reserve (workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back ([this] { workerLoop (); });
+  }
+}
+
+AssetLoader::~AssetLoader () {
+  {
+    std::lock_guard<std::mutex> lock (mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all ();
+  for (std::thread& worker : workers_) {
+    worker.join ();
+  }
+
+  std::vector<Callback> cancelled;
+  for (auto& [name, job] : inFlight_) {
+    if (!job->claimed.exchange (true)) {
+      job->promise.set_exception (
+          std::make_exception_ptr (std::runtime_error ("AssetLoader stopped before loading " + name)));
+      std::move (job->callbacks.begin (), job->callbacks.end (), std::back_inserter (cancelled));
+      job->callbacks.clear ();
+    }
+  }
+
+  // Nobody pumps any more, whoever waits on a callback still gets one
+  pump ();
+  for (Callback& callback : cancelled) {
+    callback (nullptr);
+  }
+}
+
+std::size_t AssetLoader::defaultWorkerCount () {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+  return 0;
+#else
+  // I/O bound, a couple of threads keep the disk busy without competing with the render thread
+  return std::clamp<std::size_t> (std::thread::hardware_concurrency () / 2, 1, 4);
+#endif
+}
+
+std::shared_ptr<AssetLoader::Job> AssetLoader::enqueue (std::string_view name,
+                                                        AssetPriority priority,
+                                                        Callback onComplete) {
+  std::shared_ptr<Job> job;
+  {
+    std::lock_guard<std::mutex> lock (mutex_);
+    ++stats_.requested;
+    auto it = inFlight_.find (std::string (name));
+    if (it != inFlight_.end ()) {
+      job = it->second;
+      ++stats_.deduplicated;
+      // Promote a queued load; the stale queue entry is skipped once the job is claimed
+      if (priority < job->priority && !job->claimed.load ()) {
+        job->priority = priority;
+        queue_.push ({ priority, nextOrder_++, job });
+      }
+    } else {
+      job = std::make_shared<Job> ();
+      job->name = std::string (name);
+      job->priority = priority;
+      job->future = job->promise.get_future ().share ();
+      inFlight_.emplace (job->name, job);
+      queue_.push ({ priority, nextOrder_++, job });
+    }
+    if (onComplete) {
+      job->callbacks.push_back (std::move (onComplete));
+    }
+  }
+  wake_.notify_one ();
+  return job;
+}
+
+std::shared_future<AssetLoader::Asset> AssetLoader::request (std::string_view name,
+                                                             AssetPriority priority) {
+  return enqueue (name, priority, nullptr)->future;
+}
+
+void AssetLoader::request (std::string_view name, AssetPriority priority, Callback onComplete) {
+  enqueue (name, priority, std::move (onComplete));
+}
+
+AssetLoader::Asset AssetLoader::load (std::string_view name) {
+  std::shared_ptr<Job> job = enqueue (name, AssetPriority::Immediate, nullptr);
+  run (job); // no-op when a worker already has it
+  return job->future.get ();
+}
+
+void AssetLoader::run (const std::shared_ptr<Job>& job) {
+  if (job->claimed.exchange (true)) {
+    return;
+  }
+  PROFILE_SCOPE ("AssetLoader::run");
+
+  Asset asset;
+  try {
+    asset = std::make_shared<const AssetContext::AssetBlob> (AssetContext::openAsset (job->name));
+    job->promise.set_value (asset);
+  } catch (const std::exception& e) {
+    LOG_E_FMT ("Failed to load asset {}: {}", job->name, e.what ());
+    job->promise.set_exception (std::current_exception ());
+  }
+
+  std::vector<Callback> callbacks;
+  {
+    std::lock_guard<std::mutex> lock (mutex_);
+    auto it = inFlight_.find (job->name);
+    if (it != inFlight_.end () && it->second == job) {
+      inFlight_.erase (it);
+    }
+    callbacks.swap (job->callbacks);
+    ++(asset ? stats_.loaded : stats_.failed);
+  }
+  if (!callbacks.empty ()) {
+    std::lock_guard<std::mutex> lock (completedMutex_);
+    for (Callback& callback : callbacks) {
+      completed_.emplace_back (std::move (callback), asset);
+    }
+  }
+}
+
+// mutex_ held
+std::shared_ptr<AssetLoader::Job> AssetLoader::popQueued () {
+  while (!queue_.empty ()) {
+    std::shared_ptr<Job> job = queue_.top ().job;
+    queue_.pop ();
+    if (!job->claimed.load ()) {
+      return job;
+    }
+  }
+  return nullptr;
+}
+
+void AssetLoader::workerLoop () {
+  PROFILE_THREAD ("AssetLoader worker");
+  std::unique_lock<std::mutex> lock (mutex_);
+  while (true) {
+    wake_.wait (lock, [this] { return stopping_ || !queue_.empty (); });
+    if (stopping_) {
+      return;
+    }
+    std::shared_ptr<Job> job = popQueued ();
+    if (job) {
+      lock.unlock ();
+      run (job);
+      lock.lock ();
+    }
+  }
+}
+
+std::size_t AssetLoader::pump (std::size_t maxCallbacks) {
+  if (workers_.empty ()) {
+    while (true) {
+      std::shared_ptr<Job> job;
+      {
+        std::lock_guard<std::mutex> lock (mutex_);
+        job = popQueued ();
+      }
+      if (!job) {
+        break;
+      }
+      run (job);
+    }
+  }
+
+  std::vector<std::pair<Callback, Asset>> ready;
+  {
+    std::lock_guard<std::mutex> lock (completedMutex_);
+    if (completed_.empty ()) {
+      return 0;
+    }
+    const std::size_t count = std::min (maxCallbacks, completed_.size ());
+    ready.assign (std::make_move_iterator (completed_.begin ()),
+                  std::make_move_iterator (completed_.begin () + count));
+    completed_.erase (completed_.begin (), completed_.begin () + count);
+  }
+  for (auto& [callback, asset] : ready) {
+    callback (asset);
+  }
+  return ready.size ();
+}
+
+AssetLoader::Stats AssetLoader::stats () const {
+  std::lock_guard<std::mutex> lock (mutex_);
+  Stats out = stats_;
+  out.queued = static_cast<std::size_t> (std::count_if (
+      inFlight_.begin (), inFlight_.end (), [] (const auto& item) { return !item.second->claimed; }));
+  return out;
+}
@@ -0,0 +1,120 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Asynchronous asset loading: worker pool, priorities, deduplication, render thread callbacks
+
+#ifndef __ASSETLOADER_H__
+#define __ASSETLOADER_H__
+
+#include <Assets/AssetContext.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum class AssetPriority : int {
+  Immediate = 0, // somebody is about to block on it
+  Prefetch = 1,  // needed in the next frames
+  Background = 2 // nice to have
+};
+
+// Loads assets (pack first, see AssetContext::openAsset) on a small worker pool. Requests for a
+// name that is already queued or loading share one load; a higher priority request promotes the
+// queued one. Results come back as a shared_future and/or as a callback that runs inside pump(),
+// i.e. on whichever thread owns the loader - the render thread in PlatformManager.
+//
+// With zero workers (Emscripten without pthreads) the queued loads run inside pump() as well.
+class AssetLoader {
+public:
+  using Asset = std::shared_ptr<const AssetContext::AssetBlob>;
+  using Callback = std::function<void (const Asset& asset)>; // nullptr asset when loading failed
+
+  struct Stats {
+    std::uint64_t requested = 0;
+    std::uint64_t deduplicated = 0; // joined a load already in flight
+    std::uint64_t loaded = 0;
+    std::uint64_t failed = 0;
+    std::size_t queued = 0;
+  };
+
+  explicit AssetLoader (std::size_t workers = defaultWorkerCount ());
+  // Stops the workers; loads that did not start fail with std::runtime_error. Every callback
+  // still pending runs here, on the destroying thread: completed loads with their asset, loads
+  // that did not start with nullptr. Callbacks must not use the loader any more.
+  ~AssetLoader ();
+
+  AssetLoader (const AssetLoader&) = delete;
+  AssetLoader& operator= (const AssetLoader&) = delete;
+
+  std::shared_future<Asset> request (std::string_view name,
+                                     AssetPriority priority = AssetPriority::Prefetch);
+  void request (std::string_view name, AssetPriority priority, Callback onComplete);
+
+  // Blocking. Runs the load on the calling thread when no worker has picked it up yet, otherwise
+  // waits for it. Throws std::ios_base::failure like AssetContext::openAsset.
+  Asset load (std::string_view name);
+
+  // Runs completed callbacks (at most maxCallbacks), returns how many ran
+  std::size_t pump (std::size_t maxCallbacks = SIZE_MAX);
+
+  Stats stats () const;
+
+  std::size_t workerCount () const {
+    return workers_.size ();
+  }
+
+  static std::size_t defaultWorkerCount ();
+
+private:
+  struct Job {
+    std::string name;
+    AssetPriority priority = AssetPriority::Background;
+    std::promise<Asset> promise;
+    std::shared_future<Asset> future;
+    std::vector<Callback> callbacks; // guarded by mutex_
+    std::atomic<bool> claimed{ false };
+  };
+
+  struct QueueItem {
+    AssetPriority priority;
+    std::uint64_t order;
+    std::shared_ptr<Job> job;
+  };
+
+  // Highest priority first, FIFO within a priority
+  struct LaterFirst {
+    bool operator() (const QueueItem& a, const QueueItem& b) const {
+      return a.priority != b.priority ? a.priority > b.priority : a.order > b.order;
+    }
+  };
+
+  std::shared_ptr<Job> enqueue (std::string_view name, AssetPriority priority, Callback onComplete);
+  void run (const std::shared_ptr<Job>& job);
+  std::shared_ptr<Job> popQueued ();
+  void workerLoop ();
+
+  mutable std::mutex mutex_;
+  std::condition_variable wake_;
+  std::priority_queue<QueueItem, std::vector<QueueItem>, LaterFirst> queue_;
+  std::unordered_map<std::string, std::shared_ptr<Job>> inFlight_;
+  std::uint64_t nextOrder_ = 0;
+  bool stopping_ = false;
+  Stats stats_;
+
+  std::mutex completedMutex_;
+  std::vector<std::pair<Callback, Asset>> completed_;
+
+  std::vector<std::thread> workers_;
+};
+
+#endif // __ASSETLOADER_H__
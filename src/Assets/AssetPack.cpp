@@ -0,0 +1,105 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "AssetPack.hpp"
+
+bool AssetPack::open (const std::filesystem::path& packFile) {
+  close ();
+  try {
+    file_ = DotNameUtils::FileIO::MappedFile (packFile,
+                                              DotNameUtils::FileIO::MappedFile::Access::Random);
+  } catch (const std::exception& e) {
+    LOG_D_FMT ("Asset pack not opened: {}", e.what ());
+    return false;
+  }
+
+  AssetPackFormat::Header header;
+  const std::uint64_t fileSize = file_.size ();
+  if (fileSize < AssetPackFormat::kHeaderSize || !AssetPackFormat::decodeHeader (file_.bytes (), header)) {
+    LOG_E_FMT ("Not an asset pack (or unsupported version): {}", packFile.string ());
+    close ();
+    return false;
+  }
+  const std::uint64_t tocSize = std::uint64_t{ header.entryCount } * AssetPackFormat::kTocEntrySize;
+  if (header.fileSize != fileSize || header.tocOffset > fileSize
+      || tocSize > fileSize - header.tocOffset || header.stringsOffset > fileSize
+      || header.stringsSize > fileSize - header.stringsOffset) {
+    LOG_E_FMT ("Asset pack is truncated or corrupt: {}", packFile.string ());
+    close ();
+    return false;
+  }
+
+  header_ = header;
+  open_ = true;
+  return true;
+}
+
+void AssetPack::close () {
+  file_ = DotNameUtils::FileIO::MappedFile ();
+  header_ = AssetPackFormat::Header ();
+  open_ = false;
+}
+
+std::string_view AssetPack::nameAt (std::size_t index) const {
+  const unsigned char* toc
+      = file_.bytes () + header_.tocOffset + index * AssetPackFormat::kTocEntrySize;
+  const std::uint64_t offset = AssetPackFormat::readU32 (toc + 24);
+  const std::uint64_t length = AssetPackFormat::readU32 (toc + 28);
+  if (offset > header_.stringsSize || length > header_.stringsSize - offset) {
+    return {};
+  }
+  return std::string_view (file_.data () + header_.stringsOffset + offset, length);
+}
+
+std::optional<AssetPack::Entry> AssetPack::entry (std::size_t index) const {
+  if (index >= header_.entryCount) {
+    return std::nullopt;
+  }
+  const AssetPackFormat::TocEntry toc = AssetPackFormat::decodeTocEntry (
+      file_.bytes () + header_.tocOffset + index * AssetPackFormat::kTocEntrySize);
+  if (toc.dataOffset > file_.size () || toc.storedSize > file_.size () - toc.dataOffset) {
+    LOG_E_FMT ("Asset pack entry {} points outside the pack", index);
+    return std::nullopt;
+  }
+
+  Entry out;
+  out.name = nameAt (index);
+  out.size = toc.size;
+  out.codec = toc.codec;
+  if (toc.codec == AssetPackFormat::Codec::Stored) {
+    out.data = std::string_view (file_.data () + toc.dataOffset,
+                                 static_cast<std::size_t> (toc.storedSize));
+  }
+  return out;
+}
+
+std::optional<AssetPack::Entry> AssetPack::find (std::string_view name) const {
+  std::size_t low = 0;
+  std::size_t high = header_.entryCount;
+  while (low < high) {
+    const std::size_t middle = low + (high - low) / 2;
+    const int order = nameAt (middle).compare (name);
+    if (order == 0) {
+      return entry (middle);
+    }
+    if (order < 0) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return std::nullopt;
+}
+
+std::optional<std::string_view> AssetPack::data (std::string_view name) const {
+  const std::optional<Entry> found = find (name);
+  if (!found) {
+    return std::nullopt;
+  }
+  if (found->codec != AssetPackFormat::Codec::Stored) {
+    LOG_E_FMT ("Asset pack entry {} uses unsupported codec {}", name,
+               static_cast<std::uint32_t> (found->codec));
+    return std::nullopt;
+  }
+  return found->data;
+}
@@ -0,0 +1,65 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Read-only access to assets.pack
+
+#ifndef __ASSETPACK_H__
+#define __ASSETPACK_H__
+
+#include <Assets/AssetPackFormat.hpp>
+#include <Utils/Utils.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+// The pack is mapped once with random access advice. open() only validates the header and that
+// the TOC and string table lie inside the file; entries are bounds-checked when they are looked
+// up, so nothing is touched (or paged in) before it is needed.
+class AssetPack {
+public:
+  struct Entry {
+    std::string_view name;
+    std::string_view data; // empty for entries with an unsupported codec
+    std::uint64_t size = 0;
+    AssetPackFormat::Codec codec = AssetPackFormat::Codec::Stored;
+  };
+
+  AssetPack () = default;
+
+  // False when the file is missing or is not a valid pack
+  bool open (const std::filesystem::path& packFile);
+  void close ();
+
+  bool isOpen () const {
+    return open_;
+  }
+
+  std::size_t size () const {
+    return header_.entryCount;
+  }
+
+  // Entries in path order
+  std::optional<Entry> entry (std::size_t index) const;
+
+  // Path relative to the asset directory, '/' separated
+  std::optional<Entry> find (std::string_view name) const;
+
+  bool contains (std::string_view name) const {
+    return find (name).has_value ();
+  }
+
+  // Stored entry contents, a view into the mapping. nullopt for unknown names and compressed
+  // entries.
+  std::optional<std::string_view> data (std::string_view name) const;
+
+private:
+  std::string_view nameAt (std::size_t index) const;
+
+  DotNameUtils::FileIO::MappedFile file_;
+  AssetPackFormat::Header header_;
+  bool open_ = false;
+};
+
+#endif // __ASSETPACK_H__
@@ -0,0 +1,250 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// On-disk layout of assets.pack and the writer used by the build step (std only, no CoreLib deps)
+
+#ifndef __ASSETPACKFORMAT_H__
+#define __ASSETPACKFORMAT_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+// Layout, all integers little-endian:
+//
+//   Header      64 bytes at offset 0
+//   entry data  each entry starts on a kAlignment boundary
+//   TOC         entryCount * kTocEntrySize, sorted by path (byte-wise)
+//   strings     paths, '/' separated, relative to the asset directory, not NUL terminated
+//
+// Opening a pack costs one open() + mmap and a header check, entries are located by binary
+// search over the mapped TOC and returned as views into the mapping.
+namespace AssetPackFormat {
+
+  inline constexpr char kMagic[8] = { 'I', 'D', 'X', '2', 'P', 'A', 'C', 'K' };
+  inline constexpr std::uint32_t kVersion = 1;
+  inline constexpr std::size_t kHeaderSize = 64;
+  inline constexpr std::size_t kTocEntrySize = 40;
+  inline constexpr std::uint64_t kAlignment = 64; // cache line, enough for any SIMD decoder
+  inline constexpr const char* kFileName = "assets.pack";
+
+  // Codec ids are part of the format. Only Stored is produced and understood for now; the
+  // compressed ids are reserved so packs with LZ4/zstd entries can be added without a version bump.
+  enum class Codec : std::uint32_t { Stored = 0, Lz4 = 1, Zstd = 2 };
+
+  // Header field offsets
+  //   0  magic[8]
+  //   8  u32 version
+  //  12  u32 entryCount
+  //  16  u64 tocOffset
+  //  24  u64 stringsOffset
+  //  32  u64 stringsSize
+  //  40  u64 fileSize
+  //  48  reserved
+  struct Header {
+    std::uint32_t version = 0;
+    std::uint32_t entryCount = 0;
+    std::uint64_t tocOffset = 0;
+    std::uint64_t stringsOffset = 0;
+    std::uint64_t stringsSize = 0;
+    std::uint64_t fileSize = 0;
+  };
+
+  // TOC entry field offsets
+  //   0  u64 dataOffset
+  //   8  u64 storedSize  bytes in the pack
+  //  16  u64 size        bytes after decoding
+  //  24  u32 pathOffset  into the string table
+  //  28  u32 pathLength
+  //  32  u32 codec
+  //  36  u32 reserved
+  struct TocEntry {
+    std::uint64_t dataOffset = 0;
+    std::uint64_t storedSize = 0;
+    std::uint64_t size = 0;
+    std::uint32_t pathOffset = 0;
+    std::uint32_t pathLength = 0;
+    Codec codec = Codec::Stored;
+  };
+
+  inline std::uint32_t readU32 (const unsigned char* p) {
+    return static_cast<std::uint32_t> (p[0]) | static_cast<std::uint32_t> (p[1]) << 8
+           | static_cast<std::uint32_t> (p[2]) << 16 | static_cast<std::uint32_t> (p[3]) << 24;
+  }
+
+  inline std::uint64_t readU64 (const unsigned char* p) {
+    return static_cast<std::uint64_t> (readU32 (p))
+           | static_cast<std::uint64_t> (readU32 (p + 4)) << 32;
+  }
+
+  inline void writeU32 (unsigned char* p, std::uint32_t value) {
+    for (int i = 0; i < 4; ++i) {
+      p[i] = static_cast<unsigned char> (value >> (8 * i));
+    }
+  }
+
+  inline void writeU64 (unsigned char* p, std::uint64_t value) {
+    writeU32 (p, static_cast<std::uint32_t> (value));
+    writeU32 (p + 4, static_cast<std::uint32_t> (value >> 32));
+  }
+
+  // False when the magic or version does not match
+  inline bool decodeHeader (const unsigned char* p, Header& header) {
+    if (std::memcmp (p, kMagic, sizeof (kMagic)) != 0) {
+      return false;
+    }
+    header.version = readU32 (p + 8);
+    header.entryCount = readU32 (p + 12);
+    header.tocOffset = readU64 (p + 16);
+    header.stringsOffset = readU64 (p + 24);
+    header.stringsSize = readU64 (p + 32);
+    header.fileSize = readU64 (p + 40);
+    return header.version == kVersion;
+  }
+
+  inline void encodeHeader (unsigned char* p, const Header& header) {
+    std::memset (p, 0, kHeaderSize);
+    std::memcpy (p, kMagic, sizeof (kMagic));
+    writeU32 (p + 8, header.version);
+    writeU32 (p + 12, header.entryCount);
+    writeU64 (p + 16, header.tocOffset);
+    writeU64 (p + 24, header.stringsOffset);
+    writeU64 (p + 32, header.stringsSize);
+    writeU64 (p + 40, header.fileSize);
+  }
+
+  inline TocEntry decodeTocEntry (const unsigned char* p) {
+    TocEntry entry;
+    entry.dataOffset = readU64 (p);
+    entry.storedSize = readU64 (p + 8);
+    entry.size = readU64 (p + 16);
+    entry.pathOffset = readU32 (p + 24);
+    entry.pathLength = readU32 (p + 28);
+    entry.codec = static_cast<Codec> (readU32 (p + 32));
+    return entry;
+  }
+
+  inline void encodeTocEntry (unsigned char* p, const TocEntry& entry) {
+    std::memset (p, 0, kTocEntrySize);
+    writeU64 (p, entry.dataOffset);
+    writeU64 (p + 8, entry.storedSize);
+    writeU64 (p + 16, entry.size);
+    writeU32 (p + 24, entry.pathOffset);
+    writeU32 (p + 28, entry.pathLength);
+    writeU32 (p + 32, static_cast<std::uint32_t> (entry.codec));
+  }
+
+  inline std::uint64_t alignUp (std::uint64_t value) {
+    return (value + kAlignment - 1) & ~(kAlignment - 1);
+  }
+
+  // Packs every regular file under sourceDir (recursively, an existing assets.pack excluded) into
+  // outputFile. Entries are stored uncompressed. Returns false and fills `error` on failure; the
+  // output is written to a temporary file first and renamed, so a failed build never leaves a
+  // truncated pack behind.
+  inline bool writePack (const std::filesystem::path& sourceDir,
+                         const std::filesystem::path& outputFile, std::string* error = nullptr) {
+    auto fail = [&] (const std::string& message) {
+      if (error != nullptr) {
+        *error = message;
+      }
+      return false;
+    };
+
+    struct Source {
+      std::string name;
+      std::filesystem::path path;
+    };
+    std::filesystem::path base = sourceDir.lexically_normal ();
+    if (!base.has_filename ()) {
+      base = base.parent_path (); // "assets/" -> "assets"
+    }
+    std::vector<Source> sources;
+    std::error_code ec;
+    for (std::filesystem::recursive_directory_iterator it (base, ec), end; !ec && it != end;
+         it.increment (ec)) {
+      if (it->is_regular_file (ec) && it->path ().filename () != kFileName) {
+        std::string name = it->path ().lexically_relative (base).generic_string ();
+        sources.push_back ({ std::move (name), it->path () });
+      }
+    }
+    if (ec) {
+      return fail ("Failed to list " + sourceDir.string () + ": " + ec.message ());
+    }
+    std::sort (sources.begin (), sources.end (),
+               [] (const Source& a, const Source& b) { return a.name < b.name; });
+
+    std::vector<TocEntry> toc (sources.size ());
+    std::string strings;
+    std::vector<unsigned char> data;
+    std::uint64_t offset = kHeaderSize;
+    for (std::size_t i = 0; i < sources.size (); ++i) {
+      std::ifstream in (sources[i].path, std::ios::in | std::ios::binary);
+      if (!in.is_open ()) {
+        return fail ("Failed to open " + sources[i].path.string ());
+      }
+      std::vector<unsigned char> content ((std::istreambuf_iterator<char> (in)),
+                                          std::istreambuf_iterator<char> ());
+      offset = alignUp (offset);
+      data.resize (offset - kHeaderSize, 0);
+      data.insert (data.end (), content.begin (), content.end ());
+
+      toc[i].dataOffset = offset;
+      toc[i].storedSize = content.size ();
+      toc[i].size = content.size ();
+      toc[i].pathOffset = static_cast<std::uint32_t> (strings.size ());
+      toc[i].pathLength = static_cast<std::uint32_t> (sources[i].name.size ());
+      toc[i].codec = Codec::Stored;
+      strings += sources[i].name;
+      offset += content.size ();
+    }
+
+    Header header;
+    header.version = kVersion;
+    header.entryCount = static_cast<std::uint32_t> (toc.size ());
+    header.tocOffset = alignUp (offset);
+    header.stringsOffset = header.tocOffset + toc.size () * kTocEntrySize;
+    header.stringsSize = strings.size ();
+    header.fileSize = header.stringsOffset + strings.size ();
+    data.resize (header.tocOffset - kHeaderSize, 0);
+
+    std::vector<unsigned char> head (kHeaderSize);
+    encodeHeader (head.data (), header);
+    std::vector<unsigned char> tocBytes (toc.size () * kTocEntrySize);
+    for (std::size_t i = 0; i < toc.size (); ++i) {
+      encodeTocEntry (tocBytes.data () + i * kTocEntrySize, toc[i]);
+    }
+
+    std::filesystem::path temporary = outputFile;
+    temporary += ".tmp";
+    {
+      std::ofstream out (temporary, std::ios::out | std::ios::trunc | std::ios::binary);
+      if (!out.is_open ()) {
+        return fail ("Failed to create " + temporary.string ());
+      }
+      out.write (reinterpret_cast<const char*> (head.data ()), head.size ());
+      out.write (reinterpret_cast<const char*> (data.data ()), data.size ());
+      out.write (reinterpret_cast<const char*> (tocBytes.data ()), tocBytes.size ());
+      out.write (strings.data (), strings.size ());
+      if (!out.good ()) {
+        return fail ("Failed to write " + temporary.string ());
+      }
+    }
+    std::filesystem::rename (temporary, outputFile, ec);
+    if (ec) {
+      std::filesystem::remove (temporary, ec);
+      return fail ("Failed to write " + outputFile.string ());
+    }
+    return true;
+  }
+
+} // namespace AssetPackFormat
+
+#endif // __ASSETPACKFORMAT_H__
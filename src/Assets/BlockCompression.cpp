@@ -0,0 +1,639 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "BlockCompression.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace BlockCompression {
+  namespace {
+    // ETC1 / ETC2 individual and differential mode modifiers, {a, b} -> indices a, b, -a, -b
+    constexpr int kEtcModifiers[8][2] = { { 2, 8 },   { 5, 17 },  { 9, 29 },  { 13, 42 },
+                                          { 18, 60 }, { 24, 80 }, { 33, 106 }, { 47, 183 } };
+
+    // ETC2 T and H mode distances
+    constexpr int kEtcDistances[8] = { 3, 6, 11, 16, 23, 32, 41, 64 };
+
+    // EAC alpha modifiers, scaled by the block multiplier
+    constexpr int kEacModifiers[16][8] = {
+      { -3, -6, -9, -15, 2, 5, 8, 14 },  { -3, -7, -10, -13, 2, 6, 9, 12 },
+      { -2, -5, -8, -13, 1, 4, 7, 12 },  { -2, -4, -6, -13, 1, 3, 5, 12 },
+      { -3, -6, -8, -12, 2, 5, 7, 11 },  { -3, -7, -9, -11, 2, 6, 8, 10 },
+      { -4, -7, -8, -11, 3, 6, 7, 10 },  { -3, -5, -8, -11, 2, 4, 7, 10 },
+      { -2, -6, -8, -10, 1, 5, 7, 9 },   { -2, -5, -8, -10, 1, 4, 7, 9 },
+      { -2, -4, -8, -10, 1, 3, 7, 9 },   { -2, -5, -7, -10, 1, 4, 6, 9 },
+      { -3, -4, -7, -10, 2, 3, 6, 9 },   { -1, -2, -3, -10, 0, 1, 2, 9 },
+      { -4, -6, -8, -9, 3, 5, 7, 8 },    { -3, -5, -7, -9, 2, 4, 6, 8 } };
+
+    std::uint8_t clamp255 (int value) {
+      return static_cast<std::uint8_t> (std::clamp (value, 0, 255));
+    }
+
+    int extend4 (int c) {
+      return c << 4 | c;
+    }
+    int extend5 (int c) {
+      return c << 3 | c >> 2;
+    }
+    int extend6 (int c) {
+      return c << 2 | c >> 4;
+    }
+    int extend7 (int c) {
+      return c << 1 | c >> 6;
+    }
+
+    std::uint64_t readBigEndian (const std::uint8_t* p, int bytes) {
+      std::uint64_t value = 0;
+      for (int i = 0; i < bytes; ++i) {
+        value = value << 8 | p[i];
+      }
+      return value;
+    }
+
+    void writeBigEndian (std::uint64_t value, std::uint8_t* p, int bytes) {
+      for (int i = bytes - 1; i >= 0; --i) {
+        p[i] = static_cast<std::uint8_t> (value);
+        value >>= 8;
+      }
+    }
+
+    int colorError (const int a[3], const std::uint8_t* b) {
+      const int dr = a[0] - b[0], dg = a[1] - b[1], db = a[2] - b[2];
+      return dr * dr + dg * dg + db * db;
+    }
+
+    // ---- BC1 / BC3 ---------------------------------------------------------------------------
+
+    void expand565 (unsigned c, int out[3]) {
+      out[0] = extend5 (static_cast<int> (c >> 11 & 31));
+      out[1] = extend6 (static_cast<int> (c >> 5 & 63));
+      out[2] = extend5 (static_cast<int> (c & 31));
+    }
+
+    unsigned pack565 (const float rgb[3]) {
+      const auto quantize = [] (float v, int levels) {
+        return static_cast<unsigned> (std::clamp (std::lround (v * levels / 255.0f), 0L,
+                                                  static_cast<long> (levels)));
+      };
+      return quantize (rgb[0], 31) << 11 | quantize (rgb[1], 63) << 5 | quantize (rgb[2], 31);
+    }
+
+    // BC3 colour blocks always use the four colour palette, BC1 switches to three colours and
+    // transparent black when c0 <= c1
+    void bc1Palette (unsigned c0, unsigned c1, bool fourColorsOnly, int palette[4][4]) {
+      expand565 (c0, palette[0]);
+      expand565 (c1, palette[1]);
+      palette[0][3] = palette[1][3] = 255;
+      for (int c = 0; c < 3; ++c) {
+        if (c0 > c1 || fourColorsOnly) {
+          palette[2][c] = (2 * palette[0][c] + palette[1][c] + 1) / 3;
+          palette[3][c] = (palette[0][c] + 2 * palette[1][c] + 1) / 3;
+        } else {
+          palette[2][c] = (palette[0][c] + palette[1][c] + 1) / 2;
+          palette[3][c] = 0;
+        }
+      }
+      palette[2][3] = 255;
+      palette[3][3] = c0 > c1 || fourColorsOnly ? 255 : 0;
+    }
+
+    void decodeBc1Color (const std::uint8_t* block, bool fourColorsOnly, std::uint8_t rgba[64]) {
+      const unsigned c0 = block[0] | block[1] << 8;
+      const unsigned c1 = block[2] | block[3] << 8;
+      int palette[4][4];
+      bc1Palette (c0, c1, fourColorsOnly, palette);
+      const std::uint32_t indices = block[4] | block[5] << 8 | block[6] << 16
+                                    | static_cast<std::uint32_t> (block[7]) << 24;
+      for (int i = 0; i < 16; ++i) {
+        const int* color = palette[indices >> (2 * i) & 3];
+        for (int c = 0; c < 4; ++c) {
+          rgba[i * 4 + c] = static_cast<std::uint8_t> (color[c]);
+        }
+      }
+    }
+
+    void bc3AlphaPalette (int a0, int a1, int palette[8]) {
+      palette[0] = a0;
+      palette[1] = a1;
+      if (a0 > a1) {
+        for (int i = 1; i < 7; ++i) {
+          palette[i + 1] = ((7 - i) * a0 + i * a1 + 3) / 7;
+        }
+      } else {
+        for (int i = 1; i < 5; ++i) {
+          palette[i + 1] = ((5 - i) * a0 + i * a1 + 2) / 5;
+        }
+        palette[6] = 0;
+        palette[7] = 255;
+      }
+    }
+
+    void decodeBc3Alpha (const std::uint8_t* block, std::uint8_t rgba[64]) {
+      int palette[8];
+      bc3AlphaPalette (block[0], block[1], palette);
+      std::uint64_t indices = 0;
+      for (int i = 5; i >= 0; --i) {
+        indices = indices << 8 | block[2 + i];
+      }
+      for (int i = 0; i < 16; ++i) {
+        rgba[i * 4 + 3] = static_cast<std::uint8_t> (palette[indices >> (3 * i) & 7]);
+      }
+    }
+
+    // Endpoints from the extremes along the principal axis, slightly inset, nearest palette index
+    // per texel
+    void encodeBc1Color (const std::uint8_t rgba[64], std::uint8_t* block) {
+      float mean[3] = {};
+      for (int i = 0; i < 16; ++i) {
+        for (int c = 0; c < 3; ++c) {
+          mean[c] += rgba[i * 4 + c] / 16.0f;
+        }
+      }
+      float cov[6] = {}; // rr rg rb gg gb bb
+      for (int i = 0; i < 16; ++i) {
+        const float r = rgba[i * 4] - mean[0];
+        const float g = rgba[i * 4 + 1] - mean[1];
+        const float b = rgba[i * 4 + 2] - mean[2];
+        cov[0] += r * r;
+        cov[1] += r * g;
+        cov[2] += r * b;
+        cov[3] += g * g;
+        cov[4] += g * b;
+        cov[5] += b * b;
+      }
+      float axis[3] = { 1.0f, 1.0f, 1.0f };
+      for (int iteration = 0; iteration < 4; ++iteration) {
+        const float x = cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2];
+        const float y = cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2];
+        const float z = cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2];
+        const float length = std::max ({ std::fabs (x), std::fabs (y), std::fabs (z) });
+        if (length < 1e-6f) {
+          break; // flat block, any axis works
+        }
+        axis[0] = x / length;
+        axis[1] = y / length;
+        axis[2] = z / length;
+      }
+
+      float lowest = std::numeric_limits<float>::max ();
+      float highest = std::numeric_limits<float>::lowest ();
+      for (int i = 0; i < 16; ++i) {
+        const float t = (rgba[i * 4] - mean[0]) * axis[0] + (rgba[i * 4 + 1] - mean[1]) * axis[1]
+                        + (rgba[i * 4 + 2] - mean[2]) * axis[2];
+        lowest = std::min (lowest, t);
+        highest = std::max (highest, t);
+      }
+      const float norm = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+      const float inset = (highest - lowest) / 16.0f;
+      float end0[3], end1[3];
+      for (int c = 0; c < 3; ++c) {
+        end0[c] = mean[c] + axis[c] * (highest - inset) / norm;
+        end1[c] = mean[c] + axis[c] * (lowest + inset) / norm;
+      }
+      unsigned c0 = pack565 (end0);
+      unsigned c1 = pack565 (end1);
+      if (c0 < c1) {
+        std::swap (c0, c1);
+      }
+
+      int palette[4][4];
+      bc1Palette (c0, c1, true, palette);
+      std::uint32_t indices = 0;
+      if (c0 != c1) {
+        for (int i = 0; i < 16; ++i) {
+          int best = 0, bestError = std::numeric_limits<int>::max ();
+          for (int p = 0; p < 4; ++p) {
+            const int error = colorError (palette[p], rgba + i * 4);
+            if (error < bestError) {
+              best = p;
+              bestError = error;
+            }
+          }
+          indices |= static_cast<std::uint32_t> (best) << (2 * i);
+        }
+      }
+      block[0] = static_cast<std::uint8_t> (c0);
+      block[1] = static_cast<std::uint8_t> (c0 >> 8);
+      block[2] = static_cast<std::uint8_t> (c1);
+      block[3] = static_cast<std::uint8_t> (c1 >> 8);
+      for (int i = 0; i < 4; ++i) {
+        block[4 + i] = static_cast<std::uint8_t> (indices >> (8 * i));
+      }
+    }
+
+    void encodeBc3Alpha (const std::uint8_t rgba[64], std::uint8_t* block) {
+      int a0 = 0, a1 = 255;
+      for (int i = 0; i < 16; ++i) {
+        a0 = std::max<int> (a0, rgba[i * 4 + 3]);
+        a1 = std::min<int> (a1, rgba[i * 4 + 3]);
+      }
+      int palette[8];
+      bc3AlphaPalette (a0, a1, palette);
+      std::uint64_t indices = 0;
+      for (int i = 0; i < 16 && a0 != a1; ++i) {
+        int best = 0, bestError = std::numeric_limits<int>::max ();
+        for (int p = 0; p < 8; ++p) {
+          const int error = std::abs (palette[p] - rgba[i * 4 + 3]);
+          if (error < bestError) {
+            best = p;
+            bestError = error;
+          }
+        }
+        indices |= static_cast<std::uint64_t> (best) << (3 * i);
+      }
+      block[0] = static_cast<std::uint8_t> (a0);
+      block[1] = static_cast<std::uint8_t> (a1);
+      for (int i = 0; i < 6; ++i) {
+        block[2 + i] = static_cast<std::uint8_t> (indices >> (8 * i));
+      }
+    }
+
+    // ---- ETC2 / EAC ----------------------------------------------------------------------------
+    // Blocks are big-endian, per-texel data is column-major (texel i is x = i / 4, y = i % 4)
+
+    void writeTexel (std::uint8_t rgba[64], int x, int y, const int color[3]) {
+      std::uint8_t* texel = rgba + (y * 4 + x) * 4;
+      texel[0] = clamp255 (color[0]);
+      texel[1] = clamp255 (color[1]);
+      texel[2] = clamp255 (color[2]);
+      texel[3] = 255;
+    }
+
+    void decodeEtcPaint (std::uint64_t bits, const int paint[4][3], std::uint8_t rgba[64]) {
+      for (int i = 0; i < 16; ++i) {
+        const int index = static_cast<int> ((bits >> (16 + i) & 1) << 1 | (bits >> i & 1));
+        writeTexel (rgba, i / 4, i % 4, paint[index]);
+      }
+    }
+
+    void decodeEtcPlanar (std::uint64_t bits, std::uint8_t rgba[64]) {
+      const auto field = [bits] (int shift, int width) {
+        return static_cast<int> (bits >> shift & ((1u << width) - 1));
+      };
+      const int origin[3] = {
+        extend6 (field (57, 6)),
+        extend7 (field (56, 1) << 6 | field (49, 6)),
+        extend6 (field (48, 1) << 5 | field (43, 2) << 3 | field (39, 3)),
+      };
+      const int horizontal[3] = { extend6 (field (34, 5) << 1 | field (32, 1)),
+                                  extend7 (field (25, 7)), extend6 (field (19, 6)) };
+      const int vertical[3] = { extend6 (field (13, 6)), extend7 (field (6, 7)),
+                                extend6 (field (0, 6)) };
+      for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+          int color[3];
+          for (int c = 0; c < 3; ++c) {
+            color[c] = (x * (horizontal[c] - origin[c]) + y * (vertical[c] - origin[c])
+                        + 4 * origin[c] + 2)
+                       >> 2;
+          }
+          writeTexel (rgba, x, y, color);
+        }
+      }
+    }
+
+    void decodeEtc2Rgb (const std::uint8_t* block, std::uint8_t rgba[64]) {
+      const std::uint64_t bits = readBigEndian (block, 8);
+      const auto field = [bits] (int shift, int width) {
+        return static_cast<int> (bits >> shift & ((1u << width) - 1));
+      };
+      const auto signed3 = [] (int value) { return value >= 4 ? value - 8 : value; };
+
+      int base[2][3];
+      if (field (33, 1) == 0) {
+        for (int c = 0; c < 3; ++c) {
+          base[0][c] = extend4 (field (60 - 8 * c, 4));
+          base[1][c] = extend4 (field (56 - 8 * c, 4));
+        }
+      } else {
+        int first[3], second[3];
+        for (int c = 0; c < 3; ++c) {
+          first[c] = field (59 - 8 * c, 5);
+          second[c] = first[c] + signed3 (field (56 - 8 * c, 3));
+        }
+        if (second[0] < 0 || second[0] > 31) { // T mode
+          const int c1[3] = { extend4 (field (59, 2) << 2 | field (56, 2)),
+                              extend4 (field (52, 4)), extend4 (field (48, 4)) };
+          const int c2[3] = { extend4 (field (44, 4)), extend4 (field (40, 4)),
+                              extend4 (field (36, 4)) };
+          const int d = kEtcDistances[field (34, 2) << 1 | field (32, 1)];
+          const int paint[4][3] = { { c1[0], c1[1], c1[2] },
+                                    { c2[0] + d, c2[1] + d, c2[2] + d },
+                                    { c2[0], c2[1], c2[2] },
+                                    { c2[0] - d, c2[1] - d, c2[2] - d } };
+          decodeEtcPaint (bits, paint, rgba);
+          return;
+        }
+        if (second[1] < 0 || second[1] > 31) { // H mode
+          const int r1 = field (59, 4), g1 = field (56, 3) << 1 | field (52, 1),
+                    b1 = field (51, 1) << 3 | field (47, 3);
+          const int r2 = field (43, 4), g2 = field (39, 4), b2 = field (35, 4);
+          const int ordered = (r1 << 8 | g1 << 4 | b1) >= (r2 << 8 | g2 << 4 | b2) ? 1 : 0;
+          const int d = kEtcDistances[field (34, 1) << 2 | field (32, 1) << 1 | ordered];
+          const int c1[3] = { extend4 (r1), extend4 (g1), extend4 (b1) };
+          const int c2[3] = { extend4 (r2), extend4 (g2), extend4 (b2) };
+          const int paint[4][3] = { { c1[0] + d, c1[1] + d, c1[2] + d },
+                                    { c1[0] - d, c1[1] - d, c1[2] - d },
+                                    { c2[0] + d, c2[1] + d, c2[2] + d },
+                                    { c2[0] - d, c2[1] - d, c2[2] - d } };
+          decodeEtcPaint (bits, paint, rgba);
+          return;
+        }
+        if (second[2] < 0 || second[2] > 31) {
+          decodeEtcPlanar (bits, rgba);
+          return;
+        }
+        for (int c = 0; c < 3; ++c) {
+          base[0][c] = extend5 (first[c]);
+          base[1][c] = extend5 (second[c]);
+        }
+      }
+
+      const bool flip = field (32, 1) != 0;
+      const int tables[2] = { field (37, 3), field (34, 3) };
+      for (int i = 0; i < 16; ++i) {
+        const int x = i / 4, y = i % 4;
+        const int sub = flip ? (y >= 2) : (x >= 2);
+        const int index = field (16 + i, 1) << 1 | field (i, 1);
+        const int magnitude = kEtcModifiers[tables[sub]][index & 1];
+        const int modifier = index & 2 ? -magnitude : magnitude;
+        const int color[3] = { base[sub][0] + modifier, base[sub][1] + modifier,
+                               base[sub][2] + modifier };
+        writeTexel (rgba, x, y, color);
+      }
+    }
+
+    void decodeEacAlpha (const std::uint8_t* block, std::uint8_t rgba[64]) {
+      const int base = block[0];
+      const int multiplier = block[1] >> 4;
+      const int* modifiers = kEacModifiers[block[1] & 15];
+      const std::uint64_t indices = readBigEndian (block + 2, 6);
+      for (int i = 0; i < 16; ++i) {
+        const int index = static_cast<int> (indices >> (45 - 3 * i) & 7);
+        rgba[((i % 4) * 4 + i / 4) * 4 + 3] = clamp255 (base + modifiers[index] * multiplier);
+      }
+    }
+
+    // Sum of the best per-texel errors for one subblock with the given base colour and table,
+    // the chosen indices go to `indices`
+    int etcSubblockError (const std::uint8_t rgba[64], const int texels[8], const int base[3],
+                          int table, int indices[8]) {
+      int total = 0;
+      for (int t = 0; t < 8; ++t) {
+        int best = 0, bestError = std::numeric_limits<int>::max ();
+        for (int index = 0; index < 4; ++index) {
+          const int magnitude = kEtcModifiers[table][index & 1];
+          const int modifier = index & 2 ? -magnitude : magnitude;
+          const int color[3] = { clamp255 (base[0] + modifier), clamp255 (base[1] + modifier),
+                                 clamp255 (base[2] + modifier) };
+          const int error = colorError (color, rgba + texels[t] * 4);
+          if (error < bestError) {
+            best = index;
+            bestError = error;
+          }
+        }
+        indices[t] = best;
+        total += bestError;
+      }
+      return total;
+    }
+
+    struct EtcCandidate {
+      int error = std::numeric_limits<int>::max ();
+      std::uint64_t bits = 0;
+    };
+
+    // Individual and differential modes only, which every ETC1/ETC2 decoder understands. Both
+    // subblock orientations are tried, each subblock gets the average colour and the best table.
+    void encodeEtc2Rgb (const std::uint8_t rgba[64], std::uint8_t* block) {
+      EtcCandidate best;
+      for (int flip = 0; flip < 2; ++flip) {
+        int texels[2][8];
+        int counts[2] = {};
+        float average[2][3] = {};
+        for (int i = 0; i < 16; ++i) { // column-major texel order
+          const int x = i / 4, y = i % 4;
+          const int sub = flip ? (y >= 2) : (x >= 2);
+          const int linear = y * 4 + x;
+          texels[sub][counts[sub]++] = linear;
+          for (int c = 0; c < 3; ++c) {
+            average[sub][c] += rgba[linear * 4 + c] / 8.0f;
+          }
+        }
+
+        for (int differential = 0; differential < 2; ++differential) {
+          const int levels = differential ? 31 : 15;
+          int quantized[2][3], base[2][3];
+          bool valid = true;
+          for (int sub = 0; sub < 2; ++sub) {
+            for (int c = 0; c < 3; ++c) {
+              quantized[sub][c] = static_cast<int> (std::lround (average[sub][c] * levels / 255.0f));
+              base[sub][c] = differential ? extend5 (quantized[sub][c]) : extend4 (quantized[sub][c]);
+            }
+          }
+          for (int c = 0; c < 3 && differential; ++c) {
+            const int delta = quantized[1][c] - quantized[0][c];
+            valid = valid && delta >= -4 && delta <= 3;
+          }
+          if (!valid) {
+            continue;
+          }
+
+          int error = 0;
+          int tables[2] = {};
+          int indices[2][8];
+          for (int sub = 0; sub < 2; ++sub) {
+            int subError = std::numeric_limits<int>::max ();
+            for (int table = 0; table < 8; ++table) {
+              int candidate[8];
+              const int e = etcSubblockError (rgba, texels[sub], base[sub], table, candidate);
+              if (e < subError) {
+                subError = e;
+                tables[sub] = table;
+                std::memcpy (indices[sub], candidate, sizeof candidate);
+              }
+            }
+            error += subError;
+          }
+          if (error >= best.error) {
+            continue;
+          }
+
+          std::uint64_t bits = 0;
+          for (int c = 0; c < 3; ++c) {
+            if (differential) {
+              const int delta = quantized[1][c] - quantized[0][c];
+              bits |= static_cast<std::uint64_t> (quantized[0][c]) << (59 - 8 * c);
+              bits |= static_cast<std::uint64_t> (delta & 7) << (56 - 8 * c);
+            } else {
+              bits |= static_cast<std::uint64_t> (quantized[0][c]) << (60 - 8 * c);
+              bits |= static_cast<std::uint64_t> (quantized[1][c]) << (56 - 8 * c);
+            }
+          }
+          bits |= static_cast<std::uint64_t> (tables[0]) << 37;
+          bits |= static_cast<std::uint64_t> (tables[1]) << 34;
+          bits |= static_cast<std::uint64_t> (differential) << 33;
+          bits |= static_cast<std::uint64_t> (flip) << 32;
+          for (int sub = 0; sub < 2; ++sub) {
+            for (int t = 0; t < 8; ++t) {
+              const int linear = texels[sub][t];
+              const int i = (linear % 4) * 4 + linear / 4; // back to column-major
+              bits |= static_cast<std::uint64_t> (indices[sub][t] >> 1) << (16 + i);
+              bits |= static_cast<std::uint64_t> (indices[sub][t] & 1) << i;
+            }
+          }
+          best = { error, bits };
+        }
+      }
+      writeBigEndian (best.bits, block, 8);
+    }
+
+    // Per table the multiplier and base that stretch the modifier range over the block's alpha
+    // range, plus their neighbours
+    void encodeEacAlpha (const std::uint8_t rgba[64], std::uint8_t* block) {
+      int lowest = 255, highest = 0;
+      for (int i = 0; i < 16; ++i) {
+        lowest = std::min<int> (lowest, rgba[i * 4 + 3]);
+        highest = std::max<int> (highest, rgba[i * 4 + 3]);
+      }
+
+      int bestError = std::numeric_limits<int>::max ();
+      int bestBase = 0, bestMultiplier = 1, bestTable = 0;
+      std::uint64_t bestIndices = 0;
+      for (int table = 0; table < 16; ++table) {
+        const int* modifiers = kEacModifiers[table];
+        const int span = modifiers[7] - modifiers[3];
+        const int ideal = (highest - lowest + span / 2) / span;
+        for (int multiplier = std::max (1, ideal - 1); multiplier <= std::min (15, ideal + 1);
+             ++multiplier) {
+          const int center = lowest - modifiers[3] * multiplier;
+          for (int base = center - 1; base <= center + 1; ++base) {
+            const int clampedBase = std::clamp (base, 0, 255);
+            int error = 0;
+            std::uint64_t indices = 0;
+            for (int i = 0; i < 16 && error < bestError; ++i) {
+              const int alpha = rgba[((i % 4) * 4 + i / 4) * 4 + 3];
+              int best = 0, bestTexel = std::numeric_limits<int>::max ();
+              for (int index = 0; index < 8; ++index) {
+                const int e = std::abs (clamp255 (clampedBase + modifiers[index] * multiplier)
+                                        - alpha);
+                if (e < bestTexel) {
+                  best = index;
+                  bestTexel = e;
+                }
+              }
+              error += bestTexel * bestTexel;
+              indices |= static_cast<std::uint64_t> (best) << (45 - 3 * i);
+            }
+            if (error < bestError) {
+              bestError = error;
+              bestBase = clampedBase;
+              bestMultiplier = multiplier;
+              bestTable = table;
+              bestIndices = indices;
+            }
+          }
+        }
+      }
+      block[0] = static_cast<std::uint8_t> (bestBase);
+      block[1] = static_cast<std::uint8_t> (bestMultiplier << 4 | bestTable);
+      writeBigEndian (bestIndices, block + 2, 6);
+    }
+
+    void encodeBlock (Format format, const std::uint8_t rgba[64], std::uint8_t* block) {
+      switch (format) {
+      case Format::Bc1:
+        encodeBc1Color (rgba, block);
+        break;
+      case Format::Bc3:
+        encodeBc3Alpha (rgba, block);
+        encodeBc1Color (rgba, block + 8);
+        break;
+      case Format::Etc2Rgb:
+        encodeEtc2Rgb (rgba, block);
+        break;
+      case Format::Etc2Rgba:
+        encodeEacAlpha (rgba, block);
+        encodeEtc2Rgb (rgba, block + 8);
+        break;
+      }
+    }
+  } // namespace
+
+  std::uint32_t glInternalFormat (Format format, bool srgb) {
+    switch (format) {
+    case Format::Bc1:
+      return srgb ? 0x8C4C : 0x83F0; // GL_COMPRESSED_(S)RGB_S3TC_DXT1_EXT
+    case Format::Bc3:
+      return srgb ? 0x8C4F : 0x83F3; // GL_COMPRESSED_(SRGB_ALPHA|RGBA)_S3TC_DXT5_EXT
+    case Format::Etc2Rgb:
+      return srgb ? 0x9275 : 0x9274; // GL_COMPRESSED_(S)RGB8_ETC2
+    case Format::Etc2Rgba:
+      return srgb ? 0x9279 : 0x9278; // GL_COMPRESSED_(S)RGB(A)8_(ALPHA8_)ETC2_EAC
+    }
+    return 0;
+  }
+
+  void decodeBlock (Format format, const std::uint8_t* block, std::uint8_t rgba[64]) {
+    switch (format) {
+    case Format::Bc1:
+      decodeBc1Color (block, false, rgba);
+      break;
+    case Format::Bc3:
+      decodeBc1Color (block + 8, true, rgba);
+      decodeBc3Alpha (block, rgba);
+      break;
+    case Format::Etc2Rgb:
+      decodeEtc2Rgb (block, rgba);
+      break;
+    case Format::Etc2Rgba:
+      decodeEtc2Rgb (block + 8, rgba);
+      decodeEacAlpha (block, rgba);
+      break;
+    }
+  }
+
+  void decompress (Format format, const std::uint8_t* blocks, int width, int height,
+                   std::uint8_t* rgba) {
+    const std::size_t stride = blockBytes (format);
+    std::uint8_t texels[64];
+    for (int by = 0; by < height; by += kBlockSize) {
+      for (int bx = 0; bx < width; bx += kBlockSize) {
+        decodeBlock (format, blocks, texels);
+        blocks += stride;
+        const int rows = std::min (kBlockSize, height - by);
+        const int columns = std::min (kBlockSize, width - bx);
+        for (int y = 0; y < rows; ++y) {
+          std::memcpy (rgba + (static_cast<std::size_t> (by + y) * width + bx) * 4, texels + y * 16,
+                       static_cast<std::size_t> (columns) * 4);
+        }
+      }
+    }
+  }
+
+  std::vector<std::uint8_t> compress (Format format, const std::uint8_t* rgba, int width,
+                                      int height) {
+    std::vector<std::uint8_t> out (compressedSize (format, width, height));
+    std::uint8_t* block = out.data ();
+    std::uint8_t texels[64];
+    for (int by = 0; by < height; by += kBlockSize) {
+      for (int bx = 0; bx < width; bx += kBlockSize) {
+        for (int y = 0; y < kBlockSize; ++y) {
+          for (int x = 0; x < kBlockSize; ++x) {
+            const std::size_t sx = static_cast<std::size_t> (std::min (bx + x, width - 1));
+            const std::size_t sy = static_cast<std::size_t> (std::min (by + y, height - 1));
+            std::memcpy (texels + (y * 4 + x) * 4, rgba + (sy * width + sx) * 4, 4);
+          }
+        }
+        encodeBlock (format, texels, block);
+        block += blockBytes (format);
+      }
+    }
+    return out;
+  }
+
+} // namespace BlockCompression
@@ -0,0 +1,56 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// GPU block compressed formats (BC1, BC3, ETC2): CPU decoders and a simple offline encoder
+
+#ifndef __BLOCKCOMPRESSION_H__
+#define __BLOCKCOMPRESSION_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// All formats use 4x4 texel blocks. Pixels are tightly packed RGBA8 rows; images whose size is
+// not a multiple of 4 are padded by repeating the edge texels when encoding and cropped when
+// decoding.
+namespace BlockCompression {
+
+  enum class Format {
+    Bc1,      // DXT1, 8 bytes per block, opaque RGB
+    Bc3,      // DXT5, 16 bytes per block, RGB + interpolated alpha
+    Etc2Rgb,  // 8 bytes per block, GL ES 3.0 / WebGL 2 core
+    Etc2Rgba, // 16 bytes per block, EAC alpha + ETC2 RGB
+  };
+
+  inline constexpr int kBlockSize = 4;
+
+  inline std::size_t blockBytes (Format format) {
+    return format == Format::Bc1 || format == Format::Etc2Rgb ? 8 : 16;
+  }
+
+  inline bool hasAlpha (Format format) {
+    return format == Format::Bc3 || format == Format::Etc2Rgba;
+  }
+
+  inline std::size_t compressedSize (Format format, int width, int height) {
+    const std::size_t blocksX = (static_cast<std::size_t> (width) + 3) / 4;
+    const std::size_t blocksY = (static_cast<std::size_t> (height) + 3) / 4;
+    return blocksX * blocksY * blockBytes (format);
+  }
+
+  // GL internal format for glCompressedTexImage2D (EXT_texture_compression_s3tc,
+  // EXT_texture_sRGB, ETC2 core in GL 4.3 / ES 3.0)
+  std::uint32_t glInternalFormat (Format format, bool srgb);
+
+  // One block to 16 RGBA texels, row-major
+  void decodeBlock (Format format, const std::uint8_t* block, std::uint8_t rgba[64]);
+
+  // `blocks` holds compressedSize (format, width, height) bytes, `rgba` width * height * 4
+  void decompress (Format format, const std::uint8_t* blocks, int width, int height,
+                   std::uint8_t* rgba);
+
+  std::vector<std::uint8_t> compress (Format format, const std::uint8_t* rgba, int width,
+                                      int height);
+
+} // namespace BlockCompression
+
+#endif // __BLOCKCOMPRESSION_H__
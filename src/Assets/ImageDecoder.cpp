@@ -0,0 +1,66 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Single image decoding, stb_image only; host tools build it without the job system
+
+#include "ImageDecoder.hpp"
+#include <Utils/Profiler.hpp>
+
+#include <cstring>
+#include <limits>
+
+#include <stb_image.h>
+
+// StbImage.cpp
+namespace StbTarget {
+  void set (void* buffer, std::size_t bytes);
+  void clear ();
+}
+
+namespace {
+  constexpr std::size_t kMaxImageBytes = std::size_t{ 1 } << 30; // 16K x 16K RGBA
+}
+
+DecodedPixels ImageDecoder::decode (const ImageDecodeJob& job, PixelBufferPool& pool) {
+  PROFILE_SCOPE ("ImageDecoder::decode");
+  DecodedPixels out;
+  if (job.data == nullptr || job.size == 0 || job.size > std::numeric_limits<int>::max ()) {
+    out.error = "no image data";
+    return out;
+  }
+  const auto* encoded = static_cast<const stbi_uc*> (job.data);
+  const int length = static_cast<int> (job.size);
+
+  int width = 0, height = 0, fileChannels = 0;
+  if (!stbi_info_from_memory (encoded, length, &width, &height, &fileChannels)) {
+    out.error = stbi_failure_reason ();
+    return out;
+  }
+  const int channels = job.channels != 0 ? job.channels : fileChannels;
+  const std::size_t bytes = static_cast<std::size_t> (width) * height * channels;
+  if (bytes > kMaxImageBytes) {
+    out.error = "image too large";
+    return out;
+  }
+  PixelBuffer pixels = pool.acquire (bytes);
+
+  StbTarget::set (pixels.data (), bytes);
+  stbi_set_flip_vertically_on_load_thread (job.flipVertically ? 1 : 0);
+  int decodedWidth = 0, decodedHeight = 0;
+  stbi_uc* decoded = stbi_load_from_memory (encoded, length, &decodedWidth, &decodedHeight,
+                                            &fileChannels, job.channels);
+  StbTarget::clear ();
+
+  if (decoded == nullptr) {
+    out.error = stbi_failure_reason ();
+    return out;
+  }
+  if (decoded != pixels.data ()) {
+    std::memcpy (pixels.data (), decoded, bytes); // stb returned another allocation
+    stbi_image_free (decoded);
+  }
+  out.pixels = std::move (pixels);
+  out.width = decodedWidth;
+  out.height = decodedHeight;
+  out.channels = channels;
+  return out;
+}
@@ -0,0 +1,70 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Parallel image decoding (stb_image) into pooled, 64-byte aligned pixel buffers
+
+#ifndef __IMAGEDECODER_H__
+#define __IMAGEDECODER_H__
+
+#include <Assets/PixelBufferPool.hpp>
+#include <Utils/JobSystem.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct ImageDecodeJob {
+  const void* data = nullptr; // encoded file, must stay valid until decodeBatch returns
+  std::size_t size = 0;
+  int channels = 4; // 1..4, 0 keeps the channel count of the file
+  bool flipVertically = false;
+};
+
+struct DecodedPixels {
+  PixelBuffer pixels; // width * height * channels bytes, tightly packed rows
+  int width = 0;
+  int height = 0;
+  int channels = 0;
+  std::string error; // empty on success
+
+  bool ok () const {
+    return static_cast<bool> (pixels);
+  }
+};
+
+// Decodes batches as JobSystem jobs, one image each; the calling thread works on its own batch
+// too, so a batch of N images on N cores runs fully in parallel. stb_image writes straight into
+// the pooled buffer (see StbImage.cpp), there is no extra copy and no SDL_Surface on the way to
+// the GPU.
+class ImageDecoder {
+public:
+  // Decodes on JobSystem::shared ()
+  ImageDecoder ();
+  // Decodes on a job system of its own with the given number of workers
+  explicit ImageDecoder (std::size_t workers);
+
+  ImageDecoder (const ImageDecoder&) = delete;
+  ImageDecoder& operator= (const ImageDecoder&) = delete;
+
+  // Blocking, results in job order
+  std::vector<DecodedPixels> decodeBatch (const std::vector<ImageDecodeJob>& jobs,
+                                          PixelBufferPool& pool = PixelBufferPool::shared ());
+
+  // Single image on the calling thread
+  static DecodedPixels decode (const ImageDecodeJob& job,
+                               PixelBufferPool& pool = PixelBufferPool::shared ());
+
+  std::size_t workerCount () const {
+    return jobs_.workerCount ();
+  }
+
+  static std::size_t defaultWorkerCount ();
+
+  static ImageDecoder& shared ();
+
+private:
+  std::unique_ptr<JobSystem> ownJobs_;
+  JobSystem& jobs_;
+};
+
+#endif // __IMAGEDECODER_H__
@@ -0,0 +1,32 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// ImageDecoder batches on the job system
+
+#include "ImageDecoder.hpp"
+
+ImageDecoder::ImageDecoder () : jobs_ (JobSystem::shared ()) {
+}
+
+ImageDecoder::ImageDecoder (std::size_t workers)
+    : ownJobs_ (std::make_unique<JobSystem> (workers)), jobs_ (*ownJobs_) {
+}
+
+std::size_t ImageDecoder::defaultWorkerCount () {
+  return JobSystem::defaultWorkerCount ();
+}
+
+ImageDecoder& ImageDecoder::shared () {
+  static ImageDecoder decoder;
+  return decoder;
+}
+
+std::vector<DecodedPixels> ImageDecoder::decodeBatch (const std::vector<ImageDecodeJob>& jobs,
+                                                      PixelBufferPool& pool) {
+  std::vector<DecodedPixels> results (jobs.size ());
+  jobs_.parallelFor (0, jobs.size (), 1, [&] (std::size_t first, std::size_t last) {
+    for (std::size_t i = first; i < last; ++i) {
+      results[i] = decode (jobs[i], pool);
+    }
+  });
+  return results;
+}
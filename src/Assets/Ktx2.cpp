@@ -0,0 +1,236 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "Ktx2.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace Ktx2 {
+  namespace {
+    using BlockCompression::Format;
+
+    // Header (80 bytes) followed by the level index
+    //   0  identifier[12]
+    //  12  u32 vkFormat, typeSize, pixelWidth, pixelHeight, pixelDepth, layerCount, faceCount,
+    //          levelCount, supercompressionScheme
+    //  48  u32 dfdByteOffset, dfdByteLength, kvdByteOffset, kvdByteLength
+    //  64  u64 sgdByteOffset, sgdByteLength
+    //  80  levelCount * { u64 byteOffset, byteLength, uncompressedByteLength }
+    constexpr std::size_t kHeaderSize = 80;
+    constexpr std::size_t kLevelIndexEntrySize = 24;
+
+    struct FormatEntry {
+      std::uint32_t vkFormat;
+      Format format;
+      bool srgb;
+    };
+
+    constexpr FormatEntry kFormats[] = {
+      { 131, Format::Bc1, false },      // VK_FORMAT_BC1_RGB_UNORM_BLOCK
+      { 132, Format::Bc1, true },       // VK_FORMAT_BC1_RGB_SRGB_BLOCK
+      { 137, Format::Bc3, false },      // VK_FORMAT_BC3_UNORM_BLOCK
+      { 138, Format::Bc3, true },       // VK_FORMAT_BC3_SRGB_BLOCK
+      { 147, Format::Etc2Rgb, false },  // VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK
+      { 148, Format::Etc2Rgb, true },   // VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK
+      { 151, Format::Etc2Rgba, false }, // VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK
+      { 152, Format::Etc2Rgba, true },  // VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK
+    };
+
+    std::uint32_t readU32 (const std::uint8_t* p) {
+      return static_cast<std::uint32_t> (p[0]) | static_cast<std::uint32_t> (p[1]) << 8
+             | static_cast<std::uint32_t> (p[2]) << 16 | static_cast<std::uint32_t> (p[3]) << 24;
+    }
+
+    std::uint64_t readU64 (const std::uint8_t* p) {
+      return static_cast<std::uint64_t> (readU32 (p))
+             | static_cast<std::uint64_t> (readU32 (p + 4)) << 32;
+    }
+
+    void putU32 (std::vector<std::uint8_t>& out, std::size_t offset, std::uint32_t value) {
+      for (int i = 0; i < 4; ++i) {
+        out[offset + i] = static_cast<std::uint8_t> (value >> (8 * i));
+      }
+    }
+
+    void putU64 (std::vector<std::uint8_t>& out, std::size_t offset, std::uint64_t value) {
+      putU32 (out, offset, static_cast<std::uint32_t> (value));
+      putU32 (out, offset + 4, static_cast<std::uint32_t> (value >> 32));
+    }
+
+    void appendU32 (std::vector<std::uint8_t>& out, std::uint32_t value) {
+      out.resize (out.size () + 4);
+      putU32 (out, out.size () - 4, value);
+    }
+
+    void padTo (std::vector<std::uint8_t>& out, std::size_t alignment) {
+      out.resize ((out.size () + alignment - 1) / alignment * alignment, 0);
+    }
+
+    bool fail (std::string* error, const char* message) {
+      if (error) {
+        *error = message;
+      }
+      return false;
+    }
+
+    // Basic data format descriptor, one sample per 64-bit half of the block
+    void appendDfd (std::vector<std::uint8_t>& out, Format format, bool srgb) {
+      const bool alpha = BlockCompression::hasAlpha (format);
+      const bool etc = format == Format::Etc2Rgb || format == Format::Etc2Rgba;
+      const std::uint32_t samples = alpha ? 2 : 1;
+      const std::uint32_t blockSize = 24 + 16 * samples;
+      const std::uint32_t colorModel = etc ? 161 : format == Format::Bc3 ? 130 : 128;
+      const std::uint32_t colorChannel = etc ? 2 : 0;
+      constexpr std::uint32_t kAlphaChannel = 15;
+
+      appendU32 (out, 4 + blockSize); // dfdTotalSize
+      appendU32 (out, 0);             // vendorId KHRONOS, descriptorType BASICFORMAT
+      appendU32 (out, 2 | blockSize << 16);
+      appendU32 (out, colorModel | 1u << 8 | (srgb ? 2u : 1u) << 16); // BT709, linear / sRGB
+      appendU32 (out, 3 | 3u << 8);                                   // 4x4x1x1 texel block
+      appendU32 (out, static_cast<std::uint32_t> (BlockCompression::blockBytes (format)));
+      appendU32 (out, 0);
+      for (std::uint32_t sample = 0; sample < samples; ++sample) {
+        const std::uint32_t channel = alpha && sample == 0 ? kAlphaChannel : colorChannel;
+        appendU32 (out, (sample * 64) | 63u << 16 | channel << 24);
+        appendU32 (out, 0);
+        appendU32 (out, 0);
+        appendU32 (out, 0xFFFFFFFFu);
+      }
+    }
+
+    void appendKeyValue (std::vector<std::uint8_t>& out, std::string_view key,
+                         std::string_view value) {
+      appendU32 (out, static_cast<std::uint32_t> (key.size () + value.size () + 2));
+      out.insert (out.end (), key.begin (), key.end ());
+      out.push_back (0);
+      out.insert (out.end (), value.begin (), value.end ());
+      out.push_back (0);
+      padTo (out, 4);
+    }
+  } // namespace
+
+  std::uint32_t vkFormat (Format format, bool srgb) {
+    for (const FormatEntry& entry : kFormats) {
+      if (entry.format == format && entry.srgb == srgb) {
+        return entry.vkFormat;
+      }
+    }
+    return 0;
+  }
+
+  bool parse (const void* data, std::size_t size, Texture& out, std::string* error) {
+    const auto* bytes = static_cast<const std::uint8_t*> (data);
+    if (bytes == nullptr || size < kHeaderSize
+        || std::memcmp (bytes, kIdentifier, sizeof kIdentifier) != 0) {
+      return fail (error, "not a KTX2 file");
+    }
+    const std::uint32_t format = readU32 (bytes + 12);
+    const std::uint32_t width = readU32 (bytes + 20);
+    const std::uint32_t height = readU32 (bytes + 24);
+    const std::uint32_t depth = readU32 (bytes + 28);
+    const std::uint32_t layers = readU32 (bytes + 32);
+    const std::uint32_t faces = readU32 (bytes + 36);
+    const std::uint32_t levelCount = std::max<std::uint32_t> (1, readU32 (bytes + 40));
+    const std::uint32_t supercompression = readU32 (bytes + 44);
+
+    const auto entry = std::find_if (std::begin (kFormats), std::end (kFormats),
+                                     [format] (const FormatEntry& e) { return e.vkFormat == format; });
+    if (entry == std::end (kFormats)) {
+      return fail (error, "unsupported KTX2 vkFormat");
+    }
+    if (supercompression != 0) {
+      return fail (error, "supercompressed KTX2 is not supported");
+    }
+    if (width == 0 || height == 0 || width > 16384 || height > 16384 || depth > 1 || layers > 1
+        || faces != 1) {
+      return fail (error, "only 2D KTX2 textures are supported");
+    }
+    if (levelCount > 15 || kHeaderSize + levelCount * kLevelIndexEntrySize > size) {
+      return fail (error, "truncated KTX2 level index");
+    }
+
+    Texture texture;
+    texture.format = entry->format;
+    texture.srgb = entry->srgb;
+    texture.width = static_cast<int> (width);
+    texture.height = static_cast<int> (height);
+    for (std::uint32_t i = 0; i < levelCount; ++i) {
+      const std::uint8_t* index = bytes + kHeaderSize + i * kLevelIndexEntrySize;
+      const std::uint64_t offset = readU64 (index);
+      const std::uint64_t length = readU64 (index + 8);
+      Level level;
+      level.width = std::max (1, texture.width >> i);
+      level.height = std::max (1, texture.height >> i);
+      level.size = BlockCompression::compressedSize (texture.format, level.width, level.height);
+      if (offset > size || length > size - offset || length < level.size) {
+        return fail (error, "truncated KTX2 level data");
+      }
+      level.data = bytes + offset;
+      texture.levels.push_back (level);
+    }
+
+    const std::uint32_t kvdOffset = readU32 (bytes + 56);
+    const std::uint32_t kvdLength = readU32 (bytes + 60);
+    if (kvdLength != 0 && kvdOffset <= size && kvdLength <= size - kvdOffset) {
+      std::size_t at = kvdOffset;
+      const std::size_t end = kvdOffset + kvdLength;
+      while (at + 4 <= end) {
+        const std::uint32_t length = readU32 (bytes + at);
+        if (length > end - at - 4) {
+          break;
+        }
+        const std::string_view pair (reinterpret_cast<const char*> (bytes + at + 4), length);
+        const std::size_t separator = pair.find ('\0');
+        if (separator != std::string_view::npos && pair.substr (0, separator) == kOrientationKey) {
+          const std::string_view value = pair.substr (separator + 1);
+          texture.flippedVertically = value.size () >= 2 && value[1] == 'u';
+        }
+        at += 4 + (length + 3) / 4 * 4;
+      }
+    }
+
+    out = std::move (texture);
+    return true;
+  }
+
+  std::vector<std::uint8_t> write (Format format, bool srgb, bool flippedVertically,
+                                   const std::vector<LevelData>& levels) {
+    const std::size_t levelIndexEnd = kHeaderSize + levels.size () * kLevelIndexEntrySize;
+    std::vector<std::uint8_t> out (levelIndexEnd, 0);
+    std::memcpy (out.data (), kIdentifier, sizeof kIdentifier);
+    const int width = levels.empty () ? 0 : levels.front ().width;
+    const int height = levels.empty () ? 0 : levels.front ().height;
+    putU32 (out, 12, vkFormat (format, srgb));
+    putU32 (out, 16, 1); // typeSize
+    putU32 (out, 20, static_cast<std::uint32_t> (width));
+    putU32 (out, 24, static_cast<std::uint32_t> (height));
+    putU32 (out, 36, 1); // faceCount
+    putU32 (out, 40, static_cast<std::uint32_t> (levels.size ()));
+
+    const std::size_t dfdOffset = out.size ();
+    appendDfd (out, format, srgb);
+    putU32 (out, 48, static_cast<std::uint32_t> (dfdOffset));
+    putU32 (out, 52, static_cast<std::uint32_t> (out.size () - dfdOffset));
+
+    const std::size_t kvdOffset = out.size ();
+    appendKeyValue (out, kOrientationKey, flippedVertically ? "ru" : "rd");
+    appendKeyValue (out, "KTXwriter", "index2 ktx2tool");
+    putU32 (out, 56, static_cast<std::uint32_t> (kvdOffset));
+    putU32 (out, 60, static_cast<std::uint32_t> (out.size () - kvdOffset));
+
+    // Smallest level first, as the spec recommends for streaming
+    for (std::size_t i = levels.size (); i-- > 0;) {
+      padTo (out, BlockCompression::blockBytes (format));
+      const std::size_t offset = out.size ();
+      out.insert (out.end (), levels[i].blocks.begin (), levels[i].blocks.end ());
+      const std::size_t index = kHeaderSize + i * kLevelIndexEntrySize;
+      putU64 (out, index, offset);
+      putU64 (out, index + 8, levels[i].blocks.size ());
+      putU64 (out, index + 16, levels[i].blocks.size ());
+    }
+    return out;
+  }
+
+} // namespace Ktx2
@@ -0,0 +1,72 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// KTX2 container for block compressed textures: parser (views into the file) and writer
+
+#ifndef __KTX2_H__
+#define __KTX2_H__
+
+#include <Assets/BlockCompression.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Supported subset of https://registry.khronos.org/KTX/specs/2.0/ktxspec.v2.html: 2D textures,
+// one layer and face, BC1/BC3/ETC2 (linear or sRGB) without supercompression. Basis Universal
+// and zstd supercompressed files are rejected.
+namespace Ktx2 {
+
+  inline constexpr std::uint8_t kIdentifier[12] = { 0xAB, 'K',  'T',  'X',  ' ',  '2',
+                                                    '0',  0xBB, '\r', '\n', 0x1A, '\n' };
+  inline constexpr std::string_view kExtension = ".ktx2";
+
+  // KTXorientation: "rd" keeps the first row at the top (as stb decodes), "ru" is the flipped
+  // layout GL expects with DecodeParams::flipVertically
+  inline constexpr std::string_view kOrientationKey = "KTXorientation";
+
+  struct Level {
+    const std::uint8_t* data = nullptr;
+    std::size_t size = 0;
+    int width = 0;
+    int height = 0;
+  };
+
+  struct Texture {
+    BlockCompression::Format format = BlockCompression::Format::Bc1;
+    bool srgb = false;
+    bool flippedVertically = false; // KTXorientation "ru"
+    int width = 0;
+    int height = 0;
+    std::vector<Level> levels; // largest first, views into the parsed buffer
+
+    std::size_t bytes () const {
+      std::size_t total = 0;
+      for (const Level& level : levels) {
+        total += level.size;
+      }
+      return total;
+    }
+  };
+
+  // VK_FORMAT_* of the supported formats
+  std::uint32_t vkFormat (BlockCompression::Format format, bool srgb);
+
+  // The buffer must outlive the returned views. false with `error` set for files outside the
+  // supported subset.
+  bool parse (const void* data, std::size_t size, Texture& out, std::string* error = nullptr);
+
+  struct LevelData {
+    std::vector<std::uint8_t> blocks;
+    int width = 0;
+    int height = 0;
+  };
+
+  // `levels` largest first, as produced by BlockCompression::compress
+  std::vector<std::uint8_t> write (BlockCompression::Format format, bool srgb,
+                                   bool flippedVertically, const std::vector<LevelData>& levels);
+
+} // namespace Ktx2
+
+#endif // __KTX2_H__
@@ -0,0 +1,199 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Pool of 64-byte aligned pixel buffers, recycled between decodes
+
+#ifndef __PIXELBUFFERPOOL_H__
+#define __PIXELBUFFERPOOL_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class PixelBufferPool;
+
+struct PixelBufferPoolStats {
+  std::uint64_t allocations = 0; // new memory
+  std::uint64_t reuses = 0;      // served from the free lists
+  std::size_t bytesRetained = 0; // idle in the free lists
+};
+
+// Owning handle to one pooled buffer; goes back to its pool on destruction (the pool state is
+// shared, so buffers may outlive the PixelBufferPool object)
+class PixelBuffer {
+public:
+  static constexpr std::size_t kAlignment = 64;
+
+  PixelBuffer () = default;
+  ~PixelBuffer () {
+    release ();
+  }
+
+  PixelBuffer (const PixelBuffer&) = delete;
+  PixelBuffer& operator= (const PixelBuffer&) = delete;
+
+  PixelBuffer (PixelBuffer&& other) noexcept {
+    *this = std::move (other);
+  }
+
+  PixelBuffer& operator= (PixelBuffer&& other) noexcept {
+    if (this != &other) {
+      release ();
+      data_ = std::exchange (other.data_, nullptr);
+      size_ = std::exchange (other.size_, 0);
+      capacity_ = std::exchange (other.capacity_, 0);
+      state_ = std::move (other.state_);
+    }
+    return *this;
+  }
+
+  unsigned char* data () const {
+    return data_;
+  }
+
+  // Requested size
+  std::size_t size () const {
+    return size_;
+  }
+
+  // Size class actually allocated
+  std::size_t capacity () const {
+    return capacity_;
+  }
+
+  explicit operator bool () const {
+    return data_ != nullptr;
+  }
+
+  void release ();
+
+private:
+  friend class PixelBufferPool;
+  struct State;
+
+  static void deallocate (unsigned char* data, std::size_t capacity) {
+    ::operator delete (data, capacity, std::align_val_t{ kAlignment });
+  }
+
+  unsigned char* data_ = nullptr;
+  std::size_t size_ = 0;
+  std::size_t capacity_ = 0;
+  std::shared_ptr<State> state_;
+};
+
+struct PixelBuffer::State {
+  std::mutex mutex;
+  std::unordered_map<std::size_t, std::vector<unsigned char*>> free;
+  std::size_t retained = 0;
+  std::size_t maxRetained = 0;
+  PixelBufferPoolStats stats;
+
+  ~State () {
+    for (auto& [capacity, buffers] : free) {
+      for (unsigned char* data : buffers) {
+        PixelBuffer::deallocate (data, capacity);
+      }
+    }
+  }
+};
+
+// Buffers are rounded up to size classes of 2^k and 1.5 * 2^k (at most a third wasted), freed
+// buffers are kept per class until maxRetainedBytes is reached. Thread-safe.
+class PixelBufferPool {
+public:
+  using Stats = PixelBufferPoolStats;
+
+  explicit PixelBufferPool (std::size_t maxRetainedBytes = std::size_t{ 256 } << 20)
+      : state_ (std::make_shared<PixelBuffer::State> ()) {
+    state_->maxRetained = maxRetainedBytes;
+  }
+
+  PixelBuffer acquire (std::size_t bytes) {
+    PixelBuffer buffer;
+    buffer.capacity_ = sizeClass (bytes);
+    buffer.size_ = bytes;
+    buffer.state_ = state_;
+    {
+      std::lock_guard<std::mutex> lock (state_->mutex);
+      std::vector<unsigned char*>& free = state_->free[buffer.capacity_];
+      if (!free.empty ()) {
+        buffer.data_ = free.back ();
+        free.pop_back ();
+        state_->retained -= buffer.capacity_;
+        ++state_->stats.reuses;
+        return buffer;
+      }
+      ++state_->stats.allocations;
+    }
+    buffer.data_ = static_cast<unsigned char*> (
+        ::operator new (buffer.capacity_, std::align_val_t{ PixelBuffer::kAlignment }));
+    return buffer;
+  }
+
+  // Frees every idle buffer
+  void trim () {
+    std::lock_guard<std::mutex> lock (state_->mutex);
+    for (auto& [capacity, free] : state_->free) {
+      for (unsigned char* data : free) {
+        PixelBuffer::deallocate (data, capacity);
+      }
+      free.clear ();
+    }
+    state_->retained = 0;
+  }
+
+  Stats stats () const {
+    std::lock_guard<std::mutex> lock (state_->mutex);
+    Stats out = state_->stats;
+    out.bytesRetained = state_->retained;
+    return out;
+  }
+
+  static std::size_t sizeClass (std::size_t bytes) {
+    std::size_t power = PixelBuffer::kAlignment;
+    while (power < bytes) {
+      if (power + power / 2 >= bytes) {
+        return power + power / 2;
+      }
+      power *= 2;
+    }
+    return power;
+  }
+
+  // Decoders share one pool, so buffers evicted from the image cache feed the next decode
+  static PixelBufferPool& shared () {
+    static PixelBufferPool pool;
+    return pool;
+  }
+
+private:
+  std::shared_ptr<PixelBuffer::State> state_;
+};
+
+inline void PixelBuffer::release () {
+  if (data_ == nullptr) {
+    return;
+  }
+  bool kept = false;
+  if (state_) {
+    std::lock_guard<std::mutex> lock (state_->mutex);
+    if (state_->retained + capacity_ <= state_->maxRetained) {
+      state_->free[capacity_].push_back (data_);
+      state_->retained += capacity_;
+      kept = true;
+    }
+  }
+  if (!kept) {
+    deallocate (data_, capacity_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  capacity_ = 0;
+  state_.reset ();
+}
+
+#endif // __PIXELBUFFERPOOL_H__
@@ -0,0 +1,65 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// The one translation unit with the stb_image implementation
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+// stb_image has no "decode into this buffer" API. Instead the decoding thread registers its target
+// buffer and the allocator hands it out for the first allocation of exactly the output size, which
+// is the final image for every format stb decodes to 8 bits. When stb ends up returning another
+// pointer (different layout, intermediate buffer of the same size) the caller copies, so the
+// result is correct either way.
+namespace StbTarget {
+  namespace {
+    struct Target {
+      void* buffer = nullptr;
+      std::size_t bytes = 0;
+      bool taken = false;
+    };
+    thread_local Target t_target;
+  }
+
+  void set (void* buffer, std::size_t bytes) {
+    t_target = { buffer, bytes, false };
+  }
+
+  void clear () {
+    t_target = {};
+  }
+
+  void* allocate (std::size_t size) {
+    if (t_target.buffer != nullptr && !t_target.taken && size == t_target.bytes) {
+      t_target.taken = true;
+      return t_target.buffer;
+    }
+    return std::malloc (size);
+  }
+
+  void* reallocate (void* pointer, std::size_t size) {
+    if (pointer != nullptr && pointer == t_target.buffer) {
+      void* moved = std::malloc (size);
+      if (moved != nullptr) {
+        std::memcpy (moved, pointer, std::min (size, t_target.bytes));
+        t_target.taken = false;
+      }
+      return moved;
+    }
+    return std::realloc (pointer, size);
+  }
+
+  void release (void* pointer) {
+    if (pointer != nullptr && pointer == t_target.buffer) {
+      t_target.taken = false; // owned by the pool, just available again
+      return;
+    }
+    std::free (pointer);
+  }
+}
+
+#define STBI_MALLOC(size) StbTarget::allocate (size)
+#define STBI_REALLOC(pointer, size) StbTarget::reallocate (pointer, size)
+#define STBI_FREE(pointer) StbTarget::release (pointer)
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
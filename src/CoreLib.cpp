@@ -3,7 +3,9 @@
 
 #include <CoreLib/CoreLib.hpp>
 #include <Assets/AssetContext.hpp>
+#include <Assets/AssetPack.hpp>
 #include <Logger/Logger.hpp>
+#include <Utils/JobSystem.hpp>
 #include <Utils/Utils.hpp>
 
 #include <Gui/PlatformManager.hpp>
@@ -22,18 +24,26 @@ namespace dotname {
     AssetContext::clearAssetsPath ();
   }
 
-  CoreLib::CoreLib (const std::filesystem::path& assetsPath) : CoreLib () {
+  CoreLib::CoreLib (const std::filesystem::path& assetsPath, const CoreLibOptions& options)
+      : CoreLib () {
+    if (options.jobWorkers != 0) {
+      JobSystem::setSharedWorkerCount (options.jobWorkers);
+    }
     if (!assetsPath.empty ()) {
       AssetContext::setAssetsPath (assetsPath);
       LOG_D_STREAM << "Assets: " << AssetContext::getAssetsPath () << std::endl;
       LOG_I_STREAM << DotNameUtils::JsonUtils::getCustomStringSign () << std::endl;
-      auto logo = std::ifstream (AssetContext::getAssetsPath () / "logo.png");
+      if (auto logo = AssetContext::tryOpenAsset ("logo.png")) {
+        LOG_D_FMT ("Logo: {} bytes{}", logo->size (), logo->isPacked () ? " (packed)" : "");
+      }
 
 #if defined(__EMSCRIPTEN__)
       static EmscriptenPlatform pltf;
+      (void)options; // the browser drives the frame loop, there is no render thread
       pltf.initialize ();
 #else
       static DesktopPlatform pltf;
+      pltf.setThreadedRendering (options.threadedRendering);
       pltf.initialize ();
 #endif
     }
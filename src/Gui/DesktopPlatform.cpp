@@ -1,10 +1,19 @@
 #include "DesktopPlatform.hpp"
 
+#include <cstring>
+
+namespace {
+  constexpr int kTargetFramerate = 30; // frame limiter
+}
+
 void DesktopPlatform::initialize () {
+  PROFILE_THREAD ("Main");
+  prefetchAssets ();
   createSDL2Window ("Desktop SDL2 Window", windowWidth_, windowHeight_);
   createOpenGLContext (1);
   setupQuad ();
   setupShaders ();
+  setupQualityGovernor (kTargetFramerate);
   initializeImGui ();
   updateWindowSize ();
   scaleImGui (this->userScaleFactor);
@@ -12,6 +21,17 @@ void DesktopPlatform::initialize () {
   mainLoop ();
 }
 
+void DesktopPlatform::setThreadedRendering (bool enabled) {
+#if defined(__APPLE__)
+  if (enabled) {
+    LOG_W_STREAM << "Threaded rendering is not available on macOS, rendering on the main thread"
+                 << std::endl;
+  }
+  enabled = false;
+#endif
+  threadedRendering_ = enabled;
+}
+
 void DesktopPlatform::updateWindowSize () {
   int width, height;
   SDL_GL_GetDrawableSize (window_, &width, &height);
@@ -31,52 +51,248 @@ void DesktopPlatform::updateWindowSize () {
   }
 }
 
+bool DesktopPlatform::processEvents () {
+  bool done = false;
+  SDL_Event event;
+  while (SDL_PollEvent (&event)) {
+    ImGui_ImplSDL2_ProcessEvent (&event);
+    done = inputHandler.processEvent (event); // own event processing
+  }
+  return done;
+}
+
+float DesktopPlatform::advanceTime () {
+  static float totalTime = 0.0f;
+  static Uint32 lastTime = SDL_GetTicks ();
+  Uint32 currentTime = SDL_GetTicks ();
+
+  float deltaTime = (currentTime - lastTime) / 1000.0f;
+  totalTime += deltaTime;
+  lastTime = currentTime;
+  return totalTime;
+}
+
+void DesktopPlatform::limitFrameRate () {
+  // Frame rate limiting for desktop
+  static const int frameDelay = 1000 / kTargetFramerate;
+  static Uint32 lastFrameTime = SDL_GetTicks ();
+
+  Uint32 currentFrameTime = SDL_GetTicks ();
+  if (currentFrameTime - lastFrameTime < frameDelay) {
+    PROFILE_SCOPE ("Frame limiter");
+    SDL_Delay (frameDelay - (currentFrameTime - lastFrameTime));
+  } else {
+    LOG_W_EVERY_MS (2000, "Frame over budget: {} ms (target {} ms)",
+                    currentFrameTime - lastFrameTime, frameDelay);
+  }
+  LOG_D_EVERY_N (300, "Main loop: {:.1f} FPS, {} x {}", ImGui::GetIO ().Framerate, windowWidth_,
+                 windowHeight_);
+  lastFrameTime = SDL_GetTicks ();
+}
+
 void DesktopPlatform::mainLoop () {
+  if (threadedRendering_) {
+    threadedMainLoop ();
+    return;
+  }
+
   // For Desktop: Traditional game loop
   bool done = false;
-  SDL_Event event;
 
   while (!done) {
+    PROFILE_SCOPE ("Frame");
+    frameTimings_.beginFrame ();
     this->updateWindowSize ();
 
-    while (SDL_PollEvent (&event)) {
-      ImGui_ImplSDL2_ProcessEvent (&event);
-      done = inputHandler.processEvent (event); // own event processing
-    }
+    done = processEvents ();
+
+    assetLoader_.pump (); // completion callbacks run on the render thread
 
-    ImGui_ImplOpenGL3_NewFrame ();
-    ImGui_ImplSDL2_NewFrame ();
-    ImGui::NewFrame ();
+    JobSystem::shared ().drainMainThread (); // jobs queued with runOnMainThread
+    frameTimings_.endStage (FrameStage::Events);
 
-    this->buildImguiContent ();
+    {
+      PROFILE_SCOPE ("ImGui build");
+      ImGui_ImplOpenGL3_NewFrame ();
+      ImGui_ImplSDL2_NewFrame ();
+      ImGui::NewFrame ();
 
-    ImGui::Render ();
-    glViewport (0, 0, windowWidth_, windowHeight_);
-    glClearColor (0.45f, 0.55f, 0.60f, 1.00f);
-    glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      this->buildImguiContent ();
+
+      ImGui::Render ();
+    }
+    frameTimings_.endStage (FrameStage::ImGuiBuild);
+    clearFrame (windowWidth_, windowHeight_);
 
     // Render background shader - cumulative time
-    static float totalTime = 0.0f;
-    static Uint32 lastTime = SDL_GetTicks ();
-    Uint32 currentTime = SDL_GetTicks ();
-
-    float deltaTime = (currentTime - lastTime) / 1000.0f;
-    totalTime += deltaTime;
-    lastTime = currentTime;
-
-    renderBackground (totalTime); // Pass cumulative time, not delta
-    ImGui_ImplOpenGL3_RenderDrawData (ImGui::GetDrawData ());
-    SDL_GL_SwapWindow (window_);
-
-    // Frame rate limiting for desktop
-    static const int targetFramerate = 30;
-    static const int frameDelay = 1000 / targetFramerate;
-    static Uint32 lastFrameTime = SDL_GetTicks ();
-
-    Uint32 currentFrameTime = SDL_GetTicks ();
-    if (currentFrameTime - lastFrameTime < frameDelay) {
-      SDL_Delay (frameDelay - (currentFrameTime - lastFrameTime));
+    renderBackground (advanceTime ()); // Pass cumulative time, not delta
+    frameTimings_.endStage (FrameStage::Background);
+    {
+      PROFILE_SCOPE ("ImGui render");
+      ImGui_ImplOpenGL3_RenderDrawData (ImGui::GetDrawData ());
+    }
+    frameTimings_.endStage (FrameStage::ImGuiRender);
+    {
+      PROFILE_SCOPE ("SDL_GL_SwapWindow");
+      SDL_GL_SwapWindow (window_);
+    }
+
+    limitFrameRate ();
+  }
+}
+
+// ---- Threaded rendering ------------------------------------------------------------------------
+
+namespace {
+  // Grows dst only when needed, so steady state frames copy without allocating
+  template <typename T> void copyVector (const ImVector<T>& src, ImVector<T>& dst) {
+    dst.resize (src.Size);
+    if (src.Size > 0) {
+      std::memcpy (dst.Data, src.Data, src.size_in_bytes ());
+    }
+  }
+
+  // Atlas creation, glyph uploads and texture destruction happen inside RenderDrawData and write
+  // into ImGui's texture objects, such frames are drawn synchronously
+  bool hasPendingTextureUpdates () {
+    for (const ImTextureData* texture : ImGui::GetPlatformIO ().Textures) {
+      if (texture->Status == ImTextureStatus_WantCreate
+          || texture->Status == ImTextureStatus_WantUpdates
+          || texture->Status == ImTextureStatus_WantDestroy) {
+        return true;
+      }
     }
-    lastFrameTime = SDL_GetTicks ();
+    return false;
   }
-}
\ No newline at end of file
+}
+
+DesktopPlatform::RenderFrame::~RenderFrame () {
+  for (ImDrawList* list : lists) {
+    IM_DELETE (list);
+  }
+}
+
+// Draw commands keep their texture as a plain GL name, the render thread never reads ImGui's
+// texture objects. User callback data is not copied (the UI uses no draw callbacks).
+void DesktopPlatform::snapshotDrawData (const ImDrawData& source, RenderFrame& frame) {
+  while (frame.lists.size () < static_cast<std::size_t> (source.CmdListsCount)) {
+    frame.lists.push_back (IM_NEW (ImDrawList) (ImGui::GetDrawListSharedData ()));
+  }
+
+  ImDrawData& copy = frame.drawData;
+  copy.Clear ();
+  for (int i = 0; i < source.CmdListsCount; ++i) {
+    const ImDrawList* from = source.CmdLists[i];
+    ImDrawList* to = frame.lists[static_cast<std::size_t> (i)];
+    copyVector (from->CmdBuffer, to->CmdBuffer);
+    copyVector (from->IdxBuffer, to->IdxBuffer);
+    copyVector (from->VtxBuffer, to->VtxBuffer);
+    to->Flags = from->Flags;
+    for (ImDrawCmd& command : to->CmdBuffer) {
+      command.TexRef = ImTextureRef (command.GetTexID ());
+    }
+    copy.CmdLists.push_back (to);
+  }
+  copy.Valid = source.Valid;
+  copy.CmdListsCount = source.CmdListsCount;
+  copy.TotalIdxCount = source.TotalIdxCount;
+  copy.TotalVtxCount = source.TotalVtxCount;
+  copy.DisplayPos = source.DisplayPos;
+  copy.DisplaySize = source.DisplaySize;
+  copy.FramebufferScale = source.FramebufferScale;
+  copy.Textures = nullptr;
+  frame.direct = nullptr;
+}
+
+void DesktopPlatform::threadedMainLoop () {
+  // Device objects need GL, create them before the context moves to the render thread; from
+  // then on ImGui_ImplOpenGL3_NewFrame makes no GL calls
+  ImGui_ImplOpenGL3_CreateDeviceObjects ();
+  SDL_GL_MakeCurrent (window_, nullptr);
+  renderThread_ = std::thread ([this] { renderThreadLoop (); });
+  LOG_I_STREAM << "Threaded rendering: GL context moved to the render thread" << std::endl;
+
+  bool done = false;
+  while (!done) {
+    PROFILE_SCOPE ("Frame");
+    frameTimings_.beginFrame ();
+    this->updateWindowSize ();
+
+    done = processEvents ();
+
+    assetLoader_.pump (); // completion callbacks run on the UI thread
+
+    JobSystem::shared ().drainMainThread (); // jobs queued with runOnMainThread
+    frameTimings_.endStage (FrameStage::Events);
+
+    {
+      PROFILE_SCOPE ("ImGui build");
+      ImGui_ImplOpenGL3_NewFrame ();
+      ImGui_ImplSDL2_NewFrame ();
+      ImGui::NewFrame ();
+
+      this->buildImguiContent ();
+
+      ImGui::Render ();
+    }
+    frameTimings_.endStage (FrameStage::ImGuiBuild);
+
+    // Background and ImGui drawing run on the render thread; here the snapshot and hand-off are
+    // booked as ImGui render, and Background is what the render thread measured for the last
+    // frame it drew
+    frameTimings_.addStage (FrameStage::Background,
+                            renderBackgroundMs_.load (std::memory_order_relaxed));
+    {
+      PROFILE_SCOPE ("Snapshot frame");
+      RenderFrame& frame = mailbox_.back ();
+      frame.background = BackgroundState{ advanceTime (), windowWidth_, windowHeight_,
+                                          ImGui::GetIO ().Framerate };
+      const bool synchronous = hasPendingTextureUpdates ();
+      if (synchronous) {
+        frame.direct = ImGui::GetDrawData ();
+      } else {
+        snapshotDrawData (*ImGui::GetDrawData (), frame);
+      }
+      const std::uint64_t sequence = mailbox_.publish ();
+      if (synchronous) {
+        PROFILE_SCOPE ("Wait for texture upload");
+        mailbox_.waitConsumed (sequence);
+      }
+    }
+    frameTimings_.endStage (FrameStage::ImGuiRender);
+
+    limitFrameRate ();
+  }
+
+  mailbox_.close ();
+  renderThread_.join ();
+  SDL_GL_MakeCurrent (window_, glContext_); // shutdown () releases GL objects on this thread
+  LOG_D_FMT ("Threaded rendering stopped, {} of {} frames dropped", mailbox_.dropped (),
+             mailbox_.published ());
+}
+
+void DesktopPlatform::renderThreadLoop () {
+  PROFILE_THREAD ("Render");
+  SDL_GL_MakeCurrent (window_, glContext_);
+  while (RenderFrame* frame = mailbox_.acquire ()) {
+    PROFILE_SCOPE ("Render frame");
+    const std::uint64_t backgroundStart = FrameTimings::clockNs ();
+    clearFrame (frame->background.width, frame->background.height);
+
+    renderBackground (frame->background);
+    renderBackgroundMs_.store (
+        static_cast<float> (static_cast<double> (FrameTimings::clockNs () - backgroundStart) / 1e6),
+        std::memory_order_relaxed);
+    {
+      PROFILE_SCOPE ("ImGui render");
+      ImGui_ImplOpenGL3_RenderDrawData (frame->direct != nullptr ? frame->direct
+                                                                 : &frame->drawData);
+    }
+    {
+      PROFILE_SCOPE ("SDL_GL_SwapWindow");
+      SDL_GL_SwapWindow (window_);
+    }
+    mailbox_.release ();
+  }
+  SDL_GL_MakeCurrent (window_, nullptr);
+}
@@ -1,8 +1,13 @@
 #ifndef __DESKTOPPLATFORM_H__
 #define __DESKTOPPLATFORM_H__
 
+#include "FrameMailbox.hpp"
 #include "PlatformManager.hpp"
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 class DesktopPlatform : public PlatformManager {
 
 public:
@@ -10,9 +15,43 @@ public:
   ~DesktopPlatform () override = default;
   virtual void initialize () override;
 
+  // Threaded mode: the main thread keeps SDL events and ImGui frame building, a render thread owns
+  // the GL context and draws the newest frame snapshot. Input no longer waits for the GPU. Must be
+  // set before initialize (); not available on macOS (Cocoa swaps on the main thread only).
+  void setThreadedRendering (bool enabled);
+
 private:
   virtual void updateWindowSize () override;
   virtual void mainLoop () override;
+
+  // One UI frame for the render thread: ImGui draw lists copied into lists it owns, plus the
+  // background uniforms. Frames with pending texture uploads are not copied, the render thread
+  // draws ImGui's own draw data (direct) while the main thread waits.
+  struct RenderFrame {
+    RenderFrame () = default;
+    RenderFrame (const RenderFrame&) = delete;
+    RenderFrame& operator= (const RenderFrame&) = delete;
+    ~RenderFrame ();
+
+    std::vector<ImDrawList*> lists;
+    ImDrawData drawData;
+    ImDrawData* direct = nullptr;
+    BackgroundState background;
+  };
+
+  bool processEvents (); // true once the window should close
+  float advanceTime ();  // cumulative shader time
+  void limitFrameRate ();
+
+  void threadedMainLoop ();
+  void renderThreadLoop ();
+  void snapshotDrawData (const ImDrawData& source, RenderFrame& frame);
+
+  bool threadedRendering_ = false;
+  FrameMailbox<RenderFrame> mailbox_;
+  std::thread renderThread_;
+  // Clear + background of the last frame the render thread drew, in ms
+  std::atomic<float> renderBackgroundMs_{ 0.0f };
 };
 
-#endif // __DESKTOPPLATFORM_H__
\ No newline at end of file
+#endif // __DESKTOPPLATFORM_H__
@@ -113,12 +113,15 @@ void EmscriptenPlatform::updateWindowSize () {
 }
 
 void EmscriptenPlatform::initialize () {
+  PROFILE_THREAD ("Main");
   currentWebGLVersion_ = detectWebGLVersionByJS ();
   const bool isInfiniteLoop = true; // Emscripten main loop runs indefinitely
+  prefetchAssets ();
   createSDL2Window ("Emscripten SDL2 Window", windowWidth_, windowHeight_);
   createOpenGLContext (1);
   setupQuad ();
   setupShaders ();
+  setupQualityGovernor (DEFAULT_FPS_); // requestAnimationFrame, usually the display rate
   initializeImGui ();
   updateWindowSize ();
   scaleImGui (this->userScaleFactor);
@@ -141,6 +144,8 @@ int EmscriptenPlatform::getShaderTarget () {
 
 void EmscriptenPlatform::mainLoop () {
   // For Emscripten: Single iteration - called by emscripten_set_main_loop_arg
+  PROFILE_SCOPE ("Frame");
+  frameTimings_.beginFrame ();
   this->updateWindowSize ();
 
   SDL_Event event;
@@ -153,16 +158,23 @@ void EmscriptenPlatform::mainLoop () {
     }
   }
 
-  ImGui_ImplOpenGL3_NewFrame ();
-  ImGui_ImplSDL2_NewFrame ();
-  ImGui::NewFrame ();
+  assetLoader_.pump (); // completion callbacks run on the render thread
 
-  this->buildImguiContent ();
+  JobSystem::shared ().drainMainThread (); // jobs queued with runOnMainThread
+  frameTimings_.endStage (FrameStage::Events);
 
-  ImGui::Render ();
-  glViewport (0, 0, windowWidth_, windowHeight_);
-  glClearColor (0.45f, 0.55f, 0.60f, 1.00f);
-  glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  {
+    PROFILE_SCOPE ("ImGui build");
+    ImGui_ImplOpenGL3_NewFrame ();
+    ImGui_ImplSDL2_NewFrame ();
+    ImGui::NewFrame ();
+
+    this->buildImguiContent ();
+
+    ImGui::Render ();
+  }
+  frameTimings_.endStage (FrameStage::ImGuiBuild);
+  clearFrame (windowWidth_, windowHeight_);
 
   // Render background shader - cumulative time using SDL_GetTicks for better precision
   static float totalTime = 0.0f;
@@ -174,6 +186,14 @@ void EmscriptenPlatform::mainLoop () {
   lastTime = currentTime;
 
   renderBackground (totalTime); // Pass cumulative time, not delta
-  ImGui_ImplOpenGL3_RenderDrawData (ImGui::GetDrawData ());
-  SDL_GL_SwapWindow (window_);
+  frameTimings_.endStage (FrameStage::Background);
+  {
+    PROFILE_SCOPE ("ImGui render");
+    ImGui_ImplOpenGL3_RenderDrawData (ImGui::GetDrawData ());
+  }
+  frameTimings_.endStage (FrameStage::ImGuiRender);
+  {
+    PROFILE_SCOPE ("SDL_GL_SwapWindow");
+    SDL_GL_SwapWindow (window_);
+  }
 }
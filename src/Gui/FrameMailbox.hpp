@@ -0,0 +1,93 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Triple-buffered mailbox handing finished frames from the UI thread to the render thread
+
+#ifndef __FRAMEMAILBOX_H__
+#define __FRAMEMAILBOX_H__
+
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+
+// Three slots: the producer fills back (), publish () swaps it with the ready slot and the
+// consumer swaps ready with its front slot in acquire (). Neither side ever waits for the other
+// to finish with a slot; a frame that was not picked up before the next publish () is replaced
+// (counted in dropped ()), so the consumer always renders the newest frame and the producer never
+// queues behind a slow GPU. Slots are reused, their buffers keep their capacity.
+template <typename T> class FrameMailbox {
+public:
+  // Producer side
+  T& back () {
+    return slots_[back_];
+  }
+
+  // Returns the frame's sequence number for waitConsumed ()
+  std::uint64_t publish () {
+    std::lock_guard<std::mutex> lock (mutex_);
+    sequences_[back_] = ++published_;
+    std::swap (back_, ready_);
+    if (fresh_) {
+      ++dropped_;
+    }
+    fresh_ = true;
+    changed_.notify_all ();
+    return published_;
+  }
+
+  // Blocks until the consumer released this frame or a newer one (or the mailbox was closed)
+  void waitConsumed (std::uint64_t sequence) {
+    std::unique_lock<std::mutex> lock (mutex_);
+    changed_.wait (lock, [&] { return consumed_ >= sequence || closed_; });
+  }
+
+  // Consumer side: blocks for a frame newer than the last one, nullptr once closed
+  T* acquire () {
+    std::unique_lock<std::mutex> lock (mutex_);
+    changed_.wait (lock, [&] { return fresh_ || closed_; });
+    if (closed_) {
+      return nullptr;
+    }
+    std::swap (front_, ready_);
+    fresh_ = false;
+    return &slots_[front_];
+  }
+
+  // The acquired frame is done
+  void release () {
+    std::lock_guard<std::mutex> lock (mutex_);
+    consumed_ = sequences_[front_];
+    changed_.notify_all ();
+  }
+
+  void close () {
+    std::lock_guard<std::mutex> lock (mutex_);
+    closed_ = true;
+    changed_.notify_all ();
+  }
+
+  std::uint64_t published () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return published_;
+  }
+
+  std::uint64_t dropped () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return dropped_;
+  }
+
+private:
+  std::array<T, 3> slots_{};
+  std::array<std::uint64_t, 3> sequences_{};
+  int back_ = 0, ready_ = 1, front_ = 2;
+  bool fresh_ = false;
+  bool closed_ = false;
+  std::uint64_t published_ = 0;
+  std::uint64_t consumed_ = 0;
+  std::uint64_t dropped_ = 0;
+  mutable std::mutex mutex_;
+  std::condition_variable changed_;
+};
+
+#endif // __FRAMEMAILBOX_H__
@@ -0,0 +1,142 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Per-frame stage timings in a fixed ring, with frame time percentiles for the overlay
+
+#ifndef __FRAMETIMINGS_H__
+#define __FRAMETIMINGS_H__
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+enum class FrameStage : std::uint8_t {
+  Events,      // SDL event polling and asset loader callbacks
+  ImGuiBuild,  // NewFrame, window content, ImGui::Render
+  Background,  // clear and background shader
+  ImGuiRender, // draw data submission
+  SwapWait,    // swap, frame limiter and anything until the next frame starts
+  Count
+};
+
+// The main loop marks stage boundaries; the time since the previous mark goes to the stage that
+// just ended. beginFrame () closes the previous frame, so swap and frame pacing (or the browser's
+// requestAnimationFrame gap on Emscripten) end up in SwapWait without a mark of their own.
+// Storage is a fixed array, recording and stats () never allocate.
+class FrameTimings {
+public:
+  static constexpr std::size_t kStages = static_cast<std::size_t> (FrameStage::Count);
+  static constexpr std::size_t kCapacity = 240; // 8 s at the 30 FPS desktop limit
+
+  struct Sample {
+    std::array<float, kStages> stageMs{};
+    float totalMs = 0.0f;
+  };
+
+  struct Stats {
+    float p50 = 0.0f, p95 = 0.0f, p99 = 0.0f, max = 0.0f;
+    std::array<float, kStages> stageAverageMs{};
+    std::size_t frames = 0;
+  };
+
+  static const char* stageName (FrameStage stage) {
+    static constexpr const char* kNames[kStages]
+        = { "Events", "ImGui build", "Background", "ImGui render", "Swap/wait" };
+    return kNames[static_cast<std::size_t> (stage)];
+  }
+
+  static std::uint64_t clockNs () {
+    return static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (
+                                           std::chrono::steady_clock::now ().time_since_epoch ())
+                                           .count ());
+  }
+
+  void beginFrame (std::uint64_t nowNs = clockNs ()) {
+    if (frameStartNs_ != 0) {
+      current_.stageMs[static_cast<std::size_t> (FrameStage::SwapWait)] += toMs (nowNs - markNs_);
+      current_.totalMs = toMs (nowNs - frameStartNs_);
+      samples_[head_] = current_;
+      head_ = (head_ + 1) % kCapacity;
+      count_ = std::min (count_ + 1, kCapacity);
+    }
+    current_ = Sample{};
+    frameStartNs_ = markNs_ = nowNs;
+  }
+
+  void endStage (FrameStage stage, std::uint64_t nowNs = clockNs ()) {
+    if (frameStartNs_ == 0) {
+      return;
+    }
+    current_.stageMs[static_cast<std::size_t> (stage)] += toMs (nowNs - markNs_);
+    markNs_ = nowNs;
+  }
+
+  // A stage measured on another thread (the render thread with threaded rendering), booked as
+  // is without moving the mark. It overlaps the marked stages, so the stages of such a frame can
+  // add up to more than totalMs.
+  void addStage (FrameStage stage, float ms) {
+    if (frameStartNs_ == 0) {
+      return;
+    }
+    current_.stageMs[static_cast<std::size_t> (stage)] += ms;
+  }
+
+  std::size_t size () const {
+    return count_;
+  }
+
+  // 0 is the oldest completed frame
+  const Sample& sample (std::size_t index) const {
+    return samples_[(head_ + kCapacity - count_ + index) % kCapacity];
+  }
+
+  // Nearest-rank percentiles of the frame time over the ring
+  Stats stats () const {
+    Stats out;
+    out.frames = count_;
+    if (count_ == 0) {
+      return out;
+    }
+    std::array<float, kCapacity> sorted;
+    for (std::size_t i = 0; i < count_; ++i) {
+      const Sample& s = sample (i);
+      sorted[i] = s.totalMs;
+      for (std::size_t stage = 0; stage < kStages; ++stage) {
+        out.stageAverageMs[stage] += s.stageMs[stage];
+      }
+    }
+    for (float& average : out.stageAverageMs) {
+      average /= static_cast<float> (count_);
+    }
+    std::sort (sorted.begin (), sorted.begin () + static_cast<std::ptrdiff_t> (count_));
+    const auto rank = [&] (double percentile) {
+      const auto index = static_cast<std::size_t> (percentile * static_cast<double> (count_) - 1e-9);
+      return sorted[std::min (index, count_ - 1)];
+    };
+    out.p50 = rank (0.50);
+    out.p95 = rank (0.95);
+    out.p99 = rank (0.99);
+    out.max = sorted[count_ - 1];
+    return out;
+  }
+
+  void clear () {
+    head_ = count_ = 0;
+    frameStartNs_ = markNs_ = 0;
+  }
+
+private:
+  static float toMs (std::uint64_t ns) {
+    return static_cast<float> (static_cast<double> (ns) / 1e6);
+  }
+
+  std::array<Sample, kCapacity> samples_{};
+  std::size_t head_ = 0;
+  std::size_t count_ = 0;
+  Sample current_;
+  std::uint64_t frameStartNs_ = 0;
+  std::uint64_t markNs_ = 0;
+};
+
+#endif // __FRAMETIMINGS_H__
@@ -0,0 +1,221 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Shadow copy of the GL state our renderers touch, so redundant changes and glGet* are skipped
+
+#ifndef __GLSTATECACHE_H__
+#define __GLSTATECACHE_H__
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+// Every setter records the value and returns true when the GL call is still needed, i.e. the
+// value differs from the shadow or the shadow does not know it yet:
+//
+//   if (state.useProgram (program)) glUseProgram (program);
+//
+// The cache makes no GL calls itself and includes no GL header: the ImGui backend and our code
+// use different loaders (gl3w vs GLEW), values are plain GLuint/GLenum/GLint numbers. The backend
+// is our fork in ImGuiOpenGL3Backend.cpp; the stock one conan ships knows nothing of the cache.
+//
+// It is only correct while all tracked state goes through it. Code that changes tracked state
+// behind its back calls invalidate () (or the matching delete* when objects go away), after
+// which the next setter of each value issues the call again. PlatformManager owns the instance
+// for its context and makes it current; without one, current () is a pass-through cache that
+// never skips, and the ImGui backend then backs up and restores state itself.
+class GlStateCache {
+public:
+  enum class Cap : std::uint8_t {
+    Blend,
+    CullFace,
+    DepthTest,
+    StencilTest,
+    ScissorTest,
+    PrimitiveRestart,
+    Count
+  };
+
+  static constexpr unsigned kTexture0 = 0x84C0; // GL_TEXTURE0
+  static constexpr std::size_t kTextureUnits = 16;
+
+  explicit GlStateCache (bool enabled = true) : enabled_ (enabled) {
+  }
+
+  // The cache of the context current on this process' GL thread
+  static GlStateCache& current () {
+    return current_ != nullptr ? *current_ : passThrough ();
+  }
+
+  static void makeCurrent (GlStateCache* cache) {
+    current_ = cache;
+  }
+
+  // false for the pass-through cache: every setter returns true, nothing is remembered
+  bool enabled () const {
+    return enabled_;
+  }
+
+  bool useProgram (unsigned program) {
+    return change (program_, program);
+  }
+
+  bool activeTexture (unsigned unit) {
+    return change (activeTexture_, unit);
+  }
+
+  // On the active unit; always issued while the active unit is unknown
+  bool bindTexture2D (unsigned texture) {
+    if (std::optional<unsigned>* slot = activeTextureSlot ()) {
+      return change (*slot, texture);
+    }
+    return issue ();
+  }
+
+  bool bindSampler (unsigned unit, unsigned sampler) {
+    return unit < kTextureUnits ? change (samplers_[unit], sampler) : issue ();
+  }
+
+  bool bindArrayBuffer (unsigned buffer) {
+    return change (arrayBuffer_, buffer);
+  }
+
+  bool bindVertexArray (unsigned vertexArray) {
+    return change (vertexArray_, vertexArray);
+  }
+
+  bool enable (Cap cap, bool on) {
+    return change (caps_[static_cast<std::size_t> (cap)], on);
+  }
+
+  bool blendEquation (unsigned rgb, unsigned alpha) {
+    return change (blendEquation_, { rgb, alpha });
+  }
+
+  bool blendFunc (unsigned srcRgb, unsigned dstRgb, unsigned srcAlpha, unsigned dstAlpha) {
+    return change (blendFunc_, { srcRgb, dstRgb, srcAlpha, dstAlpha });
+  }
+
+  bool polygonMode (unsigned mode) {
+    return change (polygonMode_, mode);
+  }
+
+  bool viewport (int x, int y, int width, int height) {
+    return change (viewport_, { x, y, width, height });
+  }
+
+  bool scissor (int x, int y, int width, int height) {
+    return change (scissor_, { x, y, width, height });
+  }
+
+  // Deleted objects are unbound by GL; their names may come back from glGen* later
+  void deleteTexture (unsigned texture) {
+    for (std::optional<unsigned>& bound : textures_) {
+      if (bound == texture) {
+        bound = 0u;
+      }
+    }
+  }
+
+  void deleteBuffer (unsigned buffer) {
+    if (arrayBuffer_ == buffer) {
+      arrayBuffer_ = 0u;
+    }
+  }
+
+  void deleteVertexArray (unsigned vertexArray) {
+    if (vertexArray_ == vertexArray) {
+      vertexArray_ = 0u;
+    }
+  }
+
+  // A deleted program stays in use until replaced, only forget it
+  void deleteProgram (unsigned program) {
+    if (program_ == program) {
+      program_.reset ();
+    }
+  }
+
+  // Forget everything, e.g. after foreign code ran or the context was recreated
+  void invalidate () {
+    program_.reset ();
+    activeTexture_.reset ();
+    textures_.fill (std::nullopt);
+    samplers_.fill (std::nullopt);
+    arrayBuffer_.reset ();
+    vertexArray_.reset ();
+    caps_.fill (std::nullopt);
+    blendEquation_.reset ();
+    blendFunc_.reset ();
+    polygonMode_.reset ();
+    viewport_.reset ();
+    scissor_.reset ();
+  }
+
+  // Setter calls that needed a GL call / were skipped, since construction. May be read from
+  // another thread than the one rendering (the overlay in threaded mode).
+  std::uint64_t issued () const {
+    return issued_.load (std::memory_order_relaxed);
+  }
+
+  std::uint64_t skipped () const {
+    return skipped_.load (std::memory_order_relaxed);
+  }
+
+private:
+  // Single writer, a plain add instead of a locked one
+  static void count (std::atomic<std::uint64_t>& counter) {
+    counter.store (counter.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+
+  static GlStateCache& passThrough () {
+    static GlStateCache cache (false);
+    return cache;
+  }
+
+  bool issue () {
+    count (issued_);
+    return true;
+  }
+
+  template <typename T> bool change (std::optional<T>& shadow, const T& value) {
+    if (!enabled_) {
+      return issue ();
+    }
+    if (shadow == value) {
+      count (skipped_);
+      return false;
+    }
+    shadow = value;
+    return issue ();
+  }
+
+  std::optional<unsigned>* activeTextureSlot () {
+    if (!enabled_ || !activeTexture_ || *activeTexture_ < kTexture0
+        || *activeTexture_ - kTexture0 >= kTextureUnits) {
+      return nullptr;
+    }
+    return &textures_[*activeTexture_ - kTexture0];
+  }
+
+  inline static GlStateCache* current_ = nullptr;
+
+  bool enabled_;
+  std::optional<unsigned> program_;
+  std::optional<unsigned> activeTexture_;
+  std::array<std::optional<unsigned>, kTextureUnits> textures_{};
+  std::array<std::optional<unsigned>, kTextureUnits> samplers_{};
+  std::optional<unsigned> arrayBuffer_;
+  std::optional<unsigned> vertexArray_;
+  std::array<std::optional<bool>, static_cast<std::size_t> (Cap::Count)> caps_{};
+  std::optional<std::array<unsigned, 2>> blendEquation_;
+  std::optional<std::array<unsigned, 4>> blendFunc_;
+  std::optional<unsigned> polygonMode_;
+  std::optional<std::array<int, 4>> viewport_;
+  std::optional<std::array<int, 4>> scissor_;
+  std::atomic<std::uint64_t> issued_{ 0 };
+  std::atomic<std::uint64_t> skipped_{ 0 };
+};
+
+#endif // __GLSTATECACHE_H__
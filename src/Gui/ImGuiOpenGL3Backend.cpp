@@ -21,8 +21,14 @@
 // - Documentation        https://dearimgui.com/docs (same as your local docs/ folder).
 // - Introduction, links and more at the top of imgui.cpp
 
+// Local fork of backends/imgui_impl_opengl3.cpp (with its header and GL loader as ImGuiOpenGL3Backend.h
+// and ImGuiOpenGL3Loader.h), kept out of src/bindings because conan install copies the stock backends
+// there. Entries marked [local] are ours; merge upstream updates into this file by hand.
+
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2025-07-27: OpenGL: [local] State changes go through GlStateCache::current(). While its owner keeps an enabled cache current, redundant binds are skipped and RenderDrawData() neither queries (glGet*) nor restores GL state.
+//  2025-07-20: OpenGL: [local] Desktop GL 3.2+ uploads the whole frame into one buffer pair: persistently mapped rings recycled by fences on GL 4.4+/GL_ARB_buffer_storage, orphaned storage with kept capacity otherwise. #define IMGUI_IMPL_OPENGL_DISABLE_PERSISTENT_BUFFERS to opt out of the former.
 //  2025-06-11: OpenGL: Added support for ImGuiBackendFlags_RendererHasTextures, for dynamic font atlas. Removed ImGui_ImplOpenGL3_CreateFontsTexture() and ImGui_ImplOpenGL3_DestroyFontsTexture().
 //  2025-06-04: OpenGL: Made GLES 3.20 contexts not access GL_CONTEXT_PROFILE_MASK nor GL_PRIMITIVE_RESTART. (#8664)
 //  2025-02-18: OpenGL: Lazily reinitialize embedded GL loader for when calling backend from e.g. other DLL boundaries. (#8406)
@@ -119,7 +125,8 @@
 
 #include "imgui.h"
 #ifndef IMGUI_DISABLE
-#include "imgui_impl_opengl3.h"
+#include "ImGuiOpenGL3Backend.h"
+#include "GlStateCache.hpp"
 #include <stdio.h>
 #include <stdint.h>     // intptr_t
 #if defined(__APPLE__)
@@ -174,7 +181,7 @@
 // Changes to this backend using new APIs should be accompanied by a regenerated stripped loader version.
 #define IMGL3W_IMPL
 #define IMGUI_IMPL_OPENGL_LOADER_IMGL3W
-#include "imgui_impl_opengl3_loader.h"
+#include "ImGuiOpenGL3Loader.h"
 #endif
 
 // Vertex arrays are not supported on ES2/WebGL1 unless Emscripten which uses an extension
@@ -210,6 +217,11 @@
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
 #endif
 
+// Desktop GL 4.4+ (or GL_ARB_buffer_storage) has glBufferStorage() for persistently mapped buffers. Checked at runtime too.
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3) && defined(GL_VERSION_4_4) && defined(IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET) && !defined(IMGUI_IMPL_OPENGL_DISABLE_PERSISTENT_BUFFERS)
+#define IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+#endif
+
 // Desktop GL 3.3+ and GL ES 3.0+ have glBindSampler()
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && (defined(IMGUI_IMPL_OPENGL_ES3) || defined(GL_VERSION_3_3))
 #define IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
@@ -224,6 +236,9 @@
 #define GL_CALL(_CALL)      _CALL   // Call without error check
 #endif
 
+// Frames in flight for the persistently mapped rings: the region written this frame was last read by the GPU this many frames ago
+#define IMGUI_IMPL_OPENGL_STREAM_REGIONS 3
+
 // OpenGL Data
 struct ImGui_ImplOpenGL3_Data
 {
@@ -246,6 +261,14 @@ struct ImGui_ImplOpenGL3_Data
     bool            HasPolygonMode;
     bool            HasClipOrigin;
     bool            UseBufferSubData;
+    bool            UseFrameUpload;          // Whole frame in one buffer pair, lists addressed with base vertex (desktop GL 3.2+). VertexBufferSize/IndexBufferSize are then the capacity (per region when persistent).
+    bool            UsePersistentBuffers;    // Immutable storage mapped once, IMGUI_IMPL_OPENGL_STREAM_REGIONS regions used round robin
+    char*           MappedVtx;
+    char*           MappedIdx;
+    int             StreamRegion;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    GLsync          StreamFences[IMGUI_IMPL_OPENGL_STREAM_REGIONS];
+#endif
     ImVector<char>  TempBuffer;
 
     ImGui_ImplOpenGL3_Data() { memset((void*)this, 0, sizeof(*this)); }
@@ -396,6 +419,7 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
     bd->HasPolygonMode = (!bd->GlProfileIsES2 && !bd->GlProfileIsES3);
 #endif
     bd->HasClipOrigin = (bd->GlVersion >= 450);
+    bool has_buffer_storage = (bd->GlVersion >= 440);
 #ifdef IMGUI_IMPL_OPENGL_HAS_EXTENSIONS
     GLint num_extensions = 0;
     glGetIntegerv(GL_NUM_EXTENSIONS, &num_extensions);
@@ -404,8 +428,17 @@ bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
         const char* extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
         if (extension != nullptr && strcmp(extension, "GL_ARB_clip_control") == 0)
             bd->HasClipOrigin = true;
+        if (extension != nullptr && strcmp(extension, "GL_ARB_buffer_storage") == 0)
+            has_buffer_storage = true;
     }
 #endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    bd->UseFrameUpload = (!bd->GlProfileIsES2 && !bd->GlProfileIsES3 && bd->GlVersion >= 320);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    bd->UsePersistentBuffers = (bd->UseFrameUpload && has_buffer_storage && glBufferStorage != nullptr && glFenceSync != nullptr);
+#endif
+    IM_UNUSED(has_buffer_storage);
 
     return true;
 }
@@ -438,28 +471,30 @@ void    ImGui_ImplOpenGL3_NewFrame()
 static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    GlStateCache& state = GlStateCache::current();
 
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
-    glEnable(GL_BLEND);
-    glBlendEquation(GL_FUNC_ADD);
-    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
-    glDisable(GL_CULL_FACE);
-    glDisable(GL_DEPTH_TEST);
-    glDisable(GL_STENCIL_TEST);
-    glEnable(GL_SCISSOR_TEST);
+    if (state.enable(GlStateCache::Cap::Blend, true)) glEnable(GL_BLEND);
+    if (state.blendEquation(GL_FUNC_ADD, GL_FUNC_ADD)) glBlendEquation(GL_FUNC_ADD);
+    if (state.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA)) glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
+    if (state.enable(GlStateCache::Cap::CullFace, false)) glDisable(GL_CULL_FACE);
+    if (state.enable(GlStateCache::Cap::DepthTest, false)) glDisable(GL_DEPTH_TEST);
+    if (state.enable(GlStateCache::Cap::StencilTest, false)) glDisable(GL_STENCIL_TEST);
+    if (state.enable(GlStateCache::Cap::ScissorTest, true)) glEnable(GL_SCISSOR_TEST);
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (!bd->GlProfileIsES3 && bd->GlVersion >= 310)
+    if (!bd->GlProfileIsES3 && bd->GlVersion >= 310 && state.enable(GlStateCache::Cap::PrimitiveRestart, false))
         glDisable(GL_PRIMITIVE_RESTART);
 #endif
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    if (bd->HasPolygonMode)
+    if (bd->HasPolygonMode && state.polygonMode(GL_FILL))
         glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
 #endif
 
     // Support for GL 4.5 rarely used glClipControl(GL_UPPER_LEFT)
+    // Not queried while a state cache is active: nothing in this application calls glClipControl()
 #if defined(GL_CLIP_ORIGIN)
     bool clip_origin_lower_left = true;
-    if (bd->HasClipOrigin)
+    if (bd->HasClipOrigin && !state.enabled())
     {
         GLenum current_clip_origin = 0; glGetIntegerv(GL_CLIP_ORIGIN, (GLint*)&current_clip_origin);
         if (current_clip_origin == GL_UPPER_LEFT)
@@ -469,7 +504,8 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 
     // Setup viewport, orthographic projection matrix
     // Our visible imgui space lies from draw_data->DisplayPos (top left) to draw_data->DisplayPos+data_data->DisplaySize (bottom right). DisplayPos is (0,0) for single viewport apps.
-    GL_CALL(glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height));
+    if (state.viewport(0, 0, fb_width, fb_height))
+        GL_CALL(glViewport(0, 0, (GLsizei)fb_width, (GLsizei)fb_height));
     float L = draw_data->DisplayPos.x;
     float R = draw_data->DisplayPos.x + draw_data->DisplaySize.x;
     float T = draw_data->DisplayPos.y;
@@ -484,22 +520,25 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
         { 0.0f,         0.0f,        -1.0f,   0.0f },
         { (R+L)/(L-R),  (T+B)/(B-T),  0.0f,   1.0f },
     };
-    glUseProgram(bd->ShaderHandle);
+    if (state.useProgram(bd->ShaderHandle))
+        glUseProgram(bd->ShaderHandle);
     glUniform1i(bd->AttribLocationTex, 0);
     glUniformMatrix4fv(bd->AttribLocationProjMtx, 1, GL_FALSE, &ortho_projection[0][0]);
 
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
+    if ((bd->GlVersion >= 330 || bd->GlProfileIsES3) && state.bindSampler(0, 0))
         glBindSampler(0, 0); // We use combined texture/sampler state. Applications using GL 3.3 and GL ES 3.0 may set that otherwise.
 #endif
 
     (void)vertex_array_object;
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(vertex_array_object);
+    if (state.bindVertexArray(vertex_array_object))
+        glBindVertexArray(vertex_array_object);
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+    if (state.bindArrayBuffer(bd->VboHandle))
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
     GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxPos));
     GL_CALL(glEnableVertexAttribArray(bd->AttribLocationVtxUV));
@@ -509,6 +548,254 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     GL_CALL(glVertexAttribPointer(bd->AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(ImDrawVert), (GLvoid*)offsetof(ImDrawVert, col)));
 }
 
+// Capacity for 'count' elements with headroom, so a growing UI does not reallocate every few frames
+static GLsizeiptr ImGui_ImplOpenGL3_GrowStreamSize(int count, int element_size)
+{
+    const GLsizeiptr elements = (GLsizeiptr)count + count / 2 + 4096;
+    return elements * element_size;
+}
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+static void ImGui_ImplOpenGL3_WaitStreamFence(GLsync& fence)
+{
+    if (fence == nullptr)
+        return;
+    for (;;)
+    {
+        GLenum result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000); // 1 ms
+        if (result == GL_ALREADY_SIGNALED || result == GL_CONDITION_SATISFIED || result == GL_WAIT_FAILED)
+            break;
+    }
+    glDeleteSync(fence);
+    fence = nullptr;
+}
+
+static void ImGui_ImplOpenGL3_DestroyStreamFences()
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    for (GLsync& fence : bd->StreamFences)
+        if (fence != nullptr) { glDeleteSync(fence); fence = nullptr; }
+}
+
+// Replaces VboHandle/ElementsHandle with immutable storage for IMGUI_IMPL_OPENGL_STREAM_REGIONS regions of the given sizes, mapped for the buffers' lifetime.
+// The old buffers may still be read by queued draws; GL keeps their storage alive until then.
+static void ImGui_ImplOpenGL3_CreatePersistentBuffers(GLsizeiptr vtx_region_size, GLsizeiptr idx_region_size)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    GlStateCache& state = GlStateCache::current();
+    ImGui_ImplOpenGL3_DestroyStreamFences();
+    glDeleteBuffers(1, &bd->VboHandle);
+    glDeleteBuffers(1, &bd->ElementsHandle);
+    state.deleteBuffer(bd->VboHandle);
+    glGenBuffers(1, &bd->VboHandle);
+    glGenBuffers(1, &bd->ElementsHandle);
+
+    const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    if (state.bindArrayBuffer(bd->VboHandle))
+        GL_CALL(glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle));
+    GL_CALL(glBufferStorage(GL_ARRAY_BUFFER, vtx_region_size * IMGUI_IMPL_OPENGL_STREAM_REGIONS, nullptr, flags));
+    bd->MappedVtx = (char*)glMapBufferRange(GL_ARRAY_BUFFER, 0, vtx_region_size * IMGUI_IMPL_OPENGL_STREAM_REGIONS, flags);
+    GL_CALL(glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle));
+    GL_CALL(glBufferStorage(GL_ELEMENT_ARRAY_BUFFER, idx_region_size * IMGUI_IMPL_OPENGL_STREAM_REGIONS, nullptr, flags));
+    bd->MappedIdx = (char*)glMapBufferRange(GL_ELEMENT_ARRAY_BUFFER, 0, idx_region_size * IMGUI_IMPL_OPENGL_STREAM_REGIONS, flags);
+    bd->VertexBufferSize = vtx_region_size;
+    bd->IndexBufferSize = idx_region_size;
+    bd->StreamRegion = 0;
+
+    if (bd->MappedVtx == nullptr || bd->MappedIdx == nullptr)
+    {
+        // Driver refused the mapping: plain buffers from now on
+        bd->UsePersistentBuffers = false;
+        bd->MappedVtx = bd->MappedIdx = nullptr;
+        glDeleteBuffers(1, &bd->VboHandle);
+        glDeleteBuffers(1, &bd->ElementsHandle);
+        state.deleteBuffer(bd->VboHandle);
+        glGenBuffers(1, &bd->VboHandle);
+        glGenBuffers(1, &bd->ElementsHandle);
+        if (state.bindArrayBuffer(bd->VboHandle))
+            glBindBuffer(GL_ARRAY_BUFFER, bd->VboHandle);
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bd->ElementsHandle);
+        bd->VertexBufferSize = bd->IndexBufferSize = 0;
+    }
+}
+#endif
+
+// Uploads every command list of the frame, back to back, into the bound VBO/IBO. Replaces the per-list glBufferData() calls,
+// which make the driver allocate fresh storage for every list every frame.
+// Returns false when lists have to be uploaded one by one (no base vertex: GL < 3.2, GL ES, WebGL).
+// *out_vtx_offset/*out_idx_offset receive where this frame starts in the buffers (bytes); *out_rebound is set when the buffers were replaced and the VAO needs setting up again.
+static bool ImGui_ImplOpenGL3_UploadDrawData(ImDrawData* draw_data, GLsizeiptr* out_vtx_offset, GLsizeiptr* out_idx_offset, bool* out_rebound)
+{
+    ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
+    *out_vtx_offset = *out_idx_offset = 0;
+    *out_rebound = false;
+    if (!bd->UseFrameUpload)
+        return false;
+    const GLsizeiptr vtx_size = (GLsizeiptr)draw_data->TotalVtxCount * (int)sizeof(ImDrawVert);
+    const GLsizeiptr idx_size = (GLsizeiptr)draw_data->TotalIdxCount * (int)sizeof(ImDrawIdx);
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    if (bd->UsePersistentBuffers)
+    {
+        if (bd->MappedVtx == nullptr || vtx_size > bd->VertexBufferSize || idx_size > bd->IndexBufferSize)
+        {
+            const GLsizeiptr vtx_region_size = ImGui_ImplOpenGL3_GrowStreamSize(draw_data->TotalVtxCount, (int)sizeof(ImDrawVert));
+            const GLsizeiptr idx_region_size = ImGui_ImplOpenGL3_GrowStreamSize(draw_data->TotalIdxCount, (int)sizeof(ImDrawIdx));
+            ImGui_ImplOpenGL3_CreatePersistentBuffers(vtx_region_size > bd->VertexBufferSize ? vtx_region_size : bd->VertexBufferSize,
+                                                      idx_region_size > bd->IndexBufferSize ? idx_region_size : bd->IndexBufferSize);
+            *out_rebound = true;
+        }
+    }
+    if (bd->UsePersistentBuffers)
+    {
+        // The GPU read this region IMGUI_IMPL_OPENGL_STREAM_REGIONS frames ago, normally long done
+        const int region = bd->StreamRegion;
+        ImGui_ImplOpenGL3_WaitStreamFence(bd->StreamFences[region]);
+        *out_vtx_offset = bd->VertexBufferSize * region;
+        *out_idx_offset = bd->IndexBufferSize * region;
+        char* vtx_dst = bd->MappedVtx + *out_vtx_offset;
+        char* idx_dst = bd->MappedIdx + *out_idx_offset;
+        for (const ImDrawList* draw_list : draw_data->CmdLists)
+        {
+            memcpy(vtx_dst, draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes());
+            memcpy(idx_dst, draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes());
+            vtx_dst += draw_list->VtxBuffer.size_in_bytes();
+            idx_dst += draw_list->IdxBuffer.size_in_bytes();
+        }
+        return true; // coherent mapping, no flush needed
+    }
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
+    // Orphan: glBufferData(nullptr) hands us fresh storage of the kept capacity without waiting for draws still reading the old one,
+    // then each list goes to its own range. One allocation per frame and buffer instead of one per list, no growth most frames.
+    if (vtx_size > bd->VertexBufferSize)
+        bd->VertexBufferSize = ImGui_ImplOpenGL3_GrowStreamSize(draw_data->TotalVtxCount, (int)sizeof(ImDrawVert));
+    if (idx_size > bd->IndexBufferSize)
+        bd->IndexBufferSize = ImGui_ImplOpenGL3_GrowStreamSize(draw_data->TotalIdxCount, (int)sizeof(ImDrawIdx));
+    GL_CALL(glBufferData(GL_ARRAY_BUFFER, bd->VertexBufferSize, nullptr, GL_STREAM_DRAW));
+    GL_CALL(glBufferData(GL_ELEMENT_ARRAY_BUFFER, bd->IndexBufferSize, nullptr, GL_STREAM_DRAW));
+    GLintptr vtx_offset = 0, idx_offset = 0;
+    for (const ImDrawList* draw_list : draw_data->CmdLists)
+    {
+        GL_CALL(glBufferSubData(GL_ARRAY_BUFFER, vtx_offset, (GLsizeiptr)draw_list->VtxBuffer.size_in_bytes(), (const GLvoid*)draw_list->VtxBuffer.Data));
+        GL_CALL(glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, idx_offset, (GLsizeiptr)draw_list->IdxBuffer.size_in_bytes(), (const GLvoid*)draw_list->IdxBuffer.Data));
+        vtx_offset += draw_list->VtxBuffer.size_in_bytes();
+        idx_offset += draw_list->IdxBuffer.size_in_bytes();
+    }
+    return true;
+#else
+    IM_UNUSED(vtx_size);
+    IM_UNUSED(idx_size);
+    return false;
+#endif
+}
+
+// GL state modified by RenderDrawData(), saved and restored when no GlStateCache tracks it (the application's renderer may rely on any of it)
+struct ImGui_ImplOpenGL3_StateBackup
+{
+    GLenum      ActiveTexture;
+    GLuint      Program;
+    GLuint      Texture;
+    GLuint      Sampler;
+    GLuint      ArrayBuffer;
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+    GLint       ElementArrayBuffer;
+    ImGui_ImplOpenGL3_VtxAttribState VtxAttribStatePos, VtxAttribStateUV, VtxAttribStateColor;
+#else
+    GLuint      VertexArrayObject;
+#endif
+    GLint       PolygonMode[2];
+    GLint       Viewport[4];
+    GLint       ScissorBox[4];
+    GLenum      BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha;
+    GLenum      BlendEquationRgb, BlendEquationAlpha;
+    GLboolean   EnableBlend, EnableCullFace, EnableDepthTest, EnableStencilTest, EnableScissorTest, EnablePrimitiveRestart;
+
+    void Backup(ImGui_ImplOpenGL3_Data* bd)
+    {
+        glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&ActiveTexture);
+        glActiveTexture(GL_TEXTURE0);
+        glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&Program);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&Texture);
+        Sampler = 0;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330 || bd->GlProfileIsES3) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&Sampler); }
+#endif
+        glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&ArrayBuffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
+        glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &ElementArrayBuffer);
+        VtxAttribStatePos.GetState(bd->AttribLocationVtxPos);
+        VtxAttribStateUV.GetState(bd->AttribLocationVtxUV);
+        VtxAttribStateColor.GetState(bd->AttribLocationVtxColor);
+#else
+        glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&VertexArrayObject);
+#endif
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+        if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, PolygonMode); }
+#endif
+        glGetIntegerv(GL_VIEWPORT, Viewport);
+        glGetIntegerv(GL_SCISSOR_BOX, ScissorBox);
+        glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&BlendSrcRgb);
+        glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&BlendDstRgb);
+        glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&BlendSrcAlpha);
+        glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&BlendDstAlpha);
+        glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&BlendEquationRgb);
+        glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&BlendEquationAlpha);
+        EnableBlend = glIsEnabled(GL_BLEND);
+        EnableCullFace = glIsEnabled(GL_CULL_FACE);
+        EnableDepthTest = glIsEnabled(GL_DEPTH_TEST);
+        EnableStencilTest = glIsEnabled(GL_STENCIL_TEST);
+        EnableScissorTest = glIsEnabled(GL_SCISSOR_TEST);
+        EnablePrimitiveRestart = GL_FALSE;
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        if (!bd->GlProfileIsES3 && bd->GlVersion >= 310) { EnablePrimitiveRestart = glIsEnabled(GL_PRIMITIVE_RESTART); }
+#endif
+    }
+
+    void Restore(ImGui_ImplOpenGL3_Data* bd)
+    {
+        // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
+        if (Program == 0 || glIsProgram(Program)) glUseProgram(Program);
+        glBindTexture(GL_TEXTURE_2D, Texture);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
+        if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
+            glBindSampler(0, Sampler);
+#endif
+        glActiveTexture(ActiveTexture);
+#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindVertexArray(VertexArrayObject);
+#endif
+        glBindBuffer(GL_ARRAY_BUFFER, ArrayBuffer);
+#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ElementArrayBuffer);
+        VtxAttribStatePos.SetState(bd->AttribLocationVtxPos);
+        VtxAttribStateUV.SetState(bd->AttribLocationVtxUV);
+        VtxAttribStateColor.SetState(bd->AttribLocationVtxColor);
+#endif
+        glBlendEquationSeparate(BlendEquationRgb, BlendEquationAlpha);
+        glBlendFuncSeparate(BlendSrcRgb, BlendDstRgb, BlendSrcAlpha, BlendDstAlpha);
+        if (EnableBlend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
+        if (EnableCullFace) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
+        if (EnableDepthTest) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
+        if (EnableStencilTest) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
+        if (EnableScissorTest) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
+        if (!bd->GlProfileIsES3 && bd->GlVersion >= 310) { if (EnablePrimitiveRestart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+#endif
+
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+        // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for front-facing and back-facing faces of polygons
+        if (bd->HasPolygonMode) { if (bd->GlVersion <= 310 || bd->GlProfileIsCompat) { glPolygonMode(GL_FRONT, (GLenum)PolygonMode[0]); glPolygonMode(GL_BACK, (GLenum)PolygonMode[1]); } else { glPolygonMode(GL_FRONT_AND_BACK, (GLenum)PolygonMode[0]); } }
+#endif // IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
+
+        glViewport(Viewport[0], Viewport[1], (GLsizei)Viewport[2], (GLsizei)Viewport[3]);
+        glScissor(ScissorBox[0], ScissorBox[1], (GLsizei)ScissorBox[2], (GLsizei)ScissorBox[3]);
+        (void)bd; // Not all compilation paths use this
+    }
+};
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -531,44 +818,13 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
             if (tex->Status != ImTextureStatus_OK)
                 ImGui_ImplOpenGL3_UpdateTexture(tex);
 
-    // Backup GL state
-    GLenum last_active_texture; glGetIntegerv(GL_ACTIVE_TEXTURE, (GLint*)&last_active_texture);
-    glActiveTexture(GL_TEXTURE0);
-    GLuint last_program; glGetIntegerv(GL_CURRENT_PROGRAM, (GLint*)&last_program);
-    GLuint last_texture; glGetIntegerv(GL_TEXTURE_BINDING_2D, (GLint*)&last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    GLuint last_sampler; if (bd->GlVersion >= 330 || bd->GlProfileIsES3) { glGetIntegerv(GL_SAMPLER_BINDING, (GLint*)&last_sampler); } else { last_sampler = 0; }
-#endif
-    GLuint last_array_buffer; glGetIntegerv(GL_ARRAY_BUFFER_BINDING, (GLint*)&last_array_buffer);
-#ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    // This is part of VAO on OpenGL 3.0+ and OpenGL ES 3.0+.
-    GLint last_element_array_buffer; glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &last_element_array_buffer);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_pos; last_vtx_attrib_state_pos.GetState(bd->AttribLocationVtxPos);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_uv; last_vtx_attrib_state_uv.GetState(bd->AttribLocationVtxUV);
-    ImGui_ImplOpenGL3_VtxAttribState last_vtx_attrib_state_color; last_vtx_attrib_state_color.GetState(bd->AttribLocationVtxColor);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    GLuint last_vertex_array_object; glGetIntegerv(GL_VERTEX_ARRAY_BINDING, (GLint*)&last_vertex_array_object);
-#endif
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    GLint last_polygon_mode[2]; if (bd->HasPolygonMode) { glGetIntegerv(GL_POLYGON_MODE, last_polygon_mode); }
-#endif
-    GLint last_viewport[4]; glGetIntegerv(GL_VIEWPORT, last_viewport);
-    GLint last_scissor_box[4]; glGetIntegerv(GL_SCISSOR_BOX, last_scissor_box);
-    GLenum last_blend_src_rgb; glGetIntegerv(GL_BLEND_SRC_RGB, (GLint*)&last_blend_src_rgb);
-    GLenum last_blend_dst_rgb; glGetIntegerv(GL_BLEND_DST_RGB, (GLint*)&last_blend_dst_rgb);
-    GLenum last_blend_src_alpha; glGetIntegerv(GL_BLEND_SRC_ALPHA, (GLint*)&last_blend_src_alpha);
-    GLenum last_blend_dst_alpha; glGetIntegerv(GL_BLEND_DST_ALPHA, (GLint*)&last_blend_dst_alpha);
-    GLenum last_blend_equation_rgb; glGetIntegerv(GL_BLEND_EQUATION_RGB, (GLint*)&last_blend_equation_rgb);
-    GLenum last_blend_equation_alpha; glGetIntegerv(GL_BLEND_EQUATION_ALPHA, (GLint*)&last_blend_equation_alpha);
-    GLboolean last_enable_blend = glIsEnabled(GL_BLEND);
-    GLboolean last_enable_cull_face = glIsEnabled(GL_CULL_FACE);
-    GLboolean last_enable_depth_test = glIsEnabled(GL_DEPTH_TEST);
-    GLboolean last_enable_stencil_test = glIsEnabled(GL_STENCIL_TEST);
-    GLboolean last_enable_scissor_test = glIsEnabled(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    GLboolean last_enable_primitive_restart = (!bd->GlProfileIsES3 && bd->GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
-#endif
+    // Backup GL state, unless a state cache tracks it for us
+    GlStateCache& state = GlStateCache::current();
+    ImGui_ImplOpenGL3_StateBackup backup;
+    if (!state.enabled())
+        backup.Backup(bd);
+    if (state.activeTexture(GL_TEXTURE0))
+        glActiveTexture(GL_TEXTURE0);
 
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
@@ -579,6 +835,15 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #endif
     ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
 
+    // Upload the whole frame at once where possible, lists are then drawn at their offset within it
+    GLsizeiptr frame_vtx_offset, frame_idx_offset;
+    bool buffers_rebound;
+    const bool frame_upload = ImGui_ImplOpenGL3_UploadDrawData(draw_data, &frame_vtx_offset, &frame_idx_offset, &buffers_rebound);
+    if (buffers_rebound)
+        ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+    int global_vtx_offset = (int)(frame_vtx_offset / (GLsizeiptr)sizeof(ImDrawVert)); // vertices
+    GLsizeiptr global_idx_offset = frame_idx_offset;                                  // bytes
+
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
     ImVec2 clip_scale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
@@ -598,7 +863,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         // - See https://github.com/ocornut/imgui/issues/4468 and please report any corruption issues.
         const GLsizeiptr vtx_buffer_size = (GLsizeiptr)draw_list->VtxBuffer.Size * (int)sizeof(ImDrawVert);
         const GLsizeiptr idx_buffer_size = (GLsizeiptr)draw_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx);
-        if (bd->UseBufferSubData)
+        if (frame_upload)
+        {
+            // Already in the buffers, see ImGui_ImplOpenGL3_UploadDrawData()
+        }
+        else if (bd->UseBufferSubData)
         {
             if (bd->VertexBufferSize < vtx_buffer_size)
             {
@@ -640,62 +909,56 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                     continue;
 
                 // Apply scissor/clipping rectangle (Y is inverted in OpenGL)
-                GL_CALL(glScissor((int)clip_min.x, (int)((float)fb_height - clip_max.y), (int)(clip_max.x - clip_min.x), (int)(clip_max.y - clip_min.y)));
+                const int scissor_x = (int)clip_min.x, scissor_y = (int)((float)fb_height - clip_max.y), scissor_w = (int)(clip_max.x - clip_min.x), scissor_h = (int)(clip_max.y - clip_min.y);
+                if (state.scissor(scissor_x, scissor_y, scissor_w, scissor_h))
+                    GL_CALL(glScissor(scissor_x, scissor_y, scissor_w, scissor_h));
 
                 // Bind texture, Draw
-                GL_CALL(glBindTexture(GL_TEXTURE_2D, (GLuint)(intptr_t)pcmd->GetTexID()));
+                const GLuint tex_id = (GLuint)(intptr_t)pcmd->GetTexID();
+                if (state.bindTexture2D(tex_id))
+                    GL_CALL(glBindTexture(GL_TEXTURE_2D, tex_id));
 #ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_VTX_OFFSET
                 if (bd->GlVersion >= 320)
-                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)pcmd->VtxOffset));
+                    GL_CALL(glDrawElementsBaseVertex(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(global_idx_offset + pcmd->IdxOffset * sizeof(ImDrawIdx)), (GLint)(global_vtx_offset + pcmd->VtxOffset)));
                 else
 #endif
-                GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(pcmd->IdxOffset * sizeof(ImDrawIdx))));
+                GL_CALL(glDrawElements(GL_TRIANGLES, (GLsizei)pcmd->ElemCount, sizeof(ImDrawIdx) == 2 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT, (void*)(intptr_t)(global_idx_offset + pcmd->IdxOffset * sizeof(ImDrawIdx))));
             }
         }
+        if (frame_upload)
+        {
+            global_vtx_offset += draw_list->VtxBuffer.Size;
+            global_idx_offset += draw_list->IdxBuffer.size_in_bytes();
+        }
     }
 
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    // The region can be written again once the GPU is past this frame's draws
+    if (frame_upload && bd->UsePersistentBuffers)
+    {
+        bd->StreamFences[bd->StreamRegion] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        bd->StreamRegion = (bd->StreamRegion + 1) % IMGUI_IMPL_OPENGL_STREAM_REGIONS;
+    }
+#endif
+
     // Destroy the temporary VAO
 #ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
     GL_CALL(glDeleteVertexArrays(1, &vertex_array_object));
+    state.deleteVertexArray(vertex_array_object);
 #endif
 
     // Restore modified GL state
-    // This "glIsProgram()" check is required because if the program is "pending deletion" at the time of binding backup, it will have been deleted by now and will cause an OpenGL error. See #6220.
-    if (last_program == 0 || glIsProgram(last_program)) glUseProgram(last_program);
-    glBindTexture(GL_TEXTURE_2D, last_texture);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BIND_SAMPLER
-    if (bd->GlVersion >= 330 || bd->GlProfileIsES3)
-        glBindSampler(0, last_sampler);
-#endif
-    glActiveTexture(last_active_texture);
-#ifdef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindVertexArray(last_vertex_array_object);
-#endif
-    glBindBuffer(GL_ARRAY_BUFFER, last_array_buffer);
+    if (!state.enabled())
+        backup.Restore(bd);
 #ifndef IMGUI_IMPL_OPENGL_USE_VERTEX_ARRAY
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, last_element_array_buffer);
-    last_vtx_attrib_state_pos.SetState(bd->AttribLocationVtxPos);
-    last_vtx_attrib_state_uv.SetState(bd->AttribLocationVtxUV);
-    last_vtx_attrib_state_color.SetState(bd->AttribLocationVtxColor);
-#endif
-    glBlendEquationSeparate(last_blend_equation_rgb, last_blend_equation_alpha);
-    glBlendFuncSeparate(last_blend_src_rgb, last_blend_dst_rgb, last_blend_src_alpha, last_blend_dst_alpha);
-    if (last_enable_blend) glEnable(GL_BLEND); else glDisable(GL_BLEND);
-    if (last_enable_cull_face) glEnable(GL_CULL_FACE); else glDisable(GL_CULL_FACE);
-    if (last_enable_depth_test) glEnable(GL_DEPTH_TEST); else glDisable(GL_DEPTH_TEST);
-    if (last_enable_stencil_test) glEnable(GL_STENCIL_TEST); else glDisable(GL_STENCIL_TEST);
-    if (last_enable_scissor_test) glEnable(GL_SCISSOR_TEST); else glDisable(GL_SCISSOR_TEST);
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_PRIMITIVE_RESTART
-    if (!bd->GlProfileIsES3 && bd->GlVersion >= 310) { if (last_enable_primitive_restart) glEnable(GL_PRIMITIVE_RESTART); else glDisable(GL_PRIMITIVE_RESTART); }
+    else
+    {
+        // Without a VAO the attribute arrays are global and not tracked by the cache: don't leave ours enabled for the next draw
+        glDisableVertexAttribArray(bd->AttribLocationVtxPos);
+        glDisableVertexAttribArray(bd->AttribLocationVtxUV);
+        glDisableVertexAttribArray(bd->AttribLocationVtxColor);
+    }
 #endif
-
-#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-    // Desktop OpenGL 3.0 and OpenGL 3.1 had separate polygon draw modes for front-facing and back-facing faces of polygons
-    if (bd->HasPolygonMode) { if (bd->GlVersion <= 310 || bd->GlProfileIsCompat) { glPolygonMode(GL_FRONT, (GLenum)last_polygon_mode[0]); glPolygonMode(GL_BACK, (GLenum)last_polygon_mode[1]); } else { glPolygonMode(GL_FRONT_AND_BACK, (GLenum)last_polygon_mode[0]); } }
-#endif // IMGUI_IMPL_OPENGL_MAY_HAVE_POLYGON_MODE
-
-    glViewport(last_viewport[0], last_viewport[1], (GLsizei)last_viewport[2], (GLsizei)last_viewport[3]);
-    glScissor(last_scissor_box[0], last_scissor_box[1], (GLsizei)last_scissor_box[2], (GLsizei)last_scissor_box[3]);
     (void)bd; // Not all compilation paths use this
 }
 
@@ -703,6 +966,7 @@ static void ImGui_ImplOpenGL3_DestroyTexture(ImTextureData* tex)
 {
     GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
     glDeleteTextures(1, &gl_tex_id);
+    GlStateCache::current().deleteTexture(gl_tex_id);
 
     // Clear identifiers and mark as destroyed (in order to allow e.g. calling InvalidateDeviceObjects while running)
     tex->SetTexID(ImTextureID_Invalid);
@@ -722,10 +986,13 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
 
         // Upload texture to graphics system
         // (Bilinear sampling is required by default. Set 'io.Fonts->Flags |= ImFontAtlasFlags_NoBakedLines' or 'style.AntiAliasedLinesUseTex = false' to allow point/nearest sampling)
-        GLint last_texture;
-        GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+        GlStateCache& state = GlStateCache::current();
+        GLint last_texture = 0;
+        if (!state.enabled())
+            GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
         GL_CALL(glGenTextures(1, &gl_texture_id));
-        GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_texture_id));
+        if (state.bindTexture2D(gl_texture_id))
+            GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_texture_id));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR));
         GL_CALL(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE));
@@ -739,18 +1006,22 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         tex->SetTexID((ImTextureID)(intptr_t)gl_texture_id);
         tex->SetStatus(ImTextureStatus_OK);
 
-        // Restore state
-        GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
+        // Restore state (the cache remembers the new binding instead)
+        if (!state.enabled())
+            GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture));
     }
     else if (tex->Status == ImTextureStatus_WantUpdates)
     {
         // Update selected blocks. We only ever write to textures regions which have never been used before!
         // This backend choose to use tex->Updates[] but you can use tex->UpdateRect to upload a single region.
-        GLint last_texture;
-        GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
+        GlStateCache& state = GlStateCache::current();
+        GLint last_texture = 0;
+        if (!state.enabled())
+            GL_CALL(glGetIntegerv(GL_TEXTURE_BINDING_2D, &last_texture));
 
         GLuint gl_tex_id = (GLuint)(intptr_t)tex->TexID;
-        GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
+        if (state.bindTexture2D(gl_tex_id))
+            GL_CALL(glBindTexture(GL_TEXTURE_2D, gl_tex_id));
 #if 0// GL_UNPACK_ROW_LENGTH // Not on WebGL/ES
         GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, tex->Width));
         for (ImTextureRect& r : tex->Updates)
@@ -771,7 +1042,8 @@ void ImGui_ImplOpenGL3_UpdateTexture(ImTextureData* tex)
         }
 #endif
         tex->SetStatus(ImTextureStatus_OK);
-        GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
+        if (!state.enabled())
+            GL_CALL(glBindTexture(GL_TEXTURE_2D, last_texture)); // Restore state
     }
     else if (tex->Status == ImTextureStatus_WantDestroy && tex->UnusedFrames > 0)
         ImGui_ImplOpenGL3_DestroyTexture(tex);
@@ -1016,9 +1288,16 @@ bool    ImGui_ImplOpenGL3_CreateDeviceObjects()
 void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
     ImGui_ImplOpenGL3_Data* bd = ImGui_ImplOpenGL3_GetBackendData();
-    if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); bd->VboHandle = 0; }
+#ifdef IMGUI_IMPL_OPENGL_MAY_HAVE_BUFFER_STORAGE
+    ImGui_ImplOpenGL3_DestroyStreamFences();
+#endif
+    // Deleting a mapped buffer unmaps it; storage is recreated on the next frame
+    bd->MappedVtx = bd->MappedIdx = nullptr;
+    bd->VertexBufferSize = bd->IndexBufferSize = 0;
+    GlStateCache& state = GlStateCache::current();
+    if (bd->VboHandle)      { glDeleteBuffers(1, &bd->VboHandle); state.deleteBuffer(bd->VboHandle); bd->VboHandle = 0; }
     if (bd->ElementsHandle) { glDeleteBuffers(1, &bd->ElementsHandle); bd->ElementsHandle = 0; }
-    if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
+    if (bd->ShaderHandle)   { glDeleteProgram(bd->ShaderHandle); state.deleteProgram(bd->ShaderHandle); bd->ShaderHandle = 0; }
 
     // Destroy all textures
     for (ImTextureData* tex : ImGui::GetPlatformIO().Textures)
@@ -6,7 +6,7 @@
 #include <ctime>     // For time functions
 
 #include "GuiStrings.hpp"
-#include "../Shaders/ShaderConvertor.hpp"
+#include "../Shaders/ShaderRegistry.hpp"
 
 #ifdef __EMSCRIPTEN__
   #include <emscripten.h>
@@ -21,25 +21,6 @@ static std::unique_ptr<EmscriptenPlatform> gPlatform = nullptr;
 static std::unique_ptr<DesktopPlatform> gPlatform = nullptr;
 #endif
 
-#include <Shaders/Shadertoy/Happyjumping.hpp>
-#include <Shaders/Shadertoy/Seascape.hpp>
-#include <Shaders/Shadertoy/Synthwave.hpp>
-#include <Shaders/Shadertoy/Glasscube.hpp>
-#include <Shaders/Shadertoy/Singularity.hpp>
-#include <Shaders/Shadertoy/Fractaltrees.hpp>
-#include <Shaders/Shadertoy/Fireflame.hpp>
-#include <Shaders/Shadertoy/Tunnel.hpp>
-#include <Shaders/Shadertoy/Sunset.hpp>
-#include <Shaders/Shadertoy/Sunset2.hpp>
-#include <Shaders/Shadertoy/Anothercube.hpp>
-#include <Shaders/Shadertoy/Abug.hpp>
-#include <Shaders/Shadertoy/Bluemoonocean.hpp>
-#include <Shaders/Shadertoy/WebGL2Test.hpp>
-#include <Shaders/Shadertoy/Bubbles.hpp>
-#include <Shaders/Shadertoy/Chainy.hpp>
-#include <Shaders/Shadertoy/Dyinguniverse.hpp>
-#include <Shaders/Shadertoy/Phosphor3.hpp>
-
 // Function to initialize the platform
 void initializePlatform () {
 #if defined(__EMSCRIPTEN__)
@@ -53,11 +34,19 @@ void initializePlatform () {
 
 // Function to shut down the platform
 void PlatformManager::shutdown () {
+  JobSystem::shared ().wait (preconvertJobs_);
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
+  if (gpuTimer_) {
+    glDeleteQueries (static_cast<GLsizei> (kTimerQueries), timerQueries_);
+    gpuTimer_ = false;
+  }
+#endif
   if (window_) {
     SDL_DestroyWindow (window_);
     window_ = nullptr;
   }
   if (glContext_) {
+    GlStateCache::makeCurrent (nullptr);
     SDL_GL_DeleteContext (glContext_);
     glContext_ = nullptr;
   }
@@ -109,6 +98,10 @@ void PlatformManager::createOpenGLContext (int swapInterval) {
   SDL_GL_MakeCurrent (window_, glContext_);
   SDL_GL_SetSwapInterval (swapInterval); // Set vsync
 
+  // Fresh context, every value unknown until first set
+  glState_.invalidate ();
+  GlStateCache::makeCurrent (&glState_);
+
   // GLEW initialization only for desktop platforms
 #if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
   if (glewInit () != GLEW_OK) {
@@ -118,113 +111,73 @@ void PlatformManager::createOpenGLContext (int swapInterval) {
 #endif
 }
 
-void PlatformManager::setupShaders () {
-  int currentShader = 4;
-  std::string shaderToUse;
-  switch (currentShader) {
-  case 0:
-    shaderToUse = fragmentShaderToyHappyjumping;
-    break;
-  case 1:
-    shaderToUse = fragmentShaderToySeascape;
-    break;
-  case 2:
-    shaderToUse = fragmentShaderToySynthwave;
-    break;
-  case 3:
-    shaderToUse = fragmentShaderToyGlasscube;
-    break;
-  case 4:
-    shaderToUse = fragmentShaderToySingularity;
-    break;
-  case 5:
-    shaderToUse = fragmentShaderToyFractaltrees;
-    break;
-  case 6:
-    shaderToUse = fragmentShaderToyFireflame;
-    break;
-  case 7:
-    shaderToUse = fragmentShaderToyTunnel;
-    break;
-  case 8:
-    shaderToUse = fragmentShaderToySunset;
-    break;
-  case 9:
-    shaderToUse = fragmentShaderToySunset2;
-    break;
-  case 10:
-    shaderToUse = fragmentShaderToyAnothercube;
-    break;
-  case 11:
-    shaderToUse = fragmentShaderToyAbug;
-    break;
-  case 12:
-    shaderToUse = fragmentShaderToyBluemoonocean;
-    break;
-  case 13:
-    shaderToUse = fragmentShaderToyWebGL2Test;
-    break;
-  case 14:
-    shaderToUse = fragmentShaderToyBubbles;
-    break;
-  case 15:
-    shaderToUse = fragmentShaderToyChainy;
-    break;
-  case 16:
-    shaderToUse = fragmentShaderToyDyingUniverse;
-    break;
-  case 17:
-    shaderToUse = fragmentShaderToyPhosphor3;
-    break;
-
-  default:
-    shaderToUse = fragmentShaderToyHappyjumping;
-    break;
+// quiet: automatic quality switches, which happen in frames that were over budget already; no
+// debug dump and no log lines except errors
+void PlatformManager::setupShaders (bool quiet) {
+  PROFILE_SCOPE ("PlatformManager::setupShaders");
+  const ShaderRegistry& registry = ShaderRegistry::instance ();
+  const ShaderRegistry::Shader* shader = registry.find (shaderName_);
+  if (shader == nullptr) {
+    LOG_E_STREAM << "Shader " << shaderName_ << " is not registered" << std::endl;
+    if (registry.size () == 0) {
+      return;
+    }
+    shader = &registry.at (0);
+    shaderName_ = shader->name ();
   }
 
   // Determine target platform based on OpenGL version
   ShaderTarget target = static_cast<ShaderTarget> (getShaderTarget ());
 
-  // Use ShaderConvertor to convert the ShaderToy code
-  ShaderConvertor convertor;
-  ShaderConversionResult result = convertor.convertFromShaderToy (shaderToUse, target);
+  // Shared with every other user of the registry, converted at build time when possible
+  const ShaderConversionResult& result = shader->conversion (target, shaderQuality_);
 
   if (!result.success) {
     LOG_E_STREAM << "ShaderConvertor failed: " << result.errorMessage << std::endl;
-    // Fall back to basic error shader
-    shaderProgram_ = 0;
     return;
   }
+  preconvertQualities (*shader, target);
+
+  if (!quiet) {
+    LOG_I_STREAM << "Using shader " << shader->name () << " (cost " << shader->cost ()
+                 << (shader->precompiled () ? ", precompiled" : "") << ") - target: "
+                 << static_cast<int> (target) << ", quality "
+                 << ShaderUtils::getShaderQualityString (shaderQuality_) << " ("
+                 << result.qualityScaledBounds << " bounds scaled)" << std::endl;
+    LOG_I_STREAM << "Vertex shader length: " << result.vertexShader.length () << std::endl;
+    LOG_I_STREAM << "Fragment shader length: " << result.fragmentShader.length () << std::endl;
+
+    // Debug: Save converted shaders to files for inspection
+    std::ofstream debugVertFile ("converted_vertex_shader.glsl");
+    if (debugVertFile.is_open ()) {
+      debugVertFile << result.vertexShader;
+      debugVertFile.close ();
+    }
 
-  LOG_I_STREAM << "Using ShaderConvertor - target: " << static_cast<int> (target) << std::endl;
-  LOG_I_STREAM << "Using ShaderConvertor - target: " << static_cast<int> (target) << std::endl;
-  LOG_I_STREAM << "Vertex shader length: " << result.vertexShader.length () << std::endl;
-  LOG_I_STREAM << "Fragment shader length: " << result.fragmentShader.length () << std::endl;
-
-  // Debug: Save converted shaders to files for inspection
-  std::ofstream debugVertFile ("converted_vertex_shader.glsl");
-  if (debugVertFile.is_open ()) {
-    debugVertFile << result.vertexShader;
-    debugVertFile.close ();
-  }
-
-  std::ofstream debugFragFile ("converted_fragment_shader.glsl");
-  if (debugFragFile.is_open ()) {
-    debugFragFile << result.fragmentShader;
-    debugFragFile.close ();
-    LOG_I_STREAM << "Debug: Converted shaders saved to converted_*_shader.glsl" << std::endl;
+    std::ofstream debugFragFile ("converted_fragment_shader.glsl");
+    if (debugFragFile.is_open ()) {
+      debugFragFile << result.fragmentShader;
+      debugFragFile.close ();
+      LOG_I_STREAM << "Debug: Converted shaders saved to converted_*_shader.glsl" << std::endl;
+    }
   }
 
+  PROFILE_SCOPE ("Compile and link");
   GLuint vertexShader = compileShader (result.vertexShader.c_str (), GL_VERTEX_SHADER);
   GLuint fragmentShader = compileShader (result.fragmentShader.c_str (), GL_FRAGMENT_SHADER);
 
-  LOG_I_STREAM << "Vertex shader compilation result: " << (vertexShader != 0 ? "SUCCESS" : "FAILED")
-               << std::endl;
-  LOG_I_STREAM << "Fragment shader compilation result: "
-               << (fragmentShader != 0 ? "SUCCESS" : "FAILED") << std::endl;
+  if (!quiet) {
+    LOG_I_STREAM << "Vertex shader compilation result: "
+                 << (vertexShader != 0 ? "SUCCESS" : "FAILED") << std::endl;
+    LOG_I_STREAM << "Fragment shader compilation result: "
+                 << (fragmentShader != 0 ? "SUCCESS" : "FAILED") << std::endl;
+  }
 
   if (vertexShader == 0) {
     handleError ("Failed to compile vertex shader");
+    if (fragmentShader != 0) {
+      glDeleteShader (fragmentShader);
+    }
     return;
   }
 
@@ -234,30 +187,190 @@ void PlatformManager::setupShaders () {
     return;
   }
 
-  // Create shader program
-  shaderProgram_ = glCreateProgram ();
-  glAttachShader (shaderProgram_, vertexShader);
-  glAttachShader (shaderProgram_, fragmentShader);
-  glLinkProgram (shaderProgram_);
+  // Create shader program; the previous one keeps drawing if this one fails
+  GLuint program = glCreateProgram ();
+  glAttachShader (program, vertexShader);
+  glAttachShader (program, fragmentShader);
+  glLinkProgram (program);
+
+  // Clean up shaders after linking
+  glDeleteShader (vertexShader);
+  glDeleteShader (fragmentShader);
 
   // Check for linking errors
   GLint success;
-  glGetProgramiv (shaderProgram_, GL_LINK_STATUS, &success);
+  glGetProgramiv (program, GL_LINK_STATUS, &success);
   if (!success) {
     GLint logLength;
-    glGetProgramiv (shaderProgram_, GL_INFO_LOG_LENGTH, &logLength);
+    glGetProgramiv (program, GL_INFO_LOG_LENGTH, &logLength);
     std::vector<char> infoLog (logLength);
-    glGetProgramInfoLog (shaderProgram_, logLength, nullptr, infoLog.data ());
+    glGetProgramInfoLog (program, logLength, nullptr, infoLog.data ());
 
     handleError ("Failed to link shader program", infoLog.data ());
-    // IMPORTANT: Don't return here - set shaderProgram_ to 0!
-    shaderProgram_ = 0;
+    glDeleteProgram (program);
     return;
   }
 
-  // Clean up shaders after linking
-  glDeleteShader (vertexShader);
-  glDeleteShader (fragmentShader);
+  if (shaderProgram_ != 0) {
+    glState_.deleteProgram (shaderProgram_);
+    glDeleteProgram (shaderProgram_);
+  }
+  shaderProgram_ = program;
+  backgroundUniforms_.program = 0; // a new program may reuse the old name
+}
+
+void PlatformManager::requestShader (std::string_view name) {
+  const ShaderRegistry::Shader* shader = ShaderRegistry::instance ().find (name);
+  if (shader != nullptr) {
+    requestedShader_.store (shader);
+  }
+}
+
+void PlatformManager::applyRequestedShader () {
+  const ShaderRegistry::Shader* shader = requestedShader_.exchange (nullptr);
+  if (shader != nullptr && shader->name () != shaderName_) {
+    shaderName_ = shader->name ();
+    pendingQuality_.reset (); // a tier of the previous shader
+    if (autoQuality_.load ()) {
+      // Nothing is known about the new shader's cost yet
+      qualityGovernor_.reset ();
+      shaderQuality_ = ShaderQuality::High;
+      activeQuality_.store (static_cast<int> (shaderQuality_));
+    }
+    setupShaders ();
+  }
+
+  const int quality = requestedQuality_.exchange (-1);
+  if (quality >= 0) {
+    qualityGovernor_.reset (static_cast<ShaderQuality> (quality));
+    pendingQuality_.reset ();
+    if (static_cast<ShaderQuality> (quality) != shaderQuality_) {
+      applyQuality (static_cast<ShaderQuality> (quality), false);
+    }
+  }
+}
+
+// The GPU budget is half of a frame at the target rate, the rest is left for ImGui and the
+// compositor. Without timer queries the frame time is all there is: it cannot show headroom,
+// only missed frames, so the tier drops when frames run late and the next one is retried once
+// they are on time again (the governor's backoff keeps such retries rare).
+void PlatformManager::setupQualityGovernor (int targetFramerate) {
+  const float frameMs = 1000.0f / static_cast<float> (targetFramerate);
+  QualityGovernor::Config config;
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
+  gpuTimer_ = GLEW_ARB_timer_query != 0; // core since OpenGL 3.3
+  if (gpuTimer_) {
+    glGenQueries (static_cast<GLsizei> (kTimerQueries), timerQueries_);
+  }
+#endif
+  if (gpuTimer_) {
+    config.budgetMs = frameMs * 0.5f;
+  } else {
+    config.budgetMs = frameMs * 1.25f;
+    config.upshiftRatio = 0.9f;
+    config.holdFrames = 2 * config.windowFrames;
+  }
+  qualityGovernor_ = QualityGovernor (config, shaderQuality_);
+  LOG_I_STREAM << "Shader quality from " << (gpuTimer_ ? "GPU time" : "frame time") << ", budget "
+               << config.budgetMs << " ms" << std::endl;
+}
+
+// Feeds the governor with the newest measurement, before this frame draws
+void PlatformManager::updateQuality (const BackgroundState& state) {
+  if (pendingQuality_ && qualityReady (*pendingQuality_)) {
+    applyQuality (*pendingQuality_, true);
+  }
+
+  float costMs = 0.0f;
+  if (gpuTimer_) {
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
+    if (!timerQueryPending_[timerQuery_]) {
+      return;
+    }
+    const GLuint query = timerQueries_[timerQuery_];
+    GLint available = 0;
+    glGetQueryObjectiv (query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available == 0) {
+      return;
+    }
+    GLuint64 elapsedNs = 0;
+    glGetQueryObjectui64v (query, GL_QUERY_RESULT, &elapsedNs);
+    timerQueryPending_[timerQuery_] = false;
+    costMs = static_cast<float> (static_cast<double> (elapsedNs) / 1e6);
+#endif
+  } else if (state.frameRate > 0.0f) {
+    costMs = 1000.0f / state.frameRate;
+  } else {
+    return;
+  }
+
+  backgroundCostMs_.store (costMs);
+  if (autoQuality_.load () && qualityGovernor_.addSample (costMs)) {
+    LOG_I_STREAM << "Shader quality " << ShaderUtils::getShaderQualityString (shaderQuality_)
+                 << " -> " << ShaderUtils::getShaderQualityString (qualityGovernor_.quality ())
+                 << " (" << qualityGovernor_.averageMs () << " ms, budget "
+                 << qualityGovernor_.config ().budgetMs << " ms)" << std::endl;
+    applyQuality (qualityGovernor_.quality (), true);
+  }
+}
+
+// An automatic switch only compiles a tier that is converted already; until the job system is
+// done with it the current program keeps drawing
+void PlatformManager::applyQuality (ShaderQuality quality, bool automatic) {
+  if (automatic && !qualityReady (quality)) {
+    pendingQuality_ = quality;
+    return;
+  }
+  pendingQuality_.reset ();
+  shaderQuality_ = quality;
+  activeQuality_.store (static_cast<int> (quality));
+  setupShaders (automatic); // the previous program keeps drawing if this tier fails to build
+}
+
+bool PlatformManager::qualityReady (ShaderQuality quality) {
+  const ShaderRegistry::Shader* shader = ShaderRegistry::instance ().find (shaderName_);
+  // Without workers the jobs would only run inside wait (), so converting here is all there is
+  return shader == nullptr || JobSystem::shared ().workerCount () == 0
+         || shader->converted (static_cast<ShaderTarget> (getShaderTarget ()), quality);
+}
+
+// Converts the tiers the governor may switch to on the job system, so a switch on the render
+// thread only compiles and links
+void PlatformManager::preconvertQualities (const ShaderRegistry::Shader& shader,
+                                           ShaderTarget target) {
+  JobSystem& jobs = JobSystem::shared ();
+  if (jobs.workerCount () == 0) {
+    return;
+  }
+  for (std::size_t tier = 0; tier < kShaderQualityCount; ++tier) {
+    const auto quality = static_cast<ShaderQuality> (tier);
+    if (!shader.converted (target, quality)) {
+      // Registry shaders live as long as the process
+      jobs.run ([&shader, target, quality] { shader.conversion (target, quality); },
+                &preconvertJobs_);
+    }
+  }
+}
+
+void PlatformManager::beginBackgroundTiming () {
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
+  // Skipped while the GPU is more than kTimerQueries frames behind
+  if (gpuTimer_ && !timerQueryPending_[timerQuery_]) {
+    glBeginQuery (GL_TIME_ELAPSED, timerQueries_[timerQuery_]);
+    timing_ = true;
+  }
+#endif
+}
+
+void PlatformManager::endBackgroundTiming () {
+#if !defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3)
+  if (timing_) {
+    glEndQuery (GL_TIME_ELAPSED);
+    timerQueryPending_[timerQuery_] = true;
+    timerQuery_ = (timerQuery_ + 1) % kTimerQueries;
+    timing_ = false;
+  }
+#endif
 }
 
 // Compile shader from source code - Returns the shader ID or 0 on failure
@@ -351,12 +464,14 @@ void PlatformManager::setupQuad () {
   // OpenGL ES 3.0+ or desktop OpenGL - VAO is available
   glGenVertexArrays (1, &vao_);
   glBindVertexArray (vao_);
+  glState_.bindVertexArray (vao_);
 #endif
 
   glGenBuffers (1, &vbo_);
   glGenBuffers (1, &ebo_);
 
   glBindBuffer (GL_ARRAY_BUFFER, vbo_);
+  glState_.bindArrayBuffer (vbo_);
   glBufferData (GL_ARRAY_BUFFER, sizeof (vertices), vertices, GL_STATIC_DRAW);
 
   glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, ebo_);
@@ -370,6 +485,7 @@ void PlatformManager::setupQuad () {
     || (!defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3))
   // OpenGL ES 3.0+ or desktop OpenGL - unbind VAO
   glBindVertexArray (0);
+  glState_.bindVertexArray (0);
 #else
   // OpenGL ES 2.0 - disable vertex attributes for now
   glDisableVertexAttribArray (0);
@@ -456,6 +572,10 @@ void PlatformManager::applyStyleLila (ImGuiStyle& style, float alpha) {
   colors[ImGuiCol_ModalWindowDimBg] = ImVec4 (0.05f, 0.02f, 0.12f, 0.40f * alpha);
 }
 
+void PlatformManager::prefetchAssets () {
+  assetLoader_.request (FONT_ASSET, AssetPriority::Prefetch);
+}
+
 // Scale ImGui based on user-defined scale factor
 void PlatformManager::scaleImGui (float userScaleFactor) {
   float scalingFactor = userScaleFactor;
@@ -469,11 +589,25 @@ void PlatformManager::scaleImGui (float userScaleFactor) {
           0x0403, 0x045F, 0x0404, 0x045F, 0x0405, 0x045F, 0x0406, 0x045F, 0x0407, 0x045F,
           0x0408, 0x045F, 0x0409, 0x045F, 0x040A, 0x045F, 0x040B, 0x045F, 0x040C, 0x045F,
           0x040D, 0x045F, 0x040E, 0x045F, 0x040F, 0x045F, 0 };
-  std::filesystem::path fnt = AssetContext::getAssetsPath () / "fonts" / "Comfortaa-Light.otf";
+  if (!fontData_) {
+    try {
+      fontData_ = assetLoader_.load (FONT_ASSET); // usually already prefetched
+    } catch (const std::exception&) {
+      // logged by the loader, fall back to the file path below
+    }
+  }
 
   // Clear and rebuild fonts
   io_->Fonts->Clear ();
-  io_->Fonts->AddFontFromFileTTF (fnt.string ().c_str (), fontSize, &fontCfg, czRanges);
+  if (fontData_ && !fontData_->empty ()) {
+    fontCfg.FontDataOwnedByAtlas = false;
+    io_->Fonts->AddFontFromMemoryTTF (const_cast<char*> (fontData_->data ()),
+                                      static_cast<int> (fontData_->size ()), fontSize, &fontCfg,
+                                      czRanges);
+  } else {
+    std::filesystem::path fnt = AssetContext::getAssetsPath () / FONT_ASSET;
+    io_->Fonts->AddFontFromFileTTF (fnt.string ().c_str (), fontSize, &fontCfg, czRanges);
+  }
   io_->Fonts->Build ();
 
   // Always start scale from default style sizes
@@ -486,23 +620,65 @@ void PlatformManager::scaleImGui (float userScaleFactor) {
 
 // Render the background using the shader program
 void PlatformManager::renderBackground (float totalTime) {
+  renderBackground (
+      BackgroundState{ totalTime, windowWidth_, windowHeight_, ImGui::GetIO ().Framerate });
+}
+
+void PlatformManager::clearFrame (int width, int height) {
+  // The scissor rect of the last ImGui command would clip the clear
+  if (glState_.enable (GlStateCache::Cap::ScissorTest, false)) {
+    glDisable (GL_SCISSOR_TEST);
+  }
+  if (glState_.viewport (0, 0, width, height)) {
+    glViewport (0, 0, width, height);
+  }
+  glClearColor (0.45f, 0.55f, 0.60f, 1.00f);
+  glClear (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+}
+
+void PlatformManager::renderBackground (const BackgroundState& state) {
+  PROFILE_SCOPE ("PlatformManager::renderBackground");
+  applyRequestedShader ();
+  updateQuality (state);
+  const float totalTime = state.totalTime;
   if (shaderProgram_ == 0) {
     return; // No shader program available
   }
 
-  GLboolean depthTestEnabled;
-  glGetBooleanv (GL_DEPTH_TEST, &depthTestEnabled);
-  glDisable (GL_DEPTH_TEST);
+  // Full-screen quad over whatever the ImGui backend left behind: it no longer restores state
+  // when the cache is active, so everything the draw depends on is set here
+  GlStateCache& gl = glState_;
+  if (gl.enable (GlStateCache::Cap::DepthTest, false)) {
+    glDisable (GL_DEPTH_TEST);
+  }
+  if (gl.enable (GlStateCache::Cap::Blend, false)) {
+    glDisable (GL_BLEND);
+  }
+  if (gl.enable (GlStateCache::Cap::ScissorTest, false)) {
+    glDisable (GL_SCISSOR_TEST);
+  }
+  if (gl.enable (GlStateCache::Cap::CullFace, false)) {
+    glDisable (GL_CULL_FACE);
+  }
+  if (gl.viewport (0, 0, state.width, state.height)) {
+    glViewport (0, 0, state.width, state.height);
+  }
 
-  glUseProgram (shaderProgram_);
+  if (gl.useProgram (shaderProgram_)) {
+    glUseProgram (shaderProgram_);
+  }
 
 #if defined(IMGUI_IMPL_OPENGL_ES3) \
     || (!defined(IMGUI_IMPL_OPENGL_ES2) && !defined(IMGUI_IMPL_OPENGL_ES3))
   // WebGL 2.0 / OpenGL ES 3.0 or Desktop OpenGL - VAO is available
-  glBindVertexArray (vao_);
+  if (gl.bindVertexArray (vao_)) {
+    glBindVertexArray (vao_);
+  }
 #else
   // WebGL 1.0 / OpenGL ES 2.0 - VAO not available, bind buffers manually
-  glBindBuffer (GL_ARRAY_BUFFER, vbo_);
+  if (gl.bindArrayBuffer (vbo_)) {
+    glBindBuffer (GL_ARRAY_BUFFER, vbo_);
+  }
   glBindBuffer (GL_ELEMENT_ARRAY_BUFFER, ebo_);
   glEnableVertexAttribArray (0);
   glVertexAttribPointer (0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof (float), (void*)0);
@@ -519,19 +695,37 @@ void PlatformManager::renderBackground (float totalTime) {
   // uniform samplerXX iChannel0..3;          // input channel. XX = 2D/Cube
   // uniform vec4      iDate;                 // (year, month, day, time in seconds)
 
-  GLint iResolutionLoc = glGetUniformLocation (shaderProgram_, "iResolution");
-  GLint iTimeLoc = glGetUniformLocation (shaderProgram_, "iTime");
-  GLint iTimeDeltaLoc = glGetUniformLocation (shaderProgram_, "iTimeDelta");
-  GLint iFrameRateLoc = glGetUniformLocation (shaderProgram_, "iFrameRate");
-  GLint iFrameLoc = glGetUniformLocation (shaderProgram_, "iFrame");
-  GLint iChannelTimeLoc = glGetUniformLocation (shaderProgram_, "iChannelTime");
-  GLint iChannelResolutionLoc = glGetUniformLocation (shaderProgram_, "iChannelResolution");
-  GLint iMouseLoc = glGetUniformLocation (shaderProgram_, "iMouse");
-  GLint iDateLoc = glGetUniformLocation (shaderProgram_, "iDate");
-  GLint iChannel0Loc = glGetUniformLocation (shaderProgram_, "iChannel0");
-  GLint iChannel1Loc = glGetUniformLocation (shaderProgram_, "iChannel1");
-  GLint iChannel2Loc = glGetUniformLocation (shaderProgram_, "iChannel2");
-  GLint iChannel3Loc = glGetUniformLocation (shaderProgram_, "iChannel3");
+  // Looked up once per linked program, not every frame
+  BackgroundUniforms& uniforms = backgroundUniforms_;
+  if (uniforms.program != shaderProgram_) {
+    uniforms.program = shaderProgram_;
+    uniforms.resolution = glGetUniformLocation (shaderProgram_, "iResolution");
+    uniforms.time = glGetUniformLocation (shaderProgram_, "iTime");
+    uniforms.timeDelta = glGetUniformLocation (shaderProgram_, "iTimeDelta");
+    uniforms.frameRate = glGetUniformLocation (shaderProgram_, "iFrameRate");
+    uniforms.frame = glGetUniformLocation (shaderProgram_, "iFrame");
+    uniforms.channelTime = glGetUniformLocation (shaderProgram_, "iChannelTime");
+    uniforms.channelResolution = glGetUniformLocation (shaderProgram_, "iChannelResolution");
+    uniforms.mouse = glGetUniformLocation (shaderProgram_, "iMouse");
+    uniforms.date = glGetUniformLocation (shaderProgram_, "iDate");
+    uniforms.channel[0] = glGetUniformLocation (shaderProgram_, "iChannel0");
+    uniforms.channel[1] = glGetUniformLocation (shaderProgram_, "iChannel1");
+    uniforms.channel[2] = glGetUniformLocation (shaderProgram_, "iChannel2");
+    uniforms.channel[3] = glGetUniformLocation (shaderProgram_, "iChannel3");
+  }
+  const GLint iResolutionLoc = uniforms.resolution;
+  const GLint iTimeLoc = uniforms.time;
+  const GLint iTimeDeltaLoc = uniforms.timeDelta;
+  const GLint iFrameRateLoc = uniforms.frameRate;
+  const GLint iFrameLoc = uniforms.frame;
+  const GLint iChannelTimeLoc = uniforms.channelTime;
+  const GLint iChannelResolutionLoc = uniforms.channelResolution;
+  const GLint iMouseLoc = uniforms.mouse;
+  const GLint iDateLoc = uniforms.date;
+  const GLint iChannel0Loc = uniforms.channel[0];
+  const GLint iChannel1Loc = uniforms.channel[1];
+  const GLint iChannel2Loc = uniforms.channel[2];
+  const GLint iChannel3Loc = uniforms.channel[3];
 
   // ⚡ PERFORMANCE: Statické proměnné pro frame counter
   static int frameCount = 0;
@@ -542,20 +736,24 @@ void PlatformManager::renderBackground (float totalTime) {
   Uint32 currentFrameTime = SDL_GetTicks ();
   if (lastFrameTime > 0) {
     lastDeltaTime = (currentFrameTime - lastFrameTime) / 1000.0f;
+    if (lastDeltaTime > 0.1f) {
+      LOG_W_RATE (1.0, 3, "Background frame hitch: {} ms", currentFrameTime - lastFrameTime);
+    }
     // Clamp delta time to reasonable values to prevent large jumps
     lastDeltaTime = std::min (lastDeltaTime, 0.1f);
   }
   lastFrameTime = currentFrameTime;
   frameCount++;
+  LOG_D_EVERY_MS (5000, "Background frame {} dt {:.2f} ms", frameCount, lastDeltaTime * 1000.0f);
 
   if (iResolutionLoc != -1)
-    glUniform3f (iResolutionLoc, (float)windowWidth_, (float)windowHeight_, 1.0f);
+    glUniform3f (iResolutionLoc, (float)state.width, (float)state.height, 1.0f);
   if (iTimeLoc != -1)
     glUniform1f (iTimeLoc, totalTime);
   if (iTimeDeltaLoc != -1)
     glUniform1f (iTimeDeltaLoc, lastDeltaTime);
   if (iFrameRateLoc != -1)
-    glUniform1f (iFrameRateLoc, ImGui::GetIO ().Framerate);
+    glUniform1f (iFrameRateLoc, state.frameRate);
   if (iFrameLoc != -1)
     glUniform1i (iFrameLoc, frameCount);
   // iChannelTime[4]
@@ -565,10 +763,10 @@ void PlatformManager::renderBackground (float totalTime) {
   }
   // iChannelResolution[4]
   if (iChannelResolutionLoc != -1) {
-    float channelRes[12] = { (float)windowWidth_, (float)windowHeight_, 1.0f,
-                             (float)windowWidth_, (float)windowHeight_, 1.0f,
-                             (float)windowWidth_, (float)windowHeight_, 1.0f,
-                             (float)windowWidth_, (float)windowHeight_, 1.0f };
+    float channelRes[12] = { (float)state.width, (float)state.height, 1.0f,
+                             (float)state.width, (float)state.height, 1.0f,
+                             (float)state.width, (float)state.height, 1.0f,
+                             (float)state.width, (float)state.height, 1.0f };
     glUniform3fv (iChannelResolutionLoc, 4, channelRes);
   }
   // iMouse
@@ -592,16 +790,14 @@ void PlatformManager::renderBackground (float totalTime) {
   if (iChannel3Loc != -1)
     glUniform1i (iChannel3Loc, 0);
 
+  beginBackgroundTiming ();
   glDrawElements (GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
+  endBackgroundTiming ();
 
 #if defined(IMGUI_IMPL_OPENGL_ES2)
   // OpenGL ES 2.0 - cleanup manually bound attributes
   glDisableVertexAttribArray (0);
 #endif
-
-  if (depthTestEnabled) {
-    glEnable (GL_DEPTH_TEST);
-  }
 }
 
 // Get the content for the overlay window
@@ -620,6 +816,14 @@ std::string PlatformManager::getOverlayContent () {
   oC += fmt::format ("Base Font Size: {:.2f}\n", BASE_FONT_SIZE);
   oC += fmt::format ("Font Size: {:.2f}\n", io_->FontGlobalScale * BASE_FONT_SIZE);
 
+  const auto images = TextureLoader::imageCache ().stats ();
+  oC += fmt::format ("Image Cache: {} hits, {} misses, {} evictions\n", images.hits,
+                     images.misses, images.evictions);
+  oC += fmt::format ("  {} images, {:.1f} / {:.0f} MB\n", images.entries,
+                     images.bytesResident / 1048576.0, images.bytesBudget / 1048576.0);
+  oC += fmt::format ("GL State: {} calls issued, {} skipped\n", glState_.issued (),
+                     glState_.skipped ());
+
   return oC;
 }
 
@@ -642,6 +846,12 @@ void PlatformManager::printOverlayWindow () {
                                  | ImGuiWindowFlags_NoFocusOnAppearing | ImGuiWindowFlags_NoNav;
   ImGui::Begin ("Overlay", &showOverlay, windowFlags);
   ImGui::Text ("%s", cachedOverlayContent.c_str ());
+  if (ImGui::CollapsingHeader ("Frame timings", ImGuiTreeNodeFlags_DefaultOpen)) {
+    printFrameTimings ();
+  }
+  if (ImGui::CollapsingHeader ("Shader")) {
+    printShaderSelector ();
+  }
 
   // Add separator and test button
   // ImGui::Separator ();
@@ -656,6 +866,116 @@ void PlatformManager::printOverlayWindow () {
   ImGui::PopID ();
 }
 
+// Every registered shader; the pick is compiled by the thread that renders on its next frame
+void PlatformManager::printShaderSelector () {
+  const ShaderRegistry& registry = ShaderRegistry::instance ();
+  if (selectedShader_ == nullptr) {
+    selectedShader_ = registry.find (shaderName_); // no switch requested yet, nothing races
+  }
+  const char* preview = selectedShader_ != nullptr ? selectedShader_->name ().c_str () : "-";
+  if (ImGui::BeginCombo ("##shader", preview)) {
+    for (std::size_t i = 0; i < registry.size (); ++i) {
+      const ShaderRegistry::Shader& shader = registry.at (i);
+      if (ImGui::Selectable (shader.name ().c_str (), &shader == selectedShader_)) {
+        selectedShader_ = &shader;
+        requestShader (shader.name ());
+      }
+      if (ImGui::IsItemHovered ()) {
+        ImGui::SetTooltip ("Cost %d, %zu channels%s", shader.cost (), shader.channels ().size (),
+                           shader.precompiled () ? ", precompiled" : "");
+      }
+    }
+    ImGui::EndCombo ();
+  }
+  if (selectedShader_ != nullptr) {
+    ImGui::Text ("Cost %d, %zu channels%s", selectedShader_->cost (),
+                 selectedShader_->channels ().size (),
+                 selectedShader_->precompiled () ? ", precompiled" : "");
+  }
+
+  bool autoQuality = autoQuality_.load ();
+  if (ImGui::Checkbox ("Automatic quality", &autoQuality)) {
+    autoQuality_.store (autoQuality);
+  }
+  int quality = activeQuality_.load ();
+  if (autoQuality) {
+    ImGui::Text ("Quality %s, %s %.2f ms",
+                 ShaderUtils::getShaderQualityString (static_cast<ShaderQuality> (quality)),
+                 gpuTimer_ ? "background" : "frame", backgroundCostMs_.load ());
+  } else if (ImGui::Combo ("Quality", &quality, "Low\0Medium\0High\0")) {
+    requestedQuality_.store (quality);
+  }
+}
+
+// Stacked stage times of the last frames (newest on the right) with frame time percentiles.
+// Redrawn every frame from frameTimings_, nothing is allocated here.
+void PlatformManager::printFrameTimings () {
+  static const ImU32 kStageColors[FrameTimings::kStages]
+      = { IM_COL32 (102, 194, 165, 255), IM_COL32 (252, 141, 98, 255),
+          IM_COL32 (141, 160, 203, 255), IM_COL32 (231, 138, 195, 255),
+          IM_COL32 (166, 216, 84, 140) };
+  const FrameTimings::Stats stats = frameTimings_.stats ();
+  ImGui::Text ("p50 %.1f  p95 %.1f  p99 %.1f  max %.1f ms", stats.p50, stats.p95, stats.p99,
+               stats.max);
+
+  const float fontSize = ImGui::GetFontSize ();
+  const ImVec2 size (fontSize * 20.0f, fontSize * 5.0f);
+  const ImVec2 origin = ImGui::GetCursorScreenPos ();
+  const float bottom = origin.y + size.y;
+  ImGui::InvisibleButton ("##frameGraph", size);
+
+  // Scale to the slowest frame, at least the 30 FPS budget
+  const float topMs = std::max (stats.max, 1000.0f / 30.0f) * 1.1f;
+  const float pixelsPerMs = size.y / topMs;
+  const float barWidth = size.x / static_cast<float> (FrameTimings::kCapacity);
+  const std::size_t count = frameTimings_.size ();
+  const float firstX = origin.x + static_cast<float> (FrameTimings::kCapacity - count) * barWidth;
+
+  ImDrawList* drawList = ImGui::GetWindowDrawList ();
+  drawList->AddRectFilled (origin, ImVec2 (origin.x + size.x, bottom), IM_COL32 (0, 0, 0, 96));
+  for (std::size_t i = 0; i < count; ++i) {
+    const FrameTimings::Sample& sample = frameTimings_.sample (i);
+    const float x = firstX + static_cast<float> (i) * barWidth;
+    float y = bottom;
+    for (std::size_t stage = 0; stage < FrameTimings::kStages; ++stage) {
+      const float height = sample.stageMs[stage] * pixelsPerMs;
+      drawList->AddRectFilled (ImVec2 (x, y - height), ImVec2 (x + barWidth, y),
+                               kStageColors[stage]);
+      y -= height;
+    }
+  }
+  for (const float fps : { 60.0f, 30.0f }) {
+    const float y = bottom - 1000.0f / fps * pixelsPerMs;
+    drawList->AddLine (ImVec2 (origin.x, y), ImVec2 (origin.x + size.x, y),
+                       IM_COL32 (255, 255, 255, 80));
+  }
+
+  // Breakdown of the frame under the mouse
+  if (ImGui::IsItemHovered () && count > 0) {
+    const float offset = (ImGui::GetIO ().MousePos.x - firstX) / barWidth;
+    if (offset >= 0.0f && offset < static_cast<float> (count)) {
+      const FrameTimings::Sample& sample = frameTimings_.sample (static_cast<std::size_t> (offset));
+      ImGui::BeginTooltip ();
+      ImGui::Text ("Frame %.2f ms", sample.totalMs);
+      for (std::size_t stage = 0; stage < FrameTimings::kStages; ++stage) {
+        ImGui::Text ("%-13s %.2f ms", FrameTimings::stageName (static_cast<FrameStage> (stage)),
+                     sample.stageMs[stage]);
+      }
+      ImGui::EndTooltip ();
+    }
+  }
+
+  // Legend with averages over the ring
+  for (std::size_t stage = 0; stage < FrameTimings::kStages; ++stage) {
+    ImGui::ColorButton (FrameTimings::stageName (static_cast<FrameStage> (stage)),
+                        ImGui::ColorConvertU32ToFloat4 (kStageColors[stage]),
+                        ImGuiColorEditFlags_NoTooltip, ImVec2 (fontSize * 0.8f, fontSize * 0.8f));
+    ImGui::SameLine ();
+    ImGui::Text ("%-13s %5.2f ms", FrameTimings::stageName (static_cast<FrameStage> (stage)),
+                 stats.stageAverageMs[stage]);
+  }
+}
+
 // Initialize input handler callbacks
 void PlatformManager::initInputHandlerCallbacks () {
   inputHandler.setScaleCallback ([&] (float scaleFactor) {
@@ -745,27 +1065,8 @@ int PlatformManager::getShaderTarget () {
 void PlatformManager::testAllShaderConversions () {
   LOG_I_STREAM << "Starting shader conversion test for all available shaders..." << std::endl;
 
-  // Define all available shaders with their names
-  struct ShaderInfo {
-    std::string name;
-    std::string shaderSource;
-  };
-
-  std::vector<ShaderInfo> shaders = { { "Happyjumping", fragmentShaderToyHappyjumping },
-                                      { "Seascape", fragmentShaderToySeascape },
-                                      { "Synthwave", fragmentShaderToySynthwave },
-                                      { "Glasscube", fragmentShaderToyGlasscube },
-                                      { "Singularity", fragmentShaderToySingularity },
-                                      { "Fractaltrees", fragmentShaderToyFractaltrees },
-                                      { "Fireflame", fragmentShaderToyFireflame },
-                                      { "Tunnel", fragmentShaderToyTunnel },
-                                      { "Sunset", fragmentShaderToySunset },
-                                      { "Sunset2", fragmentShaderToySunset2 },
-                                      { "Anothercube", fragmentShaderToyAnothercube },
-                                      { "Abug", fragmentShaderToyAbug },
-                                      { "Bluemoonocean", fragmentShaderToyBluemoonocean },
-                                      { "WebGL2Test", fragmentShaderToyWebGL2Test },
-                                      { "Bubbles", fragmentShaderToyBubbles } };
+  // Every registered shader, conversions shared with the rest of the application
+  const ShaderRegistry& registry = ShaderRegistry::instance ();
 
   // Define all target platforms
   std::vector<std::pair<ShaderTarget, std::string> > targets
@@ -774,31 +1075,32 @@ void PlatformManager::testAllShaderConversions () {
           { ShaderTarget::Desktop330, "Desktop330" },
           { ShaderTarget::Desktop420, "Desktop420" } };
 
-  ShaderConvertor convertor;
   int totalTests = 0;
   int successfulTests = 0;
 
   // Test each shader with each target
-  for (const auto& shader : shaders) {
-    LOG_I_STREAM << "Testing shader: " << shader.name << std::endl;
+  for (std::size_t index = 0; index < registry.size (); ++index) {
+    const ShaderRegistry::Shader& shader = registry.at (index);
+    LOG_I_STREAM << "Testing shader: " << shader.name () << std::endl;
 
     for (const auto& target : targets) {
       totalTests++;
-      std::string filename = "test_" + shader.name + "_" + target.second + ".glsl";
+      std::string filename = "test_" + shader.name () + "_" + target.second + ".glsl";
 
       LOG_I_STREAM << "  Converting to " << target.second << "..." << std::endl;
 
-      ShaderConversionResult result
-          = convertor.convertFromShaderToy (shader.shaderSource, target.first);
+      const ShaderConversionResult& result = shader.conversion (target.first);
 
       if (result.success) {
         successfulTests++;
 
         // Save vertex shader
-        std::string vertexFilename = "test_" + shader.name + "_" + target.second + "_vertex.glsl";
+        std::string vertexFilename
+            = "test_" + shader.name () + "_" + target.second + "_vertex.glsl";
         std::ofstream vertexFile (vertexFilename);
         if (vertexFile.is_open ()) {
-          vertexFile << "// Vertex shader for " << shader.name << " (" << target.second << ")\n";
+          vertexFile << "// Vertex shader for " << shader.name () << " (" << target.second
+                     << ")\n";
           vertexFile << "// Generated by ShaderConvertor test\n\n";
           vertexFile << result.vertexShader;
           vertexFile.close ();
@@ -806,10 +1108,10 @@ void PlatformManager::testAllShaderConversions () {
 
         // Save fragment shader
         std::string fragmentFilename
-            = "test_" + shader.name + "_" + target.second + "_fragment.glsl";
+            = "test_" + shader.name () + "_" + target.second + "_fragment.glsl";
         std::ofstream fragmentFile (fragmentFilename);
         if (fragmentFile.is_open ()) {
-          fragmentFile << "// Fragment shader for " << shader.name << " (" << target.second
+          fragmentFile << "// Fragment shader for " << shader.name () << " (" << target.second
                        << ")\n";
           fragmentFile << "// Generated by ShaderConvertor test\n\n";
           fragmentFile << result.fragmentShader;
@@ -817,21 +1119,22 @@ void PlatformManager::testAllShaderConversions () {
         }
 
         // Save conversion report
-        std::string reportFilename = "test_" + shader.name + "_" + target.second + "_report.txt";
+        std::string reportFilename
+            = "test_" + shader.name () + "_" + target.second + "_report.txt";
         std::ofstream reportFile (reportFilename);
         if (reportFile.is_open ()) {
           reportFile << "Shader Conversion Report\n";
           reportFile << "=======================\n";
-          reportFile << "Shader Name: " << shader.name << "\n";
+          reportFile << "Shader Name: " << shader.name () << "\n";
           reportFile << "Target Platform: " << target.second << "\n";
           reportFile << "Conversion Status: SUCCESS\n";
-          reportFile << "Original Shader Length: " << shader.shaderSource.length () << " chars\n";
+          reportFile << "Original Shader Length: " << shader.source ().length () << " chars\n";
           reportFile << "Converted Vertex Shader Length: " << result.vertexShader.length ()
                      << " chars\n";
           reportFile << "Converted Fragment Shader Length: " << result.fragmentShader.length ()
                      << " chars\n";
           reportFile << "\n--- Original ShaderToy Source ---\n";
-          reportFile << shader.shaderSource;
+          reportFile << shader.source ();
           reportFile.close ();
         }
 
@@ -841,22 +1144,23 @@ void PlatformManager::testAllShaderConversions () {
         LOG_E_STREAM << "    ❌ FAILED - " << result.errorMessage << std::endl;
 
         // Save error report
-        std::string errorFilename = "test_" + shader.name + "_" + target.second + "_ERROR.txt";
+        std::string errorFilename
+            = "test_" + shader.name () + "_" + target.second + "_ERROR.txt";
         std::ofstream errorFile (errorFilename);
         if (errorFile.is_open ()) {
           errorFile << "Shader Conversion Error Report\n";
           errorFile << "==============================\n";
-          errorFile << "Shader Name: " << shader.name << "\n";
+          errorFile << "Shader Name: " << shader.name () << "\n";
           errorFile << "Target Platform: " << target.second << "\n";
           errorFile << "Conversion Status: FAILED\n";
           errorFile << "Error Message: " << result.errorMessage << "\n";
           errorFile << "\n--- Original ShaderToy Source ---\n";
-          errorFile << shader.shaderSource;
+          errorFile << shader.source ();
           errorFile.close ();
         }
       }
     }
-    LOG_I_STREAM << "Completed shader: " << shader.name << std::endl;
+    LOG_I_STREAM << "Completed shader: " << shader.name () << std::endl;
   }
 
   // Final summary
@@ -2,17 +2,31 @@
 #define __PLATFORMMANAGER_H__
 
 #include <Assets/AssetContext.hpp>
+#include <Assets/AssetLoader.hpp>
 #include <Logger/Logger.hpp>
+#include <Shaders/ShaderRegistry.hpp>
 #include <Utils/Utils.hpp>
+#include <Utils/JobSystem.hpp>
+#include <Utils/Profiler.hpp>
+#include "FrameTimings.hpp"
+#include "GlStateCache.hpp"
+#include "QualityGovernor.hpp"
 #include "TextureTools.hpp"
 #include "InputHandler.hpp"
 
 #include <SDL.h>
+#include <atomic>
+#include <optional>
+#include <string>
+#include <string_view>
 #include <SDL_image.h>
 
-#include "bindings/imgui_impl_opengl3.h"
+#include "ImGuiOpenGL3Backend.h"
 #include "bindings/imgui_impl_sdl2.h"
 #include "imgui.h"
+#ifndef IMGUI_IMPL_OPENGL3_GLSTATECACHE
+  #error "the stock imgui_impl_opengl3 backend bypasses GlStateCache, use Gui/ImGuiOpenGL3Backend.h"
+#endif
 
 #if defined(IMGUI_IMPL_OPENGL_ES2) || defined(IMGUI_IMPL_OPENGL_ES3)
   #include <SDL_opengles2.h>
@@ -33,9 +47,19 @@
 #define DEFAULT_SCALING_FACTOR_EMSCRIPTEN (float)1.0f
 #define FALLBACK_DEVICE_PIXEL_RATIO (float)1.0f
 #define BASE_FONT_SIZE (float)16.0f
+#define FONT_ASSET "fonts/Comfortaa-Light.otf"
 
 void initializePlatform ();
 
+// Everything renderBackground reads from the UI side, captured per frame so the background can
+// also be drawn on a render thread
+struct BackgroundState {
+  float totalTime = 0.0f;
+  int width = 0;
+  int height = 0;
+  float frameRate = 0.0f;
+};
+
 class PlatformManager {
 
 public:
@@ -59,7 +83,54 @@ protected:
   InputHandler inputHandler;
   SDL_GLContext glContext_ = nullptr;
   SDL_Window* window_ = nullptr;
-  GLuint vao_, vbo_, ebo_, shaderProgram_;
+  GLuint vao_, vbo_, ebo_, shaderProgram_ = 0;
+
+  // Background shader by registry name. shaderName_ belongs to the thread that renders; the UI
+  // asks for another one through requestShader, applied before the next background draw.
+  std::string shaderName_ = "Singularity";
+  std::atomic<const ShaderRegistry::Shader*> requestedShader_{ nullptr };
+  const ShaderRegistry::Shader* selectedShader_ = nullptr; // UI side
+
+  // Quality tier of the background shader, render side like shaderName_. With automatic quality
+  // qualityGovernor_ picks it from the GPU time of the background draw (timer queries, desktop
+  // GL) or, without timer queries, from the frame time. The UI reads and requests through the
+  // atomics. The other tiers are converted on the job system (preconvertJobs_) while the shader
+  // runs; a tier picked before its conversion is done waits in pendingQuality_.
+  ShaderQuality shaderQuality_ = ShaderQuality::High;
+  QualityGovernor qualityGovernor_;
+  std::optional<ShaderQuality> pendingQuality_;
+  JobSystem::Counter preconvertJobs_;
+  bool gpuTimer_ = false; // set before rendering starts
+  std::atomic<bool> autoQuality_{ true };
+  std::atomic<int> requestedQuality_{ -1 }; // a ShaderQuality, -1 for none
+  std::atomic<int> activeQuality_{ static_cast<int> (ShaderQuality::High) };
+  std::atomic<float> backgroundCostMs_{ 0.0f }; // last sample given to the governor
+
+  // Results arrive a few frames late; a query is reused only once its result has been read
+  static constexpr std::size_t kTimerQueries = 4;
+  GLuint timerQueries_[kTimerQueries] = {};
+  bool timerQueryPending_[kTimerQueries] = {};
+  std::size_t timerQuery_ = 0;
+  bool timing_ = false;
+
+  // Shadow of this context's GL state, current while the context exists. Used on whichever
+  // thread renders (the render thread in threaded mode), like the context itself.
+  GlStateCache glState_;
+
+  // Uniform locations of shaderProgram_, looked up again when the program changes
+  struct BackgroundUniforms {
+    GLuint program = 0;
+    GLint resolution = -1;
+    GLint time = -1;
+    GLint timeDelta = -1;
+    GLint frameRate = -1;
+    GLint frame = -1;
+    GLint channelTime = -1;
+    GLint channelResolution = -1;
+    GLint mouse = -1;
+    GLint date = -1;
+    GLint channel[4] = { -1, -1, -1, -1 };
+  } backgroundUniforms_;
 
 private:
   ImGuiContext* imguiContext_ = nullptr;
@@ -69,6 +140,13 @@ public:
 
   ImGuiStyle defaultStyle_, style_;
 
+  // Font file kept alive for the atlas (not owned by ImGui), loaded once and reused on rescale
+  AssetLoader::Asset fontData_;
+  AssetLoader assetLoader_;
+
+  // Stage times of the last frames, marked by mainLoop and drawn in the overlay
+  FrameTimings frameTimings_;
+
   const char* glsl_version_ = "#version 130"; // Default GLSL version
 
 public:
@@ -81,7 +159,16 @@ protected:
 protected:
   void createSDL2Window (const char* title, int width, int height);
   void createOpenGLContext (int swapInterval);
-  void setupShaders ();
+  void setupShaders (bool quiet = false);
+  void requestShader (std::string_view name);
+  void applyRequestedShader ();
+  void setupQualityGovernor (int targetFramerate);
+  void updateQuality (const BackgroundState& state);
+  void applyQuality (ShaderQuality quality, bool automatic);
+  bool qualityReady (ShaderQuality quality);
+  void preconvertQualities (const ShaderRegistry::Shader& shader, ShaderTarget target);
+  void beginBackgroundTiming ();
+  void endBackgroundTiming ();
   GLuint compileShader (const char* shaderSource, GLenum shaderType);
   void decideOpenGLVersion ();
   virtual int getShaderTarget ();
@@ -94,12 +181,17 @@ protected:
   void buildImguiContent ();
 
   void scaleImGui (float userScaleFactor = 1.0f);
+  void prefetchAssets (); // overlaps asset I/O with window and GL context creation
 
   // Debug/testing functions
   void testAllShaderConversions (); // Test all shaders and save to files
-  void renderBackground (float deltaTime);
+  void clearFrame (int width, int height);
+  void renderBackground (float totalTime);
+  void renderBackground (const BackgroundState& state);
   std::string getOverlayContent ();
   void printOverlayWindow ();
+  void printFrameTimings ();
+  void printShaderSelector ();
   void initInputHandlerCallbacks (); // TODO
   void handleSDLError (const char* message) const;
   void handleGLError (const char* message) const;
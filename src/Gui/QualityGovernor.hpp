@@ -0,0 +1,133 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Background shader quality tier picked from measured frame cost, with hysteresis
+
+#ifndef __QUALITYGOVERNOR_H__
+#define __QUALITYGOVERNOR_H__
+
+#include <Shaders/ShaderConvertor.hpp>
+
+#include <algorithm>
+#include <cstddef>
+
+// Fed one cost sample per frame (GPU time of the background, or the frame time where the GPU
+// cannot be timed) and judged against a budget once per window of frames:
+//  - a window whose mean is over the budget drops one tier,
+//  - upshift windows in a row under upshiftRatio * budget raise one tier; the next tier costs
+//    about twice as much (ShaderQuality halves the steps), so it has to fit with room to spare,
+//  - between the two thresholds the tier stays,
+//  - the first holdFrames samples after a switch are ignored (compile, caches warming up),
+//  - an upshift undone within kBounceWindows doubles the calm windows needed before the next one
+//    (up to maxUpshiftWindows), so a shader on the edge of the budget settles instead of flapping.
+// Plain arithmetic without clocks or GL; what a sample measures is up to the caller.
+class QualityGovernor {
+public:
+  struct Config {
+    float budgetMs = 8.0f;     // half of a 60 Hz frame for the background
+    float upshiftRatio = 0.4f; // of the budget, below it the next tier is tried
+    std::size_t windowFrames = 30;
+    std::size_t holdFrames = 30;
+    std::size_t upshiftWindows = 2;
+    std::size_t maxUpshiftWindows = 32;
+  };
+
+  static constexpr std::size_t kBounceWindows = 4;
+
+  QualityGovernor () : QualityGovernor (Config ()) {
+  }
+
+  explicit QualityGovernor (Config config, ShaderQuality quality = ShaderQuality::High)
+      : config_ (config), quality_ (quality), upshiftWindows_ (config.upshiftWindows) {
+  }
+
+  ShaderQuality quality () const {
+    return quality_;
+  }
+
+  const Config& config () const {
+    return config_;
+  }
+
+  // Mean of the last complete window, 0 before the first one
+  float averageMs () const {
+    return averageMs_;
+  }
+
+  // Calm windows currently needed to raise the tier
+  std::size_t upshiftWindows () const {
+    return upshiftWindows_;
+  }
+
+  // True when this sample changed the tier
+  bool addSample (float ms) {
+    if (hold_ > 0) {
+      --hold_;
+      return false;
+    }
+    sumMs_ += ms;
+    if (++frames_ < config_.windowFrames) {
+      return false;
+    }
+    averageMs_ = sumMs_ / static_cast<float> (frames_);
+    sumMs_ = 0.0f;
+    frames_ = 0;
+    ++windowsSinceSwitch_;
+
+    if (averageMs_ > config_.budgetMs) {
+      calmWindows_ = 0;
+      if (quality_ == ShaderQuality::Low) {
+        return false;
+      }
+      if (lastSwitchUp_ && windowsSinceSwitch_ <= kBounceWindows) {
+        upshiftWindows_ = std::min (upshiftWindows_ * 2, config_.maxUpshiftWindows);
+      }
+      return shift (-1);
+    }
+    if (averageMs_ < config_.budgetMs * config_.upshiftRatio && quality_ != ShaderQuality::High) {
+      if (++calmWindows_ >= upshiftWindows_) {
+        return shift (1);
+      }
+      return false;
+    }
+    calmWindows_ = 0;
+    return false;
+  }
+
+  // Another shader: its cost is unknown, start over at the given tier with the initial patience
+  void reset (ShaderQuality quality = ShaderQuality::High) {
+    quality_ = quality;
+    upshiftWindows_ = config_.upshiftWindows;
+    lastSwitchUp_ = false;
+    averageMs_ = 0.0f;
+    restart ();
+  }
+
+private:
+  bool shift (int direction) {
+    quality_ = static_cast<ShaderQuality> (static_cast<int> (quality_) + direction);
+    lastSwitchUp_ = direction > 0;
+    restart ();
+    return true;
+  }
+
+  void restart () {
+    sumMs_ = 0.0f;
+    frames_ = 0;
+    calmWindows_ = 0;
+    windowsSinceSwitch_ = 0;
+    hold_ = config_.holdFrames;
+  }
+
+  Config config_;
+  ShaderQuality quality_;
+  std::size_t upshiftWindows_;
+  std::size_t calmWindows_ = 0;
+  std::size_t windowsSinceSwitch_ = 0;
+  std::size_t hold_ = 0;
+  std::size_t frames_ = 0;
+  float sumMs_ = 0.0f;
+  float averageMs_ = 0.0f;
+  bool lastSwitchUp_ = false;
+};
+
+#endif // __QUALITYGOVERNOR_H__
@@ -1,76 +1,405 @@
 #ifndef __TEXTURETOOLS_H__
 #define __TEXTURETOOLS_H__
 
+#include <Assets/AssetCache.hpp>
 #include <Assets/AssetContext.hpp>
+#include <Assets/AssetPack.hpp>
+#include <Assets/ImageDecoder.hpp>
+#include <Assets/Ktx2.hpp>
 #include <Logger/Logger.hpp>
 #include <Utils/Utils.hpp>
+#include "GlStateCache.hpp"
 #include <SDL.h>
-//#define STB_IMAGE_IMPLEMENTATION
-#include <stb_image.h>
+#include <algorithm>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
+#if defined(IMGUI_IMPL_OPENGL_ES2) || defined(IMGUI_IMPL_OPENGL_ES3)
+  #include <SDL_opengles2.h>
+#else
+  #include <GL/glew.h>
+#endif
+
 namespace TextureLoader {
-  inline bool LoadTextureFromMemory (const void* data, size_t data_size, SDL_Renderer* renderer,
-                                     SDL_Texture** out_texture, int* out_width, int* out_height) {
-    int image_width = 0, image_height = 0, channels = 0;
-    unsigned char* image_data = stbi_load_from_memory (static_cast<const unsigned char*> (data),
-                                                       static_cast<int> (data_size), &image_width,
-                                                       &image_height, &channels, 4);
-    if (!image_data) {
-      LOG_E_FMT ("Failed to load image from memory: %s", stbi_failure_reason ());
-      return false;
+  // Decode parameters, part of the cache key
+  struct DecodeParams {
+    int channels = 4;            // 1..4, 0 keeps the channel count of the file
+    bool flipVertically = false; // GL expects the first row at the bottom
+
+    std::string key () const {
+      return fmt::format ("c{}{}", channels, flipVertically ? "f" : "");
     }
 
-    SDL_Surface* surface
-        = SDL_CreateRGBSurfaceFrom (image_data, image_width, image_height, 32, 4 * image_width,
-                                    0x000000ff, 0x0000ff00, 0x00ff0000, 0xff000000);
-    if (!surface) {
-      LOG_E_FMT ("Failed to create SDL surface: %s", SDL_GetError ());
-      stbi_image_free (image_data);
-      return false;
+    ImageDecodeJob job (const void* data, size_t data_size) const {
+      return ImageDecodeJob{ data, data_size, channels, flipVertically };
     }
+  };
+
+  // Pooled, 64-byte aligned pixels, tightly packed rows
+  using DecodedImage = DecodedPixels;
+  using ImageHandle = AssetCache<DecodedImage>::Handle;
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface (renderer, surface);
+  // Decoded images shared by every texture upload, 256 MB of CPU memory by default
+  inline AssetCache<DecodedImage>& imageCache () {
+    static AssetCache<DecodedImage> cache (std::size_t{ 256 } << 20);
+    return cache;
+  }
+
+  // Uncached, on the calling thread, nullptr on failure
+  inline std::shared_ptr<DecodedImage> DecodeImageFromMemory (const void* data, size_t data_size,
+                                                              const DecodeParams& params = {}) {
+    auto image = std::make_shared<DecodedImage> (ImageDecoder::decode (params.job (data, data_size)));
+    if (!image->ok ()) {
+      LOG_E_FMT ("Failed to decode image: {}", image->error);
+      return nullptr;
+    }
+    return image;
+  }
+
+  // RGBA pixels go straight into a static texture, no intermediate SDL_Surface
+  inline bool CreateTextureFromImage (const DecodedImage& image, SDL_Renderer* renderer,
+                                      SDL_Texture** out_texture, int* out_width, int* out_height) {
+    if (image.channels != 4) {
+      LOG_E_FMT ("SDL texture needs RGBA pixels, got {} channels", image.channels);
+      return false;
+    }
+    SDL_Texture* texture = SDL_CreateTexture (renderer, SDL_PIXELFORMAT_RGBA32,
+                                              SDL_TEXTUREACCESS_STATIC, image.width, image.height);
     if (!texture) {
-      LOG_E_FMT ("Failed to create SDL texture: %s", SDL_GetError ());
-      SDL_FreeSurface (surface);
-      stbi_image_free (image_data);
+      LOG_E_FMT ("Failed to create SDL texture: {}", SDL_GetError ());
       return false;
     }
+    if (SDL_UpdateTexture (texture, nullptr, image.pixels.data (), 4 * image.width) != 0) {
+      LOG_E_FMT ("Failed to upload SDL texture: {}", SDL_GetError ());
+      SDL_DestroyTexture (texture);
+      return false;
+    }
+    SDL_SetTextureBlendMode (texture, SDL_BLENDMODE_BLEND);
 
     *out_texture = texture;
-    *out_width = image_width;
-    *out_height = image_height;
-
-    SDL_FreeSurface (surface);
-    stbi_image_free (image_data);
+    *out_width = image.width;
+    *out_height = image.height;
     return true;
   }
 
+  inline bool LoadTextureFromMemory (const void* data, size_t data_size, SDL_Renderer* renderer,
+                                     SDL_Texture** out_texture, int* out_width, int* out_height) {
+    std::shared_ptr<DecodedImage> image = DecodeImageFromMemory (data, data_size);
+    return image && CreateTextureFromImage (*image, renderer, out_texture, out_width, out_height);
+  }
+
   inline bool LoadTextureFromFile (const std::filesystem::path& file_path, SDL_Renderer* renderer,
                                    SDL_Texture** out_texture, int* out_width, int* out_height) {
-    std::ifstream file (file_path, std::ios::binary | std::ios::ate);
-    if (!file) {
-      LOG_E_FMT ("Failed to open file: %s", file_path.string ().c_str ());
+    // Decode straight from the mapping, no intermediate buffer
+    DotNameUtils::FileIO::MappedFile file;
+    try {
+      file = DotNameUtils::FileIO::MappedFile (file_path);
+    } catch (const std::exception& e) {
+      LOG_E_FMT ("Failed to open file: {}", e.what ());
       return false;
     }
-    std::streamsize file_size = file.tellg ();
-    if (file_size <= 0) {
-      LOG_E_FMT ("File is empty or error reading file: %s", file_path.string ().c_str ());
+    if (file.empty ()) {
+      LOG_E_FMT ("File is empty or error reading file: {}", file_path.string ());
       return false;
     }
-    file.seekg (0, std::ios::beg);
 
-    std::vector<unsigned char> buffer (static_cast<size_t> (file_size));
-    if (!file.read (reinterpret_cast<char*> (buffer.data ()), file_size)) {
-      LOG_E_FMT ("Failed to read file: %s", file_path.string ().c_str ());
-      return false;
+    return LoadTextureFromMemory (file.data (), file.size (), renderer, out_texture, out_width,
+                                  out_height);
+  }
+
+  inline bool IsKtx2Name (std::string_view name) {
+    return name.size () >= Ktx2::kExtension.size ()
+           && name.substr (name.size () - Ktx2::kExtension.size ()) == Ktx2::kExtension;
+  }
+
+  // "textures/noise.png" -> "textures/noise.ktx2", as written by the ktx2 converter
+  inline std::string Ktx2VariantName (std::string_view name) {
+    if (IsKtx2Name (name)) {
+      return std::string (name);
+    }
+    const std::size_t slash = name.rfind ('/');
+    const std::size_t dot = name.rfind ('.');
+    const std::size_t stem = dot != std::string_view::npos
+                                     && (slash == std::string_view::npos || dot > slash)
+                                 ? dot
+                                 : name.size ();
+    return std::string (name.substr (0, stem)) + std::string (Ktx2::kExtension);
+  }
+
+  // CPU transcode of the top level to RGBA, for SDL textures and GL contexts without the format
+  inline DecodedImage DecodeKtx2Texture (const Ktx2::Texture& texture,
+                                         const DecodeParams& params = {}) {
+    DecodedImage image;
+    const Ktx2::Level& level = texture.levels.front ();
+    const std::size_t rowBytes = static_cast<std::size_t> (level.width) * 4;
+    image.pixels = PixelBufferPool::shared ().acquire (rowBytes * level.height);
+    BlockCompression::decompress (texture.format, level.data, level.width, level.height,
+                                  image.pixels.data ());
+    if (texture.flippedVertically != params.flipVertically) {
+      std::vector<unsigned char> row (rowBytes);
+      for (int y = 0; y < level.height / 2; ++y) {
+        unsigned char* top = image.pixels.data () + y * rowBytes;
+        unsigned char* bottom = image.pixels.data () + (level.height - 1 - y) * rowBytes;
+        std::memcpy (row.data (), top, rowBytes);
+        std::memcpy (top, bottom, rowBytes);
+        std::memcpy (bottom, row.data (), rowBytes);
+      }
     }
+    image.width = level.width;
+    image.height = level.height;
+    image.channels = 4;
+    return image;
+  }
 
-    return LoadTextureFromMemory (buffer.data (), buffer.size (), renderer, out_texture, out_width,
-                                  out_height);
+  // Cached decode of a batch of assets; the misses are decoded in parallel on the shared
+  // ImageDecoder. Entries are nullptr for assets that failed to load or decode.
+  inline std::vector<ImageHandle> DecodeImageAssets (const std::vector<std::string>& names,
+                                                     const DecodeParams& params = {}) {
+    std::vector<ImageHandle> images (names.size ());
+    std::vector<std::size_t> missing;
+    std::vector<AssetContext::AssetBlob> encoded;
+    std::vector<ImageDecodeJob> jobs;
+    for (std::size_t i = 0; i < names.size (); ++i) {
+      images[i] = imageCache ().find (AssetCache<DecodedImage>::makeKey (names[i], params.key ()));
+      if (images[i]) {
+        continue;
+      }
+      std::optional<AssetContext::AssetBlob> asset = AssetContext::tryOpenAsset (names[i]);
+      if (!asset || asset->empty ()) {
+        LOG_E_FMT ("Asset not found or empty: {}", names[i]);
+        continue;
+      }
+      if (IsKtx2Name (names[i])) {
+        Ktx2::Texture texture;
+        std::string error;
+        if (!Ktx2::parse (asset->data (), asset->size (), texture, &error)) {
+          LOG_E_FMT ("Failed to decode {}: {}", names[i], error);
+          continue;
+        }
+        auto image = std::make_shared<const DecodedImage> (DecodeKtx2Texture (texture, params));
+        const std::size_t bytes = image->pixels.size ();
+        images[i] = imageCache ().insert (
+            AssetCache<DecodedImage>::makeKey (names[i], params.key ()), std::move (image), bytes);
+        continue;
+      }
+      missing.push_back (i);
+      encoded.push_back (std::move (*asset));
+    }
+    for (const AssetContext::AssetBlob& asset : encoded) {
+      jobs.push_back (params.job (asset.data (), asset.size ()));
+    }
+
+    std::vector<DecodedPixels> decoded = ImageDecoder::shared ().decodeBatch (jobs);
+    for (std::size_t j = 0; j < decoded.size (); ++j) {
+      const std::string& name = names[missing[j]];
+      if (!decoded[j].ok ()) {
+        LOG_E_FMT ("Failed to decode {}: {}", name, decoded[j].error);
+        continue;
+      }
+      const std::size_t bytes = decoded[j].pixels.size ();
+      images[missing[j]] = imageCache ().insert (
+          AssetCache<DecodedImage>::makeKey (name, params.key ()),
+          std::make_shared<const DecodedImage> (std::move (decoded[j])), bytes);
+    }
+    return images;
+  }
+
+  // Decoded once per (asset, params), later calls are cache hits
+  inline ImageHandle DecodeImageAsset (std::string_view name, const DecodeParams& params = {}) {
+    return DecodeImageAssets ({ std::string (name) }, params).front ();
+  }
+
+  // Asset name relative to the asset directory, resolved through assets.pack first and decoded
+  // through the image cache
+  inline bool LoadTextureFromAsset (std::string_view name, SDL_Renderer* renderer,
+                                    SDL_Texture** out_texture, int* out_width, int* out_height) {
+    ImageHandle image = DecodeImageAsset (name);
+    return image && CreateTextureFromImage (*image, renderer, out_texture, out_width, out_height);
+  }
+
+  // GL texture object, deleted with the last handle (needs the GL context to be current)
+  struct GlTexture {
+    GLuint id = 0;
+    int width = 0;
+    int height = 0;
+    std::size_t gpuBytes = 0; // every uploaded level
+    bool compressed = false;
+
+    GlTexture () = default;
+    GlTexture (const GlTexture&) = delete;
+    GlTexture& operator= (const GlTexture&) = delete;
+    ~GlTexture () {
+      if (id != 0) {
+        glDeleteTextures (1, &id);
+        GlStateCache::current ().deleteTexture (id);
+      }
+    }
+
+    std::size_t bytes () const {
+      return gpuBytes;
+    }
+  };
+
+  using TextureHandle = AssetCache<GlTexture>::Handle;
+
+  inline std::shared_ptr<GlTexture> UploadGlTexture (const DecodedImage& image) {
+    if (image.channels != 3 && image.channels != 4) {
+      LOG_E_FMT ("GL upload needs RGB or RGBA pixels, got {} channels", image.channels);
+      return nullptr;
+    }
+    auto texture = std::make_shared<GlTexture> ();
+    texture->width = image.width;
+    texture->height = image.height;
+    texture->gpuBytes = static_cast<std::size_t> (image.width) * image.height * 4; // RGB as RGBA
+    const GLenum format = image.channels == 4 ? GL_RGBA : GL_RGB;
+
+    GlStateCache& state = GlStateCache::current ();
+    glGenTextures (1, &texture->id);
+    if (state.bindTexture2D (texture->id)) {
+      glBindTexture (GL_TEXTURE_2D, texture->id);
+    }
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D (GL_TEXTURE_2D, 0, static_cast<GLint> (format), image.width, image.height, 0,
+                  format, GL_UNSIGNED_BYTE, image.pixels.data ());
+    glPixelStorei (GL_UNPACK_ALIGNMENT, 4);
+    if (state.bindTexture2D (0)) {
+      glBindTexture (GL_TEXTURE_2D, 0);
+    }
+    return texture;
+  }
+
+  // Compressed formats the current context samples natively, queried once (needs a current
+  // context). ETC2 is core in GL ES 3.0 / WebGL 2, BC1/BC3 come with the S3TC extensions.
+  inline bool IsCompressedFormatSupported (BlockCompression::Format format, bool srgb) {
+    static const std::vector<GLint> supported = [] {
+      GLint count = 0;
+      glGetIntegerv (GL_NUM_COMPRESSED_TEXTURE_FORMATS, &count);
+      std::vector<GLint> formats (static_cast<std::size_t> (std::max (count, 0)));
+      if (!formats.empty ()) {
+        glGetIntegerv (GL_COMPRESSED_TEXTURE_FORMATS, formats.data ());
+      }
+      return formats;
+    }();
+    const auto wanted = static_cast<GLint> (BlockCompression::glInternalFormat (format, srgb));
+    return std::find (supported.begin (), supported.end (), wanted) != supported.end ();
+  }
+
+  // Every level straight from the file with glCompressedTexImage2D when the context knows the
+  // format, otherwise the top level transcoded to RGBA on the CPU
+  inline std::shared_ptr<GlTexture> UploadKtx2Texture (const Ktx2::Texture& source,
+                                                       const DecodeParams& params = {}) {
+    if (!IsCompressedFormatSupported (source.format, source.srgb)
+        || source.flippedVertically != params.flipVertically) {
+      return UploadGlTexture (DecodeKtx2Texture (source, params));
+    }
+    auto texture = std::make_shared<GlTexture> ();
+    texture->width = source.width;
+    texture->height = source.height;
+    texture->gpuBytes = source.bytes ();
+    texture->compressed = true;
+    const GLenum format = BlockCompression::glInternalFormat (source.format, source.srgb);
+    const bool mipmapped = source.levels.size () > 1;
+
+    GlStateCache& state = GlStateCache::current ();
+    glGenTextures (1, &texture->id);
+    if (state.bindTexture2D (texture->id)) {
+      glBindTexture (GL_TEXTURE_2D, texture->id);
+    }
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER,
+                     mipmapped ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+#ifdef GL_TEXTURE_MAX_LEVEL
+    glTexParameteri (GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL,
+                     static_cast<GLint> (source.levels.size ()) - 1);
+#endif
+    for (std::size_t i = 0; i < source.levels.size (); ++i) {
+      const Ktx2::Level& level = source.levels[i];
+      glCompressedTexImage2D (GL_TEXTURE_2D, static_cast<GLint> (i), format, level.width,
+                              level.height, 0, static_cast<GLsizei> (level.size), level.data);
+    }
+    if (state.bindTexture2D (0)) {
+      glBindTexture (GL_TEXTURE_2D, 0);
+    }
+    return texture;
+  }
+
+  // The asset's .ktx2 variant (or the asset itself when it is one), nullptr when there is none or
+  // its orientation does not match and the original can be decoded instead
+  inline std::shared_ptr<GlTexture> UploadKtx2Variant (std::string_view name,
+                                                       const DecodeParams& params) {
+    const std::string variant = Ktx2VariantName (name);
+    std::optional<AssetContext::AssetBlob> asset = AssetContext::tryOpenAsset (variant);
+    if (!asset || asset->empty ()) {
+      return nullptr;
+    }
+    Ktx2::Texture texture;
+    std::string error;
+    if (!Ktx2::parse (asset->data (), asset->size (), texture, &error)) {
+      LOG_E_FMT ("Failed to load {}: {}", variant, error);
+      return nullptr;
+    }
+    if (texture.flippedVertically != params.flipVertically && !IsKtx2Name (name)) {
+      return nullptr; // transcoding and flipping costs more than decoding the original
+    }
+    return UploadKtx2Texture (texture, params);
+  }
+
+  // Decodes through the image cache and uploads once per (asset, params); users of the same
+  // texture share the handle. The caller owns the cache and clears it while its GL context is
+  // still current. The misses of a batch (e.g. a shader's four channels) are
+  // decoded in parallel, uploads happen on the calling (GL) thread. 1 and 2 channel requests are
+  // decoded as RGBA. A pre-compressed "<name>.ktx2" next to the asset is preferred over decoding.
+  inline std::vector<TextureHandle> AcquireGlTextures (AssetCache<GlTexture>& cache,
+                                                       const std::vector<std::string>& names,
+                                                       DecodeParams params = {}) {
+    if (params.channels != 3) {
+      params.channels = 4;
+    }
+    std::vector<TextureHandle> textures (names.size ());
+    std::vector<std::size_t> missing;
+    std::vector<std::string> missingNames;
+    for (std::size_t i = 0; i < names.size (); ++i) {
+      const std::string key = AssetCache<GlTexture>::makeKey (names[i], params.key ());
+      textures[i] = cache.find (key);
+      if (textures[i]) {
+        continue;
+      }
+      if (std::shared_ptr<GlTexture> compressed = UploadKtx2Variant (names[i], params)) {
+        const std::size_t bytes = compressed->bytes ();
+        textures[i] = cache.insert (key, std::move (compressed), bytes);
+        continue;
+      }
+      missing.push_back (i);
+      missingNames.push_back (names[i]);
+    }
+
+    std::vector<ImageHandle> images = DecodeImageAssets (missingNames, params);
+    for (std::size_t j = 0; j < images.size (); ++j) {
+      std::shared_ptr<GlTexture> texture = images[j] ? UploadGlTexture (*images[j]) : nullptr;
+      if (texture) {
+        const std::size_t bytes = texture->bytes ();
+        textures[missing[j]] = cache.insert (
+            AssetCache<GlTexture>::makeKey (missingNames[j], params.key ()), std::move (texture),
+            bytes);
+      }
+    }
+    return textures;
+  }
+
+  inline TextureHandle AcquireGlTexture (AssetCache<GlTexture>& cache, std::string_view name,
+                                         const DecodeParams& params = {}) {
+    return AcquireGlTextures (cache, { std::string (name) }, params).front ();
   }
 } // namespace TextureLoader
-#endif // __TEXTURETOOLS_H__
\ No newline at end of file
+#endif // __TEXTURETOOLS_H__
@@ -0,0 +1,276 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Flight recorder: last N log lines in a preallocated ring, dumped from a crash signal handler
+
+#ifndef LOGFLIGHTRECORDER_HPP
+#define LOGFLIGHTRECORDER_HPP
+
+#include "LogRecord.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+  #define LOG_FLIGHT_RECORDER_SIGNALS 1
+  #include <csignal>
+  #include <fcntl.h>
+  #include <signal.h>
+  #include <unistd.h>
+#endif
+
+// Records are rendered into fixed-size slots on the producer thread, before they are queued or
+// written, so a crash loses nothing that was already logged - not even records still waiting in
+// the async shards. Slots are claimed with one fetch_add and published with a per-slot sequence
+// (seqlock), the crash handler only reads slots whose sequence is complete.
+//
+// The crash handler uses nothing but open/write/close/sigaction/raise (async-signal-safe), dumps
+// the ring to the crash file and stderr, then re-raises the signal with the previous handler.
+// It runs on a per-thread alternate stack so a stack overflow still reaches it; every thread gets
+// one the first time it records a line. A thread that overflows its stack before it ever logged
+// dies without the dump.
+// Signals are POSIX only; on Windows and Emscripten the ring is kept but no handler is installed.
+class LogFlightRecorder {
+public:
+  static constexpr std::size_t kSlotBytes = 240; // longer lines are truncated
+
+  explicit LogFlightRecorder (std::size_t capacity, const std::string& crashFile)
+      : capacity_ (capacity > 0 ? capacity : 1), slots_ (new Slot[capacity_]) {
+    const std::size_t length = std::min (crashFile.size (), sizeof (crashFile_) - 1);
+    std::memcpy (crashFile_, crashFile.data (), length);
+    crashFile_[length] = '\0';
+  }
+
+  ~LogFlightRecorder () {
+    uninstallCrashHandlers ();
+  }
+
+  LogFlightRecorder (const LogFlightRecorder&) = delete;
+  LogFlightRecorder& operator= (const LogFlightRecorder&) = delete;
+
+  std::size_t capacity () const {
+    return capacity_;
+  }
+
+  // Producer side, any thread
+  void record (const LogRecord& record) {
+    ensureThreadAltStack ();
+    const std::uint64_t index = next_.fetch_add (1, std::memory_order_relaxed);
+    Slot& slot = slots_[index % capacity_];
+    slot.sequence.store (index * 2 + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_release);
+
+    auto result = fmt::format_to_n (slot.text, kSlotBytes - 1, "[{}] [{}] [{}] {}",
+                                    LogClock::format (record.timeNs),
+                                    logLevelToString (record.level), record.caller,
+                                    record.message);
+    std::size_t length = std::min<std::size_t> (result.size, kSlotBytes - 1);
+    for (const LogField& field : record.fields) {
+      if (length >= kSlotBytes - 1) {
+        break;
+      }
+      auto fieldResult = std::visit (
+          [&] (const auto& value) {
+            return fmt::format_to_n (slot.text + length, kSlotBytes - 1 - length, " {}={}",
+                                     field.key, value);
+          },
+          field.value);
+      length = std::min<std::size_t> (length + fieldResult.size, kSlotBytes - 1);
+    }
+    slot.text[length] = '\n';
+    slot.length.store (static_cast<std::uint32_t> (length + 1), std::memory_order_relaxed);
+
+    slot.sequence.store (index * 2 + 2, std::memory_order_release);
+  }
+
+  // Complete lines, oldest first. Not for use from a signal handler.
+  std::vector<std::string> snapshot () const {
+    std::vector<std::string> lines;
+    forEachLine ([&] (const char* text, std::size_t length) { lines.emplace_back (text, length); });
+    return lines;
+  }
+
+#ifdef LOG_FLIGHT_RECORDER_SIGNALS
+  // Async-signal-safe
+  void dump (int fd, int signal) const {
+    writeAll (fd, "=== flight recorder: last log records before signal ");
+    char number[16];
+    std::size_t digits = 0;
+    unsigned value = static_cast<unsigned> (signal);
+    do {
+      number[sizeof (number) - 1 - digits++] = static_cast<char> ('0' + value % 10);
+      value /= 10;
+    } while (value != 0 && digits < sizeof (number));
+    writeAll (fd, number + sizeof (number) - digits, digits);
+    writeAll (fd, " ===\n");
+    forEachLine ([&] (const char* text, std::size_t length) { writeAll (fd, text, length); });
+    writeAll (fd, "=== end of flight recorder ===\n");
+  }
+#endif
+
+  // SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL. Only one recorder can own the handlers.
+  bool installCrashHandlers () {
+#ifdef LOG_FLIGHT_RECORDER_SIGNALS
+    LogFlightRecorder* expected = nullptr;
+    if (!active ().compare_exchange_strong (expected, this)) {
+      return expected == this;
+    }
+
+    ensureThreadAltStack ();
+    struct sigaction action{};
+    action.sa_handler = &LogFlightRecorder::onCrashSignal;
+    sigemptyset (&action.sa_mask);
+    action.sa_flags = SA_ONSTACK;
+    for (std::size_t i = 0; i < kSignalCount; ++i) {
+      sigaction (kSignals[i], &action, &previous_[i]);
+    }
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void uninstallCrashHandlers () {
+#ifdef LOG_FLIGHT_RECORDER_SIGNALS
+    LogFlightRecorder* expected = this;
+    if (!active ().compare_exchange_strong (expected, nullptr)) {
+      return;
+    }
+    for (std::size_t i = 0; i < kSignalCount; ++i) {
+      sigaction (kSignals[i], &previous_[i], nullptr);
+    }
+#endif
+  }
+
+private:
+  struct Slot {
+    std::atomic<std::uint64_t> sequence{ 0 }; // odd while being written, 2 * index + 2 when done
+    std::atomic<std::uint32_t> length{ 0 };
+    char text[kSlotBytes];
+  };
+
+  // Seqlock read: copy the slot, then check that no writer claimed it in the meantime; a line
+  // overwritten during the copy is dropped, never handed out torn
+  template <typename Fn> void forEachLine (Fn&& fn) const {
+    char line[kSlotBytes];
+    const std::uint64_t end = next_.load (std::memory_order_acquire);
+    const std::uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+    for (std::uint64_t index = begin; index < end; ++index) {
+      const Slot& slot = slots_[index % capacity_];
+      const std::uint64_t done = index * 2 + 2;
+      if (slot.sequence.load (std::memory_order_acquire) != done) {
+        continue; // still being written or already overwritten
+      }
+      const std::size_t length
+          = std::min<std::size_t> (slot.length.load (std::memory_order_relaxed), kSlotBytes);
+      std::memcpy (line, slot.text, length);
+      std::atomic_thread_fence (std::memory_order_acquire);
+      if (slot.sequence.load (std::memory_order_relaxed) != done) {
+        continue;
+      }
+      fn (static_cast<const char*> (line), length);
+    }
+  }
+
+  // Gives the calling thread its own signal stack, unless it has one already (ours or the
+  // application's). Checked once per thread; the stack is released when the thread exits.
+  static void ensureThreadAltStack () {
+#ifdef LOG_FLIGHT_RECORDER_SIGNALS
+    struct ThreadStack {
+      bool checked = false;
+      std::unique_ptr<char[]> memory;
+
+      ~ThreadStack () {
+        if (memory) {
+          stack_t disable{};
+          disable.ss_flags = SS_DISABLE;
+          sigaltstack (&disable, nullptr);
+        }
+      }
+    };
+    static thread_local ThreadStack thread;
+    if (thread.checked) {
+      return;
+    }
+    thread.checked = true;
+    stack_t current{};
+    if (sigaltstack (nullptr, &current) != 0 || (current.ss_flags & SS_DISABLE) == 0) {
+      return;
+    }
+    thread.memory.reset (new char[kAltStackBytes]);
+    stack_t stack{};
+    stack.ss_sp = thread.memory.get ();
+    stack.ss_size = kAltStackBytes;
+    if (sigaltstack (&stack, nullptr) != 0) {
+      thread.memory.reset ();
+    }
+#endif
+  }
+
+#ifdef LOG_FLIGHT_RECORDER_SIGNALS
+  static constexpr std::size_t kAltStackBytes = 64 * 1024;
+  static constexpr std::size_t kSignalCount = 5;
+  static constexpr int kSignals[kSignalCount] = { SIGSEGV, SIGABRT, SIGBUS, SIGFPE, SIGILL };
+
+  static std::atomic<LogFlightRecorder*>& active () {
+    static std::atomic<LogFlightRecorder*> recorder{ nullptr };
+    return recorder;
+  }
+
+  static void writeAll (int fd, const char* text, std::size_t length) {
+    while (length > 0) {
+      const ssize_t written = ::write (fd, text, length);
+      if (written <= 0) {
+        return;
+      }
+      text += written;
+      length -= static_cast<std::size_t> (written);
+    }
+  }
+
+  static void writeAll (int fd, const char* text) {
+    writeAll (fd, text, std::strlen (text));
+  }
+
+  static void onCrashSignal (int signal) {
+    static std::atomic<bool> dumping{ false };
+    LogFlightRecorder* self = active ().load (std::memory_order_acquire);
+    if (self != nullptr && !dumping.exchange (true)) {
+      const int fd = ::open (self->crashFile_, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+      if (fd >= 0) {
+        self->dump (fd, signal);
+        ::close (fd);
+      }
+      self->dump (STDERR_FILENO, signal);
+    }
+
+    // Hand over to whoever was installed before us (default: terminate + core dump)
+    for (std::size_t i = 0; self != nullptr && i < kSignalCount; ++i) {
+      if (kSignals[i] == signal) {
+        sigaction (signal, &self->previous_[i], nullptr);
+      }
+    }
+    if (self == nullptr) {
+      ::signal (signal, SIG_DFL);
+    }
+    ::raise (signal);
+  }
+
+  struct sigaction previous_[kSignalCount] = {};
+#endif
+
+  const std::size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas (64) std::atomic<std::uint64_t> next_{ 0 };
+  char crashFile_[512] = {};
+};
+
+#endif // LOGFLIGHTRECORDER_HPP
@@ -0,0 +1,97 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Per-call-site state for rate limited logging (LOG_*_EVERY_N, LOG_*_EVERY_MS, LOG_*_RATE)
+
+#ifndef LOGRATELIMIT_HPP
+#define LOGRATELIMIT_HPP
+
+#include "LogRecord.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+// The macros check the log level first, then the limiter of the call site. A call the limiter
+// suppresses costs at most one relaxed atomic load and a compare:
+//  - LogEveryN counts calls per thread (a thread_local site, a plain integer, no atomic at all),
+//    so every thread logs its own 1st, (n+1)th... call; the frame loops using it are single
+//    threaded anyway,
+//  - LogEveryMs, LogRateLimit share one deadline per site, read with a relaxed load and compared
+//    to LogClock::steadyNs (); only the thread past the deadline does a compare-exchange.
+// Suppressed calls are tallied in a thread_local counter of the site (LogTally), not in shared
+// state, so the "suppressed" count on a record covers the calls its own thread dropped since that
+// thread last logged from the site.
+// All state is constant initialized and trivially destructible, neither the statics nor the
+// thread_locals need an initialization guard.
+
+using LogTally = std::uint64_t;
+
+// Logs the 1st, (n+1)th, (2n+1)th... call of the calling thread
+class LogEveryN {
+public:
+  constexpr LogEveryN () = default;
+
+  bool shouldLog (std::uint32_t n, std::uint64_t& suppressed) {
+    const std::uint64_t count = count_++;
+    if (n > 1 && count % n != 0) {
+      return false;
+    }
+    suppressed = n > 1 && count > 0 ? n - 1 : 0;
+    return true;
+  }
+
+private:
+  std::uint64_t count_ = 0;
+};
+
+// Logs at most once per interval, the first thread past the deadline wins
+class LogEveryMs {
+public:
+  constexpr LogEveryMs () = default;
+
+  bool shouldLog (std::int64_t intervalMs, LogTally& tally, std::uint64_t& suppressed) {
+    const std::int64_t now = LogClock::steadyNs ();
+    std::int64_t next = nextNs_.load (std::memory_order_relaxed);
+    if (now < next
+        || !nextNs_.compare_exchange_strong (next, now + intervalMs * 1000000,
+                                             std::memory_order_relaxed)) {
+      ++tally;
+      return false;
+    }
+    suppressed = tally;
+    tally = 0;
+    return true;
+  }
+
+private:
+  std::atomic<std::int64_t> nextNs_{ 0 };
+};
+
+// Token bucket with `perSecond` refill and `burst` capacity, kept as a single theoretical arrival
+// time (GCRA) so the state is one atomic
+class LogRateLimit {
+public:
+  constexpr LogRateLimit () = default;
+
+  bool shouldLog (double perSecond, std::uint32_t burst, LogTally& tally,
+                  std::uint64_t& suppressed) {
+    const std::int64_t interval = static_cast<std::int64_t> (1e9 / std::max (perSecond, 1e-3));
+    const std::int64_t tolerance = interval * (std::max<std::uint32_t> (burst, 1) - 1);
+    const std::int64_t now = LogClock::steadyNs ();
+    std::int64_t tat = tatNs_.load (std::memory_order_relaxed);
+    if (tat - now > tolerance
+        || !tatNs_.compare_exchange_strong (tat, std::max (tat, now) + interval,
+                                            std::memory_order_relaxed)) {
+      ++tally;
+      return false;
+    }
+    suppressed = tally;
+    tally = 0;
+    return true;
+  }
+
+private:
+  std::atomic<std::int64_t> tatNs_{ 0 };
+};
+
+#endif // LOGRATELIMIT_HPP
@@ -0,0 +1,150 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Log record, clock and key-value field types shared by the logger and its sinks
+
+#ifndef LOGRECORD_HPP
+#define LOGRECORD_HPP
+
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <ctime>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "fmt/format.h"
+
+enum class LogLevel { LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_CRITICAL };
+
+inline const char* logLevelToString (LogLevel level) {
+  switch (level) {
+  case LogLevel::LOG_DEBUG:
+    return "DBG";
+  case LogLevel::LOG_INFO:
+    return "INF";
+  case LogLevel::LOG_WARNING:
+    return "WRN";
+  case LogLevel::LOG_ERROR:
+    return "ERR";
+  case LogLevel::LOG_CRITICAL:
+    return "CRI";
+  default:
+    return "INF";
+  }
+}
+
+namespace LogClock {
+
+  // Cheap wall clock in nanoseconds since the Unix epoch. system_clock is sampled only once,
+  // every later reading is the anchor advanced by the monotonic steady_clock.
+  inline std::int64_t now () {
+    using namespace std::chrono;
+    static const auto anchor = [] {
+      return std::make_pair (
+          duration_cast<nanoseconds> (system_clock::now ().time_since_epoch ()).count (),
+          steady_clock::now ());
+    }();
+    return anchor.first
+           + duration_cast<nanoseconds> (steady_clock::now () - anchor.second).count ();
+  }
+
+  // Monotonic nanoseconds for deadlines, a bare steady_clock read without the anchor's guard
+  inline std::int64_t steadyNs () {
+    using namespace std::chrono;
+    return duration_cast<nanoseconds> (steady_clock::now ().time_since_epoch ()).count ();
+  }
+
+  // Renders "dd-mm-YYYY HH:MM:SS.mmm". The date/second prefix is cached per thread and only
+  // re-rendered (localtime + strftime) when the second changes. The view stays valid until the
+  // next call on the same thread.
+  inline std::string_view format (std::int64_t epochNs) {
+    struct Cache {
+      std::int64_t second = INT64_MIN;
+      char text[32] = {};
+      std::size_t prefixLen = 0;
+    };
+    static thread_local Cache cache;
+
+    std::int64_t second = epochNs / 1000000000;
+    std::int64_t subNs = epochNs % 1000000000;
+    if (subNs < 0) {
+      subNs += 1000000000;
+      --second;
+    }
+
+    if (second != cache.second) {
+      std::time_t now_time = static_cast<std::time_t> (second);
+      std::tm now_tm{};
+#ifdef _WIN32
+      localtime_s (&now_tm, &now_time);
+#else
+      localtime_r (&now_time, &now_tm);
+#endif
+      cache.prefixLen = std::strftime (cache.text, sizeof (cache.text) - 4, "%d-%m-%Y %H:%M:%S",
+                                       &now_tm);
+      cache.second = second;
+    }
+
+    const int millis = static_cast<int> (subNs / 1000000);
+    char* out = cache.text + cache.prefixLen;
+    out[0] = '.';
+    out[1] = static_cast<char> ('0' + millis / 100);
+    out[2] = static_cast<char> ('0' + (millis / 10) % 10);
+    out[3] = static_cast<char> ('0' + millis % 10);
+    return std::string_view (cache.text, cache.prefixLen + 4);
+  }
+
+} // namespace LogClock
+
+// Typed key-value pair attached to a record. Keys are string literals (static storage), values
+// keep their type so every sink serializes them in its own format.
+struct LogField {
+  using Value = std::variant<std::int64_t, std::uint64_t, double, bool, std::string>;
+
+  const char* key = "";
+  Value value;
+
+  template <typename T> static Value makeValue (T&& value) {
+    using V = std::decay_t<T>;
+    if constexpr (std::is_same_v<V, bool>) {
+      return Value (std::in_place_type<bool>, value);
+    } else if constexpr (std::is_integral_v<V> && std::is_signed_v<V>) {
+      return Value (std::in_place_type<std::int64_t>, value);
+    } else if constexpr (std::is_integral_v<V>) {
+      return Value (std::in_place_type<std::uint64_t>, value);
+    } else if constexpr (std::is_floating_point_v<V>) {
+      return Value (std::in_place_type<double>, value);
+    } else if constexpr (std::is_convertible_v<T, std::string_view>) {
+      return Value (std::in_place_type<std::string>, std::string_view (value));
+    } else {
+      return Value (std::in_place_type<std::string>, fmt::format ("{}", value));
+    }
+  }
+};
+
+// Immutable header configuration, published by the logger as a snapshot
+struct LogHeaderConfig {
+  std::string name = "DotNameLib";
+  bool includeName = true;
+  bool includeTime = true;
+  bool includeCaller = true;
+  bool includeLevel = true;
+  bool addNewLine = true;
+};
+
+// One log line as it travels from the producer to the sinks
+struct LogRecord {
+  std::int64_t timeNs = 0;    // LogClock::now () at the call site
+  std::uint32_t shardId = 0;  // producer shard, 0 for synchronous logging
+  std::uint64_t sequence = 0; // per-shard order, breaks timestamp ties
+  LogLevel level = LogLevel::LOG_INFO;
+  std::string caller;
+  std::string message;
+  std::vector<LogField> fields; // empty (no allocation) unless the KV API is used
+};
+
+#endif // LOGRECORD_HPP
@@ -0,0 +1,380 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Pluggable log sinks: console, file, NDJSON and an in-memory ring
+
+#ifndef LOGSINK_HPP
+#define LOGSINK_HPP
+
+#include "LogRecord.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fmt/format.h"
+
+#ifdef _WIN32
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  // Disable min/max macros in windows.h to avoid conflicts with std::min/max
+  // cxxopts.hpp uses std::min/max
+  #endif
+
+  // Undefine Raylib functions to avoid conflicts
+  #define Rectangle WindowsRectangle
+  #define CloseWindow WindowsCloseWindow
+  #define ShowCursor WindowsShowCursor
+  #define DrawText WindowsDrawText
+  #define PlaySound WindowsPlaySound
+  #define PlaySoundA WindowsPlaySoundA
+  #define PlaySoundW WindowsPlaySoundW
+  #define LoadImage WindowsLoadImage
+  #define DrawTextEx WindowsDrawTextEx
+
+  #include <windows.h>
+
+  // Restore Raylib functions
+  #undef Rectangle
+  #undef CloseWindow
+  #undef ShowCursor
+  #undef DrawText
+  #undef PlaySound
+  #undef PlaySoundA
+  #undef PlaySoundW
+  #undef LoadImage
+  #undef DrawTextEx
+
+#endif
+
+// Sink interface. The logger serializes all calls under its output mutex: on the calling thread
+// in synchronous mode, on the writer thread in async mode. Sinks therefore need no locking of
+// their own unless they are read from other threads.
+class LogSink {
+public:
+  virtual ~LogSink () = default;
+  virtual void write (const LogRecord& record, const LogHeaderConfig& config) = 0;
+  // After every record in synchronous mode, once per batch in async mode. With the flight
+  // recorder enabled only interactive sinks are flushed per record, the rest stay fully buffered.
+  virtual void flush () {
+  }
+  virtual bool isInteractive () const {
+    return false;
+  }
+};
+
+namespace LogFormat {
+
+  using Buffer = fmt::memory_buffer;
+
+  inline void append (Buffer& out, std::string_view text) {
+    out.append (text.data (), text.data () + text.size ());
+  }
+
+  // "[name] [time] [caller] [LVL] " according to the header configuration
+  inline void appendHeader (Buffer& out, const LogRecord& record, const LogHeaderConfig& config) {
+    if (config.includeName) {
+      fmt::format_to (std::back_inserter (out), "[{}] ", config.name);
+    }
+    if (config.includeTime) {
+      fmt::format_to (std::back_inserter (out), "[{}] ", LogClock::format (record.timeNs));
+    }
+    if (config.includeCaller && !record.caller.empty ()) {
+      fmt::format_to (std::back_inserter (out), "[{}] ", record.caller);
+    }
+    if (config.includeLevel) {
+      fmt::format_to (std::back_inserter (out), "[{}] ", logLevelToString (record.level));
+    }
+  }
+
+  inline void appendTextValue (Buffer& out, const LogField::Value& value) {
+    std::visit (
+        [&] (const auto& v) {
+          using V = std::decay_t<decltype (v)>;
+          if constexpr (std::is_same_v<V, bool>) {
+            append (out, v ? "true" : "false");
+          } else {
+            fmt::format_to (std::back_inserter (out), "{}", v);
+          }
+        },
+        value);
+  }
+
+  // Message followed by " key=value" pairs
+  inline void appendText (Buffer& out, const LogRecord& record) {
+    append (out, record.message);
+    for (const LogField& field : record.fields) {
+      fmt::format_to (std::back_inserter (out), " {}=", field.key);
+      appendTextValue (out, field.value);
+    }
+  }
+
+  inline void appendJsonString (Buffer& out, std::string_view text) {
+    out.push_back ('"');
+    for (char c : text) {
+      switch (c) {
+      case '"':
+        append (out, "\\\"");
+        break;
+      case '\\':
+        append (out, "\\\\");
+        break;
+      case '\n':
+        append (out, "\\n");
+        break;
+      case '\r':
+        append (out, "\\r");
+        break;
+      case '\t':
+        append (out, "\\t");
+        break;
+      default:
+        if (static_cast<unsigned char> (c) < 0x20) {
+          fmt::format_to (std::back_inserter (out), "\\u{:04x}", static_cast<unsigned char> (c));
+        } else {
+          out.push_back (c);
+        }
+      }
+    }
+    out.push_back ('"');
+  }
+
+  inline void appendJsonValue (Buffer& out, const LogField::Value& value) {
+    std::visit (
+        [&] (const auto& v) {
+          using V = std::decay_t<decltype (v)>;
+          if constexpr (std::is_same_v<V, bool>) {
+            append (out, v ? "true" : "false");
+          } else if constexpr (std::is_same_v<V, double>) {
+            if (std::isfinite (v)) {
+              fmt::format_to (std::back_inserter (out), "{}", v);
+            } else {
+              append (out, "null");
+            }
+          } else if constexpr (std::is_same_v<V, std::string>) {
+            appendJsonString (out, v);
+          } else {
+            fmt::format_to (std::back_inserter (out), "{}", v);
+          }
+        },
+        value);
+  }
+
+  // One NDJSON object, fields are emitted as top-level keys after the fixed ones
+  inline void appendJson (Buffer& out, const LogRecord& record) {
+    append (out, "{\"ts\":");
+    appendJsonString (out, LogClock::format (record.timeNs));
+    fmt::format_to (std::back_inserter (out), ",\"ts_ns\":{},\"level\":\"{}\",\"thread\":{}",
+                    record.timeNs, logLevelToString (record.level), record.shardId);
+    if (!record.caller.empty ()) {
+      append (out, ",\"caller\":");
+      appendJsonString (out, record.caller);
+    }
+    append (out, ",\"msg\":");
+    appendJsonString (out, record.message);
+    for (const LogField& field : record.fields) {
+      out.push_back (',');
+      appendJsonString (out, field.key);
+      out.push_back (':');
+      appendJsonValue (out, field.value);
+    }
+    append (out, "}\n");
+  }
+
+} // namespace LogFormat
+
+// Colored console output, errors go to stderr
+class ConsoleSink : public LogSink {
+public:
+  void write (const LogRecord& record, const LogHeaderConfig& config) override {
+    std::ostream& stream
+        = (record.level == LogLevel::LOG_ERROR || record.level == LogLevel::LOG_CRITICAL)
+              ? std::cerr
+              : std::cout;
+    buffer_.clear ();
+    LogFormat::appendHeader (buffer_, record, config);
+    LogFormat::appendText (buffer_, record);
+    if (config.addNewLine) {
+      buffer_.push_back ('\n');
+    }
+
+    // Nejdříve nastavit barvu, pak vypsat header a zprávu, nakonec resetovat barvu
+    setConsoleColor (record.level);
+    stream.write (buffer_.data (), static_cast<std::streamsize> (buffer_.size ()));
+    resetConsoleColor ();
+  }
+
+  void flush () override {
+    std::cout.flush ();
+    std::cerr.flush ();
+  }
+
+  bool isInteractive () const override {
+    return true;
+  }
+
+  static void resetConsoleColor () {
+#ifdef _WIN32
+    SetConsoleTextAttribute (GetStdHandle (STD_OUTPUT_HANDLE),
+                             FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
+#elif defined(__EMSCRIPTEN__)
+// no colors, no reset
+#else
+    std::cout << "\033[0m";
+#endif
+  }
+
+#ifdef _WIN32
+  static void setConsoleColorWindows (LogLevel level) {
+    const std::map<LogLevel, WORD> colorMap
+        = { { LogLevel::LOG_DEBUG, FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY },
+            { LogLevel::LOG_INFO, FOREGROUND_GREEN | FOREGROUND_INTENSITY },
+            { LogLevel::LOG_WARNING, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY },
+            { LogLevel::LOG_ERROR, FOREGROUND_RED | FOREGROUND_INTENSITY },
+            { LogLevel::LOG_CRITICAL, FOREGROUND_RED | FOREGROUND_INTENSITY | FOREGROUND_BLUE } };
+    auto it = colorMap.find (level);
+    if (it != colorMap.end ()) {
+      SetConsoleTextAttribute (GetStdHandle (STD_OUTPUT_HANDLE), it->second);
+    } else {
+      resetConsoleColor ();
+    }
+  }
+#else
+  static void setConsoleColorUnix (LogLevel level) {
+    static const std::map<LogLevel, const char*> colorMap
+        = { { LogLevel::LOG_DEBUG, "\033[34m" },
+            { LogLevel::LOG_INFO, "\033[32m" },
+            { LogLevel::LOG_WARNING, "\033[33m" },
+            { LogLevel::LOG_ERROR, "\033[31m" },
+            { LogLevel::LOG_CRITICAL, "\033[95m" } };
+    auto it = colorMap.find (level);
+    if (it != colorMap.end ()) {
+      std::cout << it->second;
+    } else {
+      resetConsoleColor ();
+    }
+  }
+#endif
+
+  static void setConsoleColor (LogLevel level) {
+#ifdef _WIN32
+    setConsoleColorWindows (level);
+#elif EMSCRIPTEN
+      // no colors
+#else
+    setConsoleColorUnix (level);
+#endif
+  }
+
+private:
+  LogFormat::Buffer buffer_;
+};
+
+// Plain text file, "[time] [caller] [LVL] message key=value"
+class FileSink : public LogSink {
+public:
+  explicit FileSink (const std::string& filename) {
+    file_.open (filename, std::ios::out | std::ios::app);
+  }
+
+  bool isOpen () const {
+    return file_.is_open ();
+  }
+
+  void write (const LogRecord& record, const LogHeaderConfig&) override {
+    buffer_.clear ();
+    fmt::format_to (std::back_inserter (buffer_), "[{}] [{}] [{}] ",
+                    LogClock::format (record.timeNs),
+                    record.caller.empty () ? "empty caller" : record.caller,
+                    logLevelToString (record.level));
+    LogFormat::appendText (buffer_, record);
+    buffer_.push_back ('\n');
+    file_.write (buffer_.data (), static_cast<std::streamsize> (buffer_.size ()));
+  }
+
+  void flush () override {
+    file_.flush ();
+  }
+
+private:
+  std::ofstream file_;
+  LogFormat::Buffer buffer_;
+};
+
+// Newline-delimited JSON for log shipping, one object per record
+class NdjsonSink : public LogSink {
+public:
+  explicit NdjsonSink (const std::string& filename) {
+    file_.open (filename, std::ios::out | std::ios::app);
+  }
+
+  bool isOpen () const {
+    return file_.is_open ();
+  }
+
+  void write (const LogRecord& record, const LogHeaderConfig&) override {
+    buffer_.clear ();
+    LogFormat::appendJson (buffer_, record);
+    file_.write (buffer_.data (), static_cast<std::streamsize> (buffer_.size ()));
+  }
+
+  void flush () override {
+    file_.flush ();
+  }
+
+private:
+  std::ofstream file_;
+  LogFormat::Buffer buffer_;
+};
+
+// Keeps the last `capacity` records in memory, mainly for tests
+class RingSink : public LogSink {
+public:
+  explicit RingSink (std::size_t capacity = 256) : ring_ (capacity) {
+  }
+
+  void write (const LogRecord& record, const LogHeaderConfig&) override {
+    std::lock_guard<std::mutex> lock (mutex_);
+    if (ring_.empty ()) {
+      return;
+    }
+    ring_[written_ % ring_.size ()] = record;
+    ++written_;
+  }
+
+  // Oldest first
+  std::vector<LogRecord> records () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    std::vector<LogRecord> out;
+    const std::size_t count = std::min (written_, ring_.size ());
+    out.reserve (count);
+    for (std::size_t i = written_ - count; i < written_; ++i) {
+      out.push_back (ring_[i % ring_.size ()]);
+    }
+    return out;
+  }
+
+  std::size_t totalWritten () const {
+    std::lock_guard<std::mutex> lock (mutex_);
+    return written_;
+  }
+
+  void clear () {
+    std::lock_guard<std::mutex> lock (mutex_);
+    written_ = 0;
+  }
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<LogRecord> ring_;
+  std::size_t written_ = 0;
+};
+
+#endif // LOGSINK_HPP
@@ -5,7 +5,13 @@
 #ifndef LOGGER_HPP
 #define LOGGER_HPP
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
@@ -14,42 +20,16 @@
 #include <mutex>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
 #include "fmt/core.h"
 
-#ifdef _WIN32
-  #ifndef NOMINMAX
-    #define NOMINMAX
-  // Disable min/max macros in windows.h to avoid conflicts with std::min/max
-  // cxxopts.hpp uses std::min/max
-  #endif
-
-  // Undefine Raylib functions to avoid conflicts
-  #define Rectangle WindowsRectangle
-  #define CloseWindow WindowsCloseWindow
-  #define ShowCursor WindowsShowCursor
-  #define DrawText WindowsDrawText
-  #define PlaySound WindowsPlaySound
-  #define PlaySoundA WindowsPlaySoundA
-  #define PlaySoundW WindowsPlaySoundW
-  #define LoadImage WindowsLoadImage
-  #define DrawTextEx WindowsDrawTextEx
-
-  #include <windows.h>
-
-  // Restore Raylib functions
-  #undef Rectangle
-  #undef CloseWindow
-  #undef ShowCursor
-  #undef DrawText
-  #undef PlaySound
-  #undef PlaySoundA
-  #undef PlaySoundW
-  #undef LoadImage
-  #undef DrawTextEx
-
-#endif
+#include "LogFlightRecorder.hpp"
+#include "LogRateLimit.hpp"
+#include "LogRecord.hpp"
+#include "LogSink.hpp"
 
 // Function name macros for different compilers
 #if defined(__GNUC__) || defined(__clang__)
@@ -62,17 +42,127 @@
 
 class Logger {
 
+public:
+  using Level = LogLevel;
+  using Record = LogRecord;
+  // Immutable header configuration. Setters publish a new snapshot, log calls read the current
+  // one with a single acquire load and never take a lock.
+  using HeaderConfig = LogHeaderConfig;
+
 private:
-  std::mutex logMutex_;
-  std::ofstream logFile_;
-  bool addNewLine_ = true;
+  // Per-thread single-producer/single-consumer ring. The owning thread pushes, the async writer
+  // drains, so producers never contend with each other.
+  class Shard {
+  public:
+    static constexpr std::size_t kCapacity = 1024;
+    static constexpr std::size_t kBatch = 64; // wake the writer every kBatch records
+
+    explicit Shard (std::uint32_t id) : id_ (id) {
+    }
+
+    std::uint32_t id () const {
+      return id_;
+    }
+
+    // Returns false when the ring is full
+    bool tryPush (Record& record) {
+      const std::size_t head = head_.load (std::memory_order_relaxed);
+      if (head - tail_.load (std::memory_order_acquire) >= kCapacity) {
+        return false;
+      }
+      record.shardId = id_;
+      record.sequence = head;
+      slots_[head % kCapacity] = std::move (record);
+      head_.store (head + 1, std::memory_order_release);
+      return true;
+    }
+
+    std::size_t pending () const {
+      return head_.load (std::memory_order_acquire) - tail_.load (std::memory_order_relaxed);
+    }
+
+    // Consumer side, records come out in push (and therefore timestamp) order
+    void drain (std::vector<Record>& out) {
+      const std::size_t head = head_.load (std::memory_order_acquire);
+      std::size_t tail = tail_.load (std::memory_order_relaxed);
+      for (; tail != head; ++tail) {
+        out.push_back (std::move (slots_[tail % kCapacity]));
+      }
+      tail_.store (tail, std::memory_order_release);
+    }
+
+    void retire () {
+      retired_.store (true, std::memory_order_release);
+    }
+
+    bool isRetired () const {
+      return retired_.load (std::memory_order_acquire);
+    }
+
+  private:
+    const std::uint32_t id_;
+    std::array<Record, kCapacity> slots_;
+    alignas (64) std::atomic<std::size_t> head_{ 0 };
+    alignas (64) std::atomic<std::size_t> tail_{ 0 };
+    std::atomic<bool> retired_{ false };
+  };
+
+  // Marks the thread's shard as retired on thread exit, the writer drops it once drained
+  struct ShardHandle {
+    std::shared_ptr<Shard> shard;
+    ~ShardHandle () {
+      if (shard) {
+        shard->retire ();
+      }
+    }
+  };
+
+  std::mutex logMutex_; // guards the sinks
+  std::vector<std::shared_ptr<LogSink> > sinks_;
+  std::shared_ptr<ConsoleSink> consoleSink_ = std::make_shared<ConsoleSink> ();
+  std::shared_ptr<FileSink> fileSink_;
+
+  std::atomic<LogFlightRecorder*> flightRecorder_{ nullptr };
+  // Recorders are never destroyed while the logger lives, a producer may still hold the pointer
+  std::vector<std::unique_ptr<LogFlightRecorder> > flightRecorders_;
+
+  std::atomic<const HeaderConfig*> headerConfig_{ nullptr };
+  std::mutex configMutex_; // serializes setters only
+  std::unique_ptr<const HeaderConfig> currentConfig_; // owns *headerConfig_
+  // Snapshots are read either by sinks under logMutex_ or by getters counted in configReaders_.
+  // A setter frees the snapshots it replaced once it holds logMutex_ and no getter is inside, so
+  // at most the few replaced while a getter was reading stay behind until the next setter.
+  mutable std::atomic<int> configReaders_{ 0 };
+  std::vector<std::unique_ptr<const HeaderConfig> > retiredConfigs_;
+
+  std::mutex shardsMutex_;
+  std::vector<std::shared_ptr<Shard> > shards_;
+  std::uint32_t nextShardId_ = 1;
+
+  std::atomic<bool> async_{ false };
+  // Producers between their check of async_ and the end of their push; stopWriter waits for
+  // them before the final drain so nothing lands in a shard nobody reads any more
+  std::atomic<int> producers_{ 0 };
+  std::mutex lifecycleMutex_; // serializes setAsync and stopWriter
+  std::thread writer_;
+  std::mutex writerMutex_;
+  std::condition_variable writerCv_;
+  std::condition_variable flushedCv_;
+  bool stopWriter_ = false;
+  std::uint64_t flushRequested_ = 0;
+  std::uint64_t flushCompleted_ = 0;
 
 protected:
-  Logger () = default;
+  Logger () {
+    currentConfig_ = std::make_unique<const HeaderConfig> ();
+    headerConfig_.store (currentConfig_.get (), std::memory_order_release);
+    sinks_.push_back (consoleSink_);
+  }
   ~Logger () {
+    stopWriter ();
     std::lock_guard<std::mutex> lock (logMutex_);
-    if (logFile_.is_open ()) {
-      logFile_.close ();
+    for (auto& sink : sinks_) {
+      sink->flush ();
     }
   }
 
@@ -88,21 +178,21 @@ public:
 
 public:
   static void setAddNewLine (bool addNewLine) {
-    getInstance ().addNewLine_ = addNewLine;
+    getInstance ().updateHeaderConfig (
+        [&] (HeaderConfig& config) { config.addNewLine = addNewLine; });
   }
 
   static bool isAddNewLine () {
-    return getInstance ().addNewLine_;
+    return getInstance ().readHeaderConfig ([] (const HeaderConfig& config) {
+      return config.addNewLine;
+    });
   }
 
-public:
-  enum class Level { LOG_DEBUG, LOG_INFO, LOG_WARNING, LOG_ERROR, LOG_CRITICAL };
-
 private:
 #ifdef DEBUG
-  Level currentLevel_ = Level::LOG_DEBUG; // Automatically enable debug logging in debug builds
+  std::atomic<Level> currentLevel_{ Level::LOG_DEBUG }; // Automatically enable debug logging in debug builds
 #else
-  Level currentLevel_ = Level::LOG_INFO; // Default to info level in release builds
+  std::atomic<Level> currentLevel_{ Level::LOG_INFO }; // Default to info level in release builds
 #endif
 
 public:
@@ -128,31 +218,20 @@ public:
 
   void log (Level level, const std::string& message, const std::string& caller = "") {
     // Filtrování podle úrovně logování
-    if (level < currentLevel_) {
+    if (!isEnabled (level)) {
       return;
     }
 
-    std::lock_guard<std::mutex> lock (logMutex_);
-    auto now = std::chrono::system_clock::now ();
-    auto now_time = std::chrono::system_clock::to_time_t (now);
-    std::tm now_tm;
-#ifdef _WIN32
-    localtime_s (&now_tm, &now_time);
-#else
-    localtime_r (&now_time, &now_tm);
-#endif
-    // Výstup na konzoli
-    if (level == Level::LOG_ERROR || level == Level::LOG_CRITICAL) {
-      logToStream (std::cerr, level, message, caller, now_tm);
-    } else {
-      logToStream (std::cout, level, message, caller, now_tm);
-    }
-    // Výstup do souboru, pokud je povolen
-    if (logFile_.is_open ()) {
-      logFile_ << "[" << std::put_time (&now_tm, "%d-%m-%Y %H:%M:%S") << "] ";
-      logFile_ << "[" << (caller.empty () ? "empty caller" : caller) << "] ";
-      logFile_ << "[" << levelToString (level) << "] " << message << std::endl;
-    }
+    Record record;
+    record.timeNs = clockNow ();
+    record.level = level;
+    record.caller = caller;
+    record.message = message;
+    dispatch (record);
+  }
+
+  bool isEnabled (Level level) const {
+    return level >= currentLevel_.load (std::memory_order_relaxed);
   }
 
   template <typename... Args>
@@ -162,23 +241,147 @@ public:
     log (level, message, caller);
   }
 
+  // Backend of the rate limited macros. Calls dropped by the call-site limiter since the last
+  // emitted record are reported as a "suppressed" field (" suppressed=N" in text sinks).
+  template <typename... Args>
+  void logFmtSuppressed (Level level, std::uint64_t suppressed, const std::string& format,
+                         const std::string& caller, Args&&... args) {
+    if (!isEnabled (level)) {
+      return;
+    }
+
+    Record record;
+    record.timeNs = clockNow ();
+    record.level = level;
+    record.caller = caller;
+    record.message = fmt::vformat (format, fmt::make_format_args (args...));
+    if (suppressed > 0) {
+      record.fields.push_back (LogField{ "suppressed", LogField::makeValue (suppressed) });
+    }
+    dispatch (record);
+  }
+
+  // Structured logging: message followed by key/value pairs, e.g.
+  //   LOG_I_KV ("frame", "ms", dt, "fps", fps);
+  // Values keep their type in the record, no intermediate string is formatted. Each sink
+  // serializes them in its own format (key=value for text, native JSON types for NDJSON).
+  template <typename... KeyValues>
+  void logKV (Level level, const std::string& caller, std::string_view message,
+              KeyValues&&... keyValues) {
+    static_assert (sizeof...(KeyValues) % 2 == 0, "LOG_*_KV expects key/value pairs");
+    if (!isEnabled (level)) {
+      return;
+    }
+
+    Record record;
+    record.timeNs = clockNow ();
+    record.level = level;
+    record.caller = caller;
+    record.message.assign (message.data (), message.size ());
+    record.fields.reserve (sizeof...(KeyValues) / 2);
+    appendFields (record.fields, std::forward<KeyValues> (keyValues)...);
+    dispatch (record);
+  }
+
+public:
+  // Cheap wall clock in nanoseconds since the Unix epoch. system_clock is sampled only once,
+  // every later reading is the anchor advanced by the monotonic steady_clock.
+  static std::int64_t clockNow () {
+    return LogClock::now ();
+  }
+
+  // Renders "dd-mm-YYYY HH:MM:SS.mmm", see LogClock::format
+  static std::string_view formatTimestamp (std::int64_t epochNs) {
+    return LogClock::format (epochNs);
+  }
+
 public:
   // Metody pro nastavení a získání úrovně logování
   void setLevel (Level level) {
-    std::lock_guard<std::mutex> lock (logMutex_);
-    currentLevel_ = level;
+    currentLevel_.store (level, std::memory_order_relaxed);
   }
 
   Level getLevel () const {
-    return currentLevel_;
+    return currentLevel_.load (std::memory_order_relaxed);
   }
 
 public:
-  bool enableFileLogging (const std::string& filename) {
+  // Asynchronous mode: every producer thread appends to its own shard and a writer thread merges
+  // the shards by timestamp and hands them to the sinks in batches. Synchronous mode (default)
+  // writes directly under the sink mutex.
+  void setAsync (bool enabled) {
+    if (enabled) {
+      std::lock_guard<std::mutex> lifecycle (lifecycleMutex_);
+      std::lock_guard<std::mutex> lock (writerMutex_);
+      if (writer_.joinable ()) {
+        return;
+      }
+      stopWriter_ = false;
+      writer_ = std::thread ([this] { writerLoop (); });
+      async_.store (true, std::memory_order_release);
+    } else {
+      stopWriter ();
+    }
+  }
+
+  bool isAsync () const {
+    return async_.load (std::memory_order_acquire);
+  }
+
+  // Blocks until everything the calling thread logged so far has been written
+  void flush () {
+    {
+      std::unique_lock<std::mutex> lock (writerMutex_);
+      if (writer_.joinable ()) {
+        const std::uint64_t ticket = ++flushRequested_;
+        writerCv_.notify_one ();
+        flushedCv_.wait (lock, [&] { return flushCompleted_ >= ticket || stopWriter_; });
+      }
+    }
+    std::lock_guard<std::mutex> lock (logMutex_);
+    for (auto& sink : sinks_) {
+      sink->flush ();
+    }
+  }
+
+  HeaderConfig getHeaderConfig () const {
+    return readHeaderConfig ([] (const HeaderConfig& config) { return config; });
+  }
+
+public:
+  // Sinks receive every record that passes the level filter, on the writer thread in async mode
+  void addSink (std::shared_ptr<LogSink> sink) {
+    flush ();
     std::lock_guard<std::mutex> lock (logMutex_);
+    sinks_.push_back (std::move (sink));
+  }
+
+  void removeSink (const std::shared_ptr<LogSink>& sink) {
+    flush ();
+    std::lock_guard<std::mutex> lock (logMutex_);
+    sinks_.erase (std::remove (sinks_.begin (), sinks_.end (), sink), sinks_.end ());
+  }
+
+  // The console sink is installed by default
+  void setConsoleOutput (bool enabled) {
+    removeSink (consoleSink_);
+    if (enabled) {
+      addSink (consoleSink_);
+    }
+  }
+
+public:
+  bool enableFileLogging (const std::string& filename) {
     try {
-      logFile_.open (filename, std::ios::out | std::ios::app);
-      return logFile_.is_open ();
+      auto sink = std::make_shared<FileSink> (filename);
+      if (!sink->isOpen ()) {
+        return false;
+      }
+      disableFileLogging ();
+      addSink (sink);
+      std::lock_guard<std::mutex> lock (logMutex_);
+      fileSink_ = std::move (sink);
+      return true;
     } catch (const std::ios_base::failure& e) {
       std::cerr << "Failed to open log file: " << filename << " - " << e.what () << std::endl;
       return false;
@@ -192,162 +395,288 @@ public:
   }
 
   void disableFileLogging () {
+    std::shared_ptr<FileSink> sink;
+    {
+      std::lock_guard<std::mutex> lock (logMutex_);
+      sink = std::move (fileSink_);
+    }
+    if (sink) {
+      removeSink (sink);
+    }
+  }
+
+  // Keeps the last `capacity` records in memory and dumps them to `crashFile` (and stderr) on
+  // SIGSEGV/SIGABRT/SIGBUS/SIGFPE/SIGILL. While enabled, file sinks are no longer flushed after
+  // every record in synchronous mode. Crash handlers are POSIX only.
+  void enableFlightRecorder (const std::string& crashFile, std::size_t capacity = 512) {
     std::lock_guard<std::mutex> lock (logMutex_);
-    if (logFile_.is_open ()) {
-      logFile_.close ();
+    if (LogFlightRecorder* current = flightRecorder_.load (std::memory_order_acquire)) {
+      current->uninstallCrashHandlers ();
     }
+    flightRecorders_.push_back (std::make_unique<LogFlightRecorder> (capacity, crashFile));
+    flightRecorders_.back ()->installCrashHandlers ();
+    flightRecorder_.store (flightRecorders_.back ().get (), std::memory_order_release);
   }
 
-  std::string levelToString (Level level) const {
-    switch (level) {
-    case Level::LOG_DEBUG:
-      return "DBG";
-    case Level::LOG_INFO:
-      return "INF";
-    case Level::LOG_WARNING:
-      return "WRN";
-    case Level::LOG_ERROR:
-      return "ERR";
-    case Level::LOG_CRITICAL:
-      return "CRI";
-    default:
-      return "INF";
+  void disableFlightRecorder () {
+    std::lock_guard<std::mutex> lock (logMutex_);
+    if (LogFlightRecorder* current = flightRecorder_.exchange (nullptr)) {
+      current->uninstallCrashHandlers ();
     }
   }
 
-  void resetConsoleColor () {
-#ifdef _WIN32
-    SetConsoleTextAttribute (GetStdHandle (STD_OUTPUT_HANDLE),
-                             FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_BLUE);
-#elif defined(__EMSCRIPTEN__)
-// no colors, no reset
-#else
-    std::cout << "\033[0m";
-#endif
+  const LogFlightRecorder* flightRecorder () const {
+    return flightRecorder_.load (std::memory_order_acquire);
   }
 
-#ifdef _WIN32
-  void setConsoleColorWindows (Level level) {
-    const std::map<Level, WORD> colorMap
-        = { { Level::LOG_DEBUG, FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_INTENSITY },
-            { Level::LOG_INFO, FOREGROUND_GREEN | FOREGROUND_INTENSITY },
-            { Level::LOG_WARNING, FOREGROUND_RED | FOREGROUND_GREEN | FOREGROUND_INTENSITY },
-            { Level::LOG_ERROR, FOREGROUND_RED | FOREGROUND_INTENSITY },
-            { Level::LOG_CRITICAL, FOREGROUND_RED | FOREGROUND_INTENSITY | FOREGROUND_BLUE } };
-    auto it = colorMap.find (level);
-    if (it != colorMap.end ()) {
-      SetConsoleTextAttribute (GetStdHandle (STD_OUTPUT_HANDLE), it->second);
-    } else {
-      resetConsoleColor ();
-    }
+  std::string levelToString (Level level) const {
+    return logLevelToString (level);
   }
-#else
-  void setConsoleColorUnix (Level level) {
-    static const std::map<Level, const char*> colorMap = { { Level::LOG_DEBUG, "\033[34m" },
-                                                           { Level::LOG_INFO, "\033[32m" },
-                                                           { Level::LOG_WARNING, "\033[33m" },
-                                                           { Level::LOG_ERROR, "\033[31m" },
-                                                           { Level::LOG_CRITICAL, "\033[95m" } };
-    auto it = colorMap.find (level);
-    if (it != colorMap.end ()) {
-      std::cout << it->second;
-    } else {
-      resetConsoleColor ();
-    }
+
+  void resetConsoleColor () {
+    ConsoleSink::resetConsoleColor ();
   }
-#endif
 
   void setConsoleColor (Level level) {
-#ifdef _WIN32
-    setConsoleColorWindows (level);
-#elif EMSCRIPTEN
-      // no colors
-#else
-    setConsoleColorUnix (level);
-#endif
+    ConsoleSink::setConsoleColor (level);
   }
 
 private:
-  std::string headerName_ = "DotNameLib";
-  bool includeName_ = true;
-  bool includeTime_ = true;
-  bool includeCaller_ = true;
-  bool includeLevel_ = true;
+  // Sinks only, with logMutex_ held
+  const HeaderConfig* headerConfig () const {
+    return headerConfig_.load (std::memory_order_acquire);
+  }
+
+  // Everyone else. seq_cst on both sides: either the setter sees this reader counted, or the
+  // reader sees the new snapshot.
+  template <typename Fn>
+  auto readHeaderConfig (Fn&& read) const
+      -> decltype (read (std::declval<const HeaderConfig&> ())) {
+    struct Reader {
+      std::atomic<int>& readers;
+      ~Reader () {
+        readers.fetch_sub (1);
+      }
+    };
+    configReaders_.fetch_add (1);
+    const Reader reader{ configReaders_ };
+    return read (*headerConfig_.load ());
+  }
+
+  template <typename Fn> void updateHeaderConfig (Fn&& update) {
+    std::lock_guard<std::mutex> lock (configMutex_);
+    auto next = std::make_unique<HeaderConfig> (*currentConfig_);
+    update (*next);
+    headerConfig_.store (next.get ());
+    retiredConfigs_.push_back (std::move (currentConfig_));
+    currentConfig_ = std::move (next);
+
+    std::lock_guard<std::mutex> sinks (logMutex_);
+    if (configReaders_.load () == 0) {
+      retiredConfigs_.clear ();
+    }
+  }
 
-  void logToStream (std::ostream& stream, Level level, const std::string& message,
-                    const std::string& caller, const std::tm& now_tm) {
-    // Nejdříve nastavit barvu
-    setConsoleColor (level);
+  static void appendFields (std::vector<LogField>&) {
+  }
 
-    // Pak vypsat header a zprávu
-    stream << buildHeader (now_tm, caller, level) << message;
+  template <typename Value, typename... Rest>
+  static void appendFields (std::vector<LogField>& fields, const char* key, Value&& value,
+                            Rest&&... rest) {
+    fields.push_back (LogField{ key, LogField::makeValue (std::forward<Value> (value)) });
+    appendFields (fields, std::forward<Rest> (rest)...);
+  }
+
+  void dispatch (Record& record) {
+    LogFlightRecorder* recorder = flightRecorder_.load (std::memory_order_acquire);
+    if (recorder != nullptr) {
+      recorder->record (record);
+    }
+
+    // seq_cst pairs with stopWriter: either this producer sees async_ off, or stopWriter sees it
+    // counted and waits for the push
+    if (async_.load (std::memory_order_acquire)) {
+      producers_.fetch_add (1);
+      const bool queued = async_.load () && enqueue (record);
+      producers_.fetch_sub (1);
+      if (queued) {
+        return;
+      }
+      // The writer is stopping, write synchronously below
+    }
+
+    std::lock_guard<std::mutex> lock (logMutex_);
+    const HeaderConfig& config = *headerConfig ();
+    for (auto& sink : sinks_) {
+      sink->write (record, config);
+      if (recorder == nullptr || sink->isInteractive ()) {
+        sink->flush ();
+      }
+    }
+  }
 
-    // Resetovat barvu
-    resetConsoleColor ();
+  // === async mode ===
 
-    // Přidat nový řádek pokud je požadován
-    if (addNewLine_) {
-      stream << std::endl;
+  Shard& localShard () {
+    static thread_local ShardHandle handle;
+    if (!handle.shard) {
+      std::lock_guard<std::mutex> lock (shardsMutex_);
+      handle.shard = std::make_shared<Shard> (nextShardId_++);
+      shards_.push_back (handle.shard);
     }
+    return *handle.shard;
   }
 
-  std::string buildHeader (const std::tm& now_tm, const std::string& caller, Level level) const {
-    std::ostringstream header;
-    if (includeName_) {
-      header << "[" << headerName_ << "] ";
+  // False when the writer stopped while the ring was full, the record is then left untouched
+  bool enqueue (Record& record) {
+    Shard& shard = localShard ();
+    while (!shard.tryPush (record)) {
+      if (!async_.load ()) {
+        return false;
+      }
+      // Ring full - hand the batch to the writer and back off
+      writerCv_.notify_one ();
+      std::this_thread::yield ();
     }
-    if (includeTime_) {
-      header << "[" << std::put_time (&now_tm, "%d-%m-%Y %H:%M:%S") << "] ";
+    if (shard.pending () % Shard::kBatch == 0) {
+      writerCv_.notify_one ();
     }
-    if (includeCaller_ && !caller.empty ()) {
-      header << "[" << caller << "] ";
+    return true;
+  }
+
+  void stopWriter () {
+    std::lock_guard<std::mutex> lifecycle (lifecycleMutex_);
+    {
+      std::lock_guard<std::mutex> lock (writerMutex_);
+      if (!writer_.joinable ()) {
+        return;
+      }
+      async_.store (false);
+      stopWriter_ = true;
     }
-    if (includeLevel_) {
-      header << "[" << levelToString (level) << "] ";
+    writerCv_.notify_one ();
+    writer_.join ();
+
+    // Producers that saw async_ just before it went off push after the writer's last drain
+    while (producers_.load () != 0) {
+      std::this_thread::yield ();
+    }
+    std::vector<std::vector<Record> > batches;
+    std::vector<Record> merged;
+    drainShards (batches, merged);
+    flushedCv_.notify_all ();
+  }
+
+  // Collects the shards, merges their (individually ordered) records by timestamp and hands the
+  // batch to the sinks under a single lock, each sink is flushed once per batch
+  void drainShards (std::vector<std::vector<Record> >& batches, std::vector<Record>& merged) {
+    std::vector<std::shared_ptr<Shard> > shards;
+    {
+      std::lock_guard<std::mutex> lock (shardsMutex_);
+      shards = shards_;
+    }
+    batches.resize (shards.size ());
+    for (std::size_t i = 0; i < shards.size (); ++i) {
+      batches[i].clear ();
+      shards[i]->drain (batches[i]);
+    }
+    {
+      // Forget threads that have exited and whose records are all drained
+      std::lock_guard<std::mutex> lock (shardsMutex_);
+      shards_.erase (std::remove_if (shards_.begin (), shards_.end (),
+                                     [] (const std::shared_ptr<Shard>& shard) {
+                                       return shard->isRetired () && shard->pending () == 0;
+                                     }),
+                     shards_.end ());
+    }
+
+    // k-way merge, each batch is already sorted
+    using Cursor = std::pair<std::size_t, std::size_t>; // batch, position
+    auto later = [&] (const Cursor& a, const Cursor& b) {
+      const Record& ra = batches[a.first][a.second];
+      const Record& rb = batches[b.first][b.second];
+      if (ra.timeNs != rb.timeNs) {
+        return ra.timeNs > rb.timeNs;
+      }
+      return ra.shardId > rb.shardId;
+    };
+    std::vector<Cursor> heap;
+    for (std::size_t i = 0; i < batches.size (); ++i) {
+      if (!batches[i].empty ()) {
+        heap.emplace_back (i, 0);
+      }
+    }
+    std::make_heap (heap.begin (), heap.end (), later);
+    merged.clear ();
+    while (!heap.empty ()) {
+      std::pop_heap (heap.begin (), heap.end (), later);
+      Cursor cursor = heap.back ();
+      heap.pop_back ();
+      merged.push_back (std::move (batches[cursor.first][cursor.second]));
+      if (++cursor.second < batches[cursor.first].size ()) {
+        heap.push_back (cursor);
+        std::push_heap (heap.begin (), heap.end (), later);
+      }
+    }
+
+    if (!merged.empty ()) {
+      std::lock_guard<std::mutex> lock (logMutex_);
+      const HeaderConfig& config = *headerConfig ();
+      for (auto& sink : sinks_) {
+        for (const Record& record : merged) {
+          sink->write (record, config);
+        }
+        sink->flush ();
+      }
+    }
+  }
+
+  void writerLoop () {
+    std::vector<std::vector<Record> > batches;
+    std::vector<Record> merged;
+    std::unique_lock<std::mutex> lock (writerMutex_);
+    for (;;) {
+      writerCv_.wait_for (lock, std::chrono::milliseconds (10));
+      const bool stopping = stopWriter_;
+      const std::uint64_t ticket = flushRequested_;
+      lock.unlock ();
+      drainShards (batches, merged);
+      lock.lock ();
+      flushCompleted_ = ticket;
+      flushedCv_.notify_all ();
+      if (stopping) {
+        break;
+      }
     }
-    return header.str ();
   }
 
 public:
   // Metody pro nastavení záhlaví zůstávají stejné
   void setHeaderName (const std::string& headerName) {
-    std::lock_guard<std::mutex> lock (logMutex_);
-    headerName_ = headerName;
+    updateHeaderConfig ([&] (HeaderConfig& config) { config.name = headerName; });
   }
   void showHeaderName (bool includeName) {
-    std::lock_guard<std::mutex> lock (logMutex_);
-    includeName_ = includeName;
+    updateHeaderConfig ([&] (HeaderConfig& config) { config.includeName = includeName; });
   }
   void showHeaderTime (bool includeTime) {
-    std::lock_guard<std::mutex> lock (logMutex_);
-    includeTime_ = includeTime;
+    updateHeaderConfig ([&] (HeaderConfig& config) { config.includeTime = includeTime; });
   }
   void showHeaderCaller (bool includeCaller) {
-    std::lock_guard<std::mutex> lock (logMutex_);
-    includeCaller_ = includeCaller;
+    updateHeaderConfig ([&] (HeaderConfig& config) { config.includeCaller = includeCaller; });
   }
   void showHeaderLevel (bool includeLevel) {
-    std::lock_guard<std::mutex> lock (logMutex_);
-    includeLevel_ = includeLevel;
+    updateHeaderConfig ([&] (HeaderConfig& config) { config.includeLevel = includeLevel; });
   }
   void noHeader (bool noHeader) {
-    if (noHeader) {
-      showHeaderName (false);
-      showHeaderTime (false);
-      showHeaderCaller (false);
-      showHeaderLevel (false);
-    } else {
-      showHeaderName (true);
-      showHeaderTime (true);
-      showHeaderCaller (true);
-      showHeaderLevel (true);
-    }
+    visibleHeaders (!noHeader, !noHeader, !noHeader, !noHeader);
   }
   void visibleHeaders (bool incName, bool incTime, bool incCaller, bool incLevel) {
-    showHeaderName (incName);
-    showHeaderTime (incTime);
-    showHeaderCaller (incCaller);
-    showHeaderLevel (incLevel);
+    updateHeaderConfig ([&] (HeaderConfig& config) {
+      config.includeName = incName;
+      config.includeTime = incTime;
+      config.includeCaller = incCaller;
+      config.includeLevel = incLevel;
+    });
   }
 
 public:
@@ -390,10 +719,18 @@ public:
   #define LOG_D_STREAM Logger::getInstance().stream(Logger::Level::LOG_DEBUG, FUNCTION_NAME)
   #define LOG_D_MSG(msg) Logger::getInstance().debug(msg, FUNCTION_NAME)
   #define LOG_D_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_DEBUG, format, FUNCTION_NAME, __VA_ARGS__)
+  #define LOG_D_KV(msg, ...) Logger::getInstance().logKV(Logger::Level::LOG_DEBUG, FUNCTION_NAME, msg, __VA_ARGS__)
+  #define LOG_D_EVERY_N(n, format, ...) LOG_EVERY_N_IMPL(Logger::Level::LOG_DEBUG, n, format, __VA_ARGS__)
+  #define LOG_D_EVERY_MS(ms, format, ...) LOG_EVERY_MS_IMPL(Logger::Level::LOG_DEBUG, ms, format, __VA_ARGS__)
+  #define LOG_D_RATE(perSecond, burst, format, ...) LOG_RATE_IMPL(Logger::Level::LOG_DEBUG, perSecond, burst, format, __VA_ARGS__)
 #else
   #define LOG_D_STREAM if(0) Logger::getInstance().stream(Logger::Level::LOG_DEBUG, FUNCTION_NAME)
   #define LOG_D_MSG(msg) do {} while(0)
   #define LOG_D_FMT(format, ...) do {} while(0)
+  #define LOG_D_KV(msg, ...) do {} while(0)
+  #define LOG_D_EVERY_N(n, format, ...) do {} while(0)
+  #define LOG_D_EVERY_MS(ms, format, ...) do {} while(0)
+  #define LOG_D_RATE(perSecond, burst, format, ...) do {} while(0)
 #endif
   
   //#define LOG_D_STREAM Logger::getInstance().stream(Logger::Level::LOG_DEBUG, FUNCTION_NAME)
@@ -413,6 +750,33 @@ public:
   #define LOG_W_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_WARNING, format, FUNCTION_NAME, __VA_ARGS__)
   #define LOG_E_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_ERROR, format, FUNCTION_NAME, __VA_ARGS__)
   #define LOG_C_FMT(format, ...) Logger::getInstance().logFmtMessage(Logger::Level::LOG_CRITICAL, format, FUNCTION_NAME, __VA_ARGS__)
+
+  // Structured key-value logging: LOG_I_KV("frame", "ms", dt, "fps", fps)
+  #define LOG_I_KV(msg, ...) Logger::getInstance().logKV(Logger::Level::LOG_INFO, FUNCTION_NAME, msg, __VA_ARGS__)
+  #define LOG_W_KV(msg, ...) Logger::getInstance().logKV(Logger::Level::LOG_WARNING, FUNCTION_NAME, msg, __VA_ARGS__)
+  #define LOG_E_KV(msg, ...) Logger::getInstance().logKV(Logger::Level::LOG_ERROR, FUNCTION_NAME, msg, __VA_ARGS__)
+  #define LOG_C_KV(msg, ...) Logger::getInstance().logKV(Logger::Level::LOG_CRITICAL, FUNCTION_NAME, msg, __VA_ARGS__)
+
+  // Rate limited logging for per-frame paths, state is a static limiter per call site. The level is
+  // checked first, so filtered out levels neither touch the limiter nor use up its window.
+  //   LOG_I_EVERY_N(600, "frame {}", frame)        - 1st, 601st, 1201st... call of each thread
+  //   LOG_W_EVERY_MS(5000, "slow frame {}", ms)    - at most once per 5 s
+  //   LOG_E_RATE(2.0, 5, "GL error {}", err)       - token bucket, 2/s with bursts of 5
+  #define LOG_EVERY_N_IMPL(level, n, format, ...) do { static thread_local LogEveryN logSite_; std::uint64_t logSuppressed_ = 0; if (Logger::getInstance().isEnabled(level) && logSite_.shouldLog(n, logSuppressed_)) Logger::getInstance().logFmtSuppressed(level, logSuppressed_, format, FUNCTION_NAME, __VA_ARGS__); } while(0)
+  #define LOG_EVERY_MS_IMPL(level, ms, format, ...) do { static LogEveryMs logSite_; static thread_local LogTally logTally_ = 0; std::uint64_t logSuppressed_ = 0; if (Logger::getInstance().isEnabled(level) && logSite_.shouldLog(ms, logTally_, logSuppressed_)) Logger::getInstance().logFmtSuppressed(level, logSuppressed_, format, FUNCTION_NAME, __VA_ARGS__); } while(0)
+  #define LOG_RATE_IMPL(level, perSecond, burst, format, ...) do { static LogRateLimit logSite_; static thread_local LogTally logTally_ = 0; std::uint64_t logSuppressed_ = 0; if (Logger::getInstance().isEnabled(level) && logSite_.shouldLog(perSecond, burst, logTally_, logSuppressed_)) Logger::getInstance().logFmtSuppressed(level, logSuppressed_, format, FUNCTION_NAME, __VA_ARGS__); } while(0)
+
+  #define LOG_I_EVERY_N(n, format, ...) LOG_EVERY_N_IMPL(Logger::Level::LOG_INFO, n, format, __VA_ARGS__)
+  #define LOG_W_EVERY_N(n, format, ...) LOG_EVERY_N_IMPL(Logger::Level::LOG_WARNING, n, format, __VA_ARGS__)
+  #define LOG_E_EVERY_N(n, format, ...) LOG_EVERY_N_IMPL(Logger::Level::LOG_ERROR, n, format, __VA_ARGS__)
+
+  #define LOG_I_EVERY_MS(ms, format, ...) LOG_EVERY_MS_IMPL(Logger::Level::LOG_INFO, ms, format, __VA_ARGS__)
+  #define LOG_W_EVERY_MS(ms, format, ...) LOG_EVERY_MS_IMPL(Logger::Level::LOG_WARNING, ms, format, __VA_ARGS__)
+  #define LOG_E_EVERY_MS(ms, format, ...) LOG_EVERY_MS_IMPL(Logger::Level::LOG_ERROR, ms, format, __VA_ARGS__)
+
+  #define LOG_I_RATE(perSecond, burst, format, ...) LOG_RATE_IMPL(Logger::Level::LOG_INFO, perSecond, burst, format, __VA_ARGS__)
+  #define LOG_W_RATE(perSecond, burst, format, ...) LOG_RATE_IMPL(Logger::Level::LOG_WARNING, perSecond, burst, format, __VA_ARGS__)
+  #define LOG_E_RATE(perSecond, burst, format, ...) LOG_RATE_IMPL(Logger::Level::LOG_ERROR, perSecond, burst, format, __VA_ARGS__)
 // clang-format on
 
 #endif // LOGGER_HPP
\ No newline at end of file
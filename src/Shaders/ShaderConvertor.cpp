@@ -1,8 +1,42 @@
 #include "ShaderConvertor.hpp"
+#include <Utils/Profiler.hpp>
 #include <regex>
 #include <sstream>
 #include <algorithm>
 #include <set>
+#include <cmath>
+#include <string_view>
+
+namespace {
+  // Smyčky a konstanty s menším počtem kroků se nemění (barevné kanály, antialiasing, ...)
+  constexpr double kMinScaledBound = 16.0;
+  constexpr long kMinQualityBound = 8;
+
+  double qualityScale (ShaderQuality quality) {
+    switch (quality) {
+    case ShaderQuality::Low:
+      return 0.25;
+    case ShaderQuality::Medium:
+      return 0.5;
+    default:
+      return 1.0;
+    }
+  }
+
+  // Zkrácený literál ve stejném tvaru (int zůstane int, float float), false pokud se nemění
+  bool scaleLiteral (const std::string& literal, double scale, std::string& scaled) {
+    const double value = std::stod (literal);
+    if (value < kMinScaledBound) {
+      return false;
+    }
+    const long bound = std::max (kMinQualityBound, std::lround (value * scale));
+    scaled = std::to_string (bound);
+    if (literal.find_first_of (".eE") != std::string::npos) {
+      scaled += ".0";
+    }
+    return true;
+  }
+}
 
 ShaderConvertor::ShaderConvertor () {
   initializeFunctionReplacements ();
@@ -14,36 +48,77 @@ ShaderConvertor::~ShaderConvertor () {
 }
 
 ShaderConversionResult ShaderConvertor::convertFromShaderToy (const std::string& shaderToyCode,
-                                                              ShaderTarget target) {
+                                                              ShaderTarget target,
+                                                              ShaderQuality quality) {
   ShaderConversionResult result;
+  result.targetUsed = target;
+  result.qualityUsed = quality;
 
   try {
+    PROFILE_SCOPE ("ShaderConvertor::convertFromShaderToy");
+
     // 1. Analýza kódu před konverzí
-    auto analysis = analyzeShaderCode (shaderToyCode);
+    ShaderAnalysis analysis;
+    {
+      PROFILE_SCOPE ("Convert: analyze");
+      analysis = analyzeShaderCode (shaderToyCode);
+    }
 
     // 2. Získání vertex shaderu
     result.vertexShader = getVertexShader (target);
 
-    // 3. Začátek s hlavičkou fragment shaderu
-    std::string fragmentCode = convertShaderHeader (target);
-
-    // 4. Přidání uniformů (včetně detekovaných texture kanálů)
-    fragmentCode += convertUniforms (shaderToyCode, target, analysis);
+    std::string fragmentCode;
+    {
+      PROFILE_SCOPE ("Convert: header and uniforms");
+      // 3. Začátek s hlavičkou fragment shaderu
+      fragmentCode = convertShaderHeader (target);
+
+      // 4. Přidání uniformů (včetně detekovaných texture kanálů)
+      fragmentCode += convertUniforms (shaderToyCode, target, analysis);
+
+      // 5. Přidání chybějících definic
+      fragmentCode += addMissingDefines (shaderToyCode, target);
+
+      // Úroveň kvality, pokud si ji shader nedefinuje sám
+      if (std::regex_search (shaderToyCode, std::regex (R"(#\s*define\s+QUALITY\b)"))) {
+        result.conversionWarnings.push_back (
+            "Shader defines QUALITY itself, quality tier not injected");
+      } else {
+        fragmentCode += "#define QUALITY " + std::to_string (static_cast<int> (quality)) + "\n";
+      }
+    }
 
-    // 5. Přidání chybějících definic
-    fragmentCode += addMissingDefines (shaderToyCode, target);
+    // Zkrácení smyček a počtů kroků pro nižší úrovně kvality
+    std::string sourceCode;
+    {
+      PROFILE_SCOPE ("Convert: quality");
+      sourceCode = scaleForQuality (shaderToyCode, quality, result.qualityScaledBounds);
+    }
 
     // 6. Konverze ShaderToy built-ins
-    std::string processedCode = convertShaderToyBuiltins (shaderToyCode, target);
+    std::string processedCode;
+    {
+      PROFILE_SCOPE ("Convert: builtins");
+      processedCode = convertShaderToyBuiltins (sourceCode, target);
+    }
 
     // 7. Konverze mainImage funkce
-    processedCode = convertMainFunction (processedCode, target);
+    {
+      PROFILE_SCOPE ("Convert: mainImage");
+      processedCode = convertMainFunction (processedCode, target);
+    }
 
     // 8. Oprava kompatibility funkcí
-    processedCode = fixCompatibilityIssues (processedCode, target);
+    {
+      PROFILE_SCOPE ("Convert: compatibility fixes");
+      processedCode = fixCompatibilityIssues (processedCode, target);
+    }
 
     // 9. Finální úpravy podle analýzy
-    processedCode = applyAnalysisBasedFixes (processedCode, analysis, target);
+    {
+      PROFILE_SCOPE ("Convert: analysis fixes");
+      processedCode = applyAnalysisBasedFixes (processedCode, analysis, target);
+    }
 
     fragmentCode += processedCode;
 
@@ -464,6 +539,20 @@ ShaderAnalysis ShaderConvertor::analyzeShaderCode (const std::string& code) {
       = (code.find ("for(") != std::string::npos || code.find ("while(") != std::string::npos);
   analysis.hasConditionals = (code.find ("if(") != std::string::npos);
 
+  // Odhad ceny shaderu: smyčky a vzorkování textur jsou nejdražší, pak transcendentní funkce
+  auto countMatches = [&code, &end] (const char* pattern) {
+    std::regex regex (pattern);
+    return static_cast<int> (
+        std::distance (std::sregex_iterator (code.begin (), code.end (), regex), end));
+  };
+  const int loops = countMatches (R"(\b(for|while)\s*\()");
+  const int samples = countMatches (R"(\b(texture|texture2D|textureLod|texelFetch)\s*\()");
+  const int transcendental = countMatches (R"(\b(sin|cos|tan|atan|pow|exp|log|sqrt)\s*\()");
+  const int statements = static_cast<int> (std::count (code.begin (), code.end (), ';'));
+  analysis.estimatedInstructions
+      = static_cast<size_t> (statements + transcendental * 4 + samples * 8);
+  analysis.complexityScore = statements + transcendental * 2 + samples * 4 + loops * 16;
+
   // Přidání varování pro potenciální problémy
   if (analysis.hasComplexMath) {
     analysis.warnings.push_back (
@@ -473,6 +562,76 @@ ShaderAnalysis ShaderConvertor::analyzeShaderCode (const std::string& code) {
   return analysis;
 }
 
+std::string ShaderConvertor::scaleForQuality (const std::string& code, ShaderQuality quality,
+                                              int& scaledBounds) {
+  scaledBounds = 0;
+  const double scale = qualityScale (quality);
+  if (scale >= 1.0) {
+    return code;
+  }
+
+  // Literál na konci podmínky smyčky: i < 64; i++ < 1e2; i < 256 && t < tmax
+  static const std::regex forRegex (R"(\bfor\s*\()");
+  static const std::regex boundRegex (
+      R"(<=?\s*([0-9]+\.?[0-9]*(?:[eE][0-9]+)?)(?=\s*(?:&&|\|\||$)))");
+  std::string scaledCode;
+  scaledCode.reserve (code.size ());
+  std::size_t copied = 0;
+  for (std::sregex_iterator it (code.begin (), code.end (), forRegex), end; it != end; ++it) {
+    const std::size_t first = code.find (';', static_cast<std::size_t> (it->position ()));
+    const std::size_t second = first == std::string::npos ? first : code.find (';', first + 1);
+    if (second == std::string::npos || first < copied) {
+      continue;
+    }
+    const std::string condition = code.substr (first + 1, second - first - 1);
+    std::smatch match;
+    std::string scaled;
+    // Hlavička smyčky nemá složené závorky, jinak "for (" bylo v komentáři
+    if (condition.find_first_of ("{}") != std::string::npos
+        || !std::regex_search (condition, match, boundRegex)
+        || !scaleLiteral (match.str (1), scale, scaled)) {
+      continue;
+    }
+    const std::size_t literal = first + 1 + static_cast<std::size_t> (match.position (1));
+    scaledCode.append (code, copied, literal - copied);
+    scaledCode += scaled;
+    copied = literal + static_cast<std::size_t> (match.length (1));
+    ++scaledBounds;
+  }
+  scaledCode.append (code, copied, std::string::npos);
+
+  // Pojmenované počty kroků: #define MAX_STEPS 96, const int NUM_STEPS = 32;
+  static const std::regex constantRegex (
+      R"(^(\s*(?:#\s*define\s+|const\s+(?:int|float)\s+)(\w+)(?:\s*=\s*|\s+))([0-9]+\.?[0-9]*))"
+      R"((\s*;?\s*(?://.*)?)$)");
+  static const std::regex stepNameRegex ("STEP|ITER|MARCH|SAMPLE", std::regex::icase);
+  std::string result;
+  result.reserve (scaledCode.size ());
+  std::size_t lineStart = 0;
+  while (lineStart < scaledCode.size ()) {
+    std::size_t lineEnd = scaledCode.find ('\n', lineStart);
+    if (lineEnd == std::string::npos) {
+      lineEnd = scaledCode.size ();
+    }
+    const std::string line = scaledCode.substr (lineStart, lineEnd - lineStart);
+    std::smatch match;
+    std::string scaled;
+    if (std::regex_match (line, match, constantRegex)
+        && std::regex_search (match.str (2), stepNameRegex)
+        && scaleLiteral (match.str (3), scale, scaled)) {
+      result += match.str (1) + scaled + match.str (4);
+      ++scaledBounds;
+    } else {
+      result += line;
+    }
+    if (lineEnd < scaledCode.size ()) {
+      result += '\n';
+    }
+    lineStart = lineEnd + 1;
+  }
+  return result;
+}
+
 void ShaderConvertor::initializeFunctionReplacements () {
   // WebGL1 náhrady (OpenGL ES 2.0)
   functionReplacements[ShaderTarget::WebGL1]["textureLod"] = "texture2DLodEXT";
@@ -532,6 +691,16 @@ void ShaderConvertor::initializeBuiltinReplacements () {
 std::string ShaderConvertor::generateHeaderFile (const std::string& shaderToyCode,
                                                  const std::string& shaderName,
                                                  const std::vector<ShaderTarget>& targets) {
+  std::vector<ShaderConversionResult> results;
+  results.reserve (targets.size ());
+  for (const auto& target : targets) {
+    results.push_back (convertFromShaderToy (shaderToyCode, target));
+  }
+  return generateHeaderFile (results, shaderName);
+}
+
+std::string ShaderConvertor::generateHeaderFile (const std::vector<ShaderConversionResult>& results,
+                                                 const std::string& shaderName) {
   std::ostringstream headerStream;
 
   // Generate header preamble
@@ -539,10 +708,9 @@ std::string ShaderConvertor::generateHeaderFile (const std::string& shaderToyCod
   headerStream << "#define __" << shaderName << "_H__\n\n";
 
   // Generate shaders for each target
-  for (const auto& target : targets) {
-    auto result = convertFromShaderToy (shaderToyCode, target);
+  for (const auto& result : results) {
     if (result.success) {
-      std::string suffix = getTargetSuffix (target);
+      std::string suffix = getTargetSuffix (result.targetUsed);
 
       // Vertex shader
       headerStream << "const char* vertexShader" << suffix << " = R\"(\n";
@@ -686,6 +854,19 @@ std::string ShaderConvertor::simplifyPrecision (const std::string& code) {
 // === NAMESPACE UTILITY FUNCTIONS ===
 
 namespace ShaderUtils {
+  const char* getShaderQualityString (ShaderQuality quality) {
+    switch (quality) {
+    case ShaderQuality::Low:
+      return "Low";
+    case ShaderQuality::Medium:
+      return "Medium";
+    case ShaderQuality::High:
+      return "High";
+    default:
+      return "Unknown";
+    }
+  }
+
   std::string getShaderTargetString (ShaderTarget target) {
     switch (target) {
     case ShaderTarget::WebGL1:
@@ -1,6 +1,7 @@
 #ifndef SHADERCONVERTOR_HPP
 #define SHADERCONVERTOR_HPP
 
+#include <cstddef>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,6 +15,16 @@ enum class ShaderTarget {
   Desktop420  // OpenGL 4.2+
 };
 
+// Kvalita převedeného shaderu, v kódu dostupná jako "#define QUALITY n" (0 = Low, 2 = High).
+// Nižší úrovně navíc zkracují smyčky a počty kroků (raymarching), které zdroj vystavuje jako
+// literál nebo pojmenovanou konstantu; High zdroj nemění.
+enum class ShaderQuality {
+  Low,    // čtvrtina kroků
+  Medium, // polovina kroků
+  High    // původní shader
+};
+constexpr std::size_t kShaderQualityCount = 3;
+
 struct ShaderAnalysis {
   bool hasComplexMath = false;
   bool hasMultiDeclarations = false;
@@ -44,6 +55,9 @@ struct ShaderConversionResult {
   std::string errorMessage;
   ShaderAnalysis analysis;
   ShaderTarget targetUsed;
+  ShaderQuality qualityUsed = ShaderQuality::High;
+  // Počet zkrácených smyček a konstant; 0 znamená, že se úrovně liší jen hodnotou QUALITY
+  int qualityScaledBounds = 0;
 
   // Dodatečné informace pro debugging
   std::vector<std::string> conversionWarnings;
@@ -57,7 +71,8 @@ public:
 
   // Hlavní funkce pro konverzi ShaderToy shaderu
   ShaderConversionResult convertFromShaderToy (const std::string& shaderToyCode,
-                                               ShaderTarget target = ShaderTarget::Desktop330);
+                                               ShaderTarget target = ShaderTarget::Desktop330,
+                                               ShaderQuality quality = ShaderQuality::High);
 
   // Statické funkce pro generování základních vertex shaderů
   static std::string getVertexShader (ShaderTarget target);
@@ -67,6 +82,9 @@ public:
                                   const std::vector<ShaderTarget>& targets
                                   = { ShaderTarget::WebGL1, ShaderTarget::WebGL2,
                                       ShaderTarget::Desktop330 });
+  // Stejný header z již provedených konverzí (neúspěšné se vynechají)
+  std::string generateHeaderFile (const std::vector<ShaderConversionResult>& results,
+                                  const std::string& shaderName);
 
   // Funkce pro validaci a analýzu ShaderToy kódu
   ShaderAnalysis analyzeShaderCode (const std::string& code);
@@ -117,6 +135,8 @@ private:
   std::string fixMultiDeclarations (const std::string& code);
   std::string optimizeComplexMath (const std::string& code);
   std::string simplifyLoops (const std::string& code);
+  // Zkrácení smyček a počtů kroků pro nižší úroveň kvality, vrací počet změn v scaledBounds
+  std::string scaleForQuality (const std::string& code, ShaderQuality quality, int& scaledBounds);
 
   // === Analysis methods ===
 
@@ -197,6 +217,7 @@ private:
 namespace ShaderUtils {
   // Utility funkce mimo třídu pro snadnější použití
   std::string getShaderTargetString (ShaderTarget target);
+  const char* getShaderQualityString (ShaderQuality quality);
   ShaderTarget parseShaderTarget (const std::string& targetStr);
   bool isWebGLTarget (ShaderTarget target);
   bool isDesktopTarget (ShaderTarget target);
@@ -0,0 +1,119 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "ShaderRegistry.hpp"
+#include "Logger/Logger.hpp"
+#include <Utils/Profiler.hpp>
+
+// fullfilled from ../cmake/tmplt-shaders.cmake - every Shadertoy/*.hpp as { name, source }
+#ifdef SHADERTOY_SOURCES_HEADER
+  #include SHADERTOY_SOURCES_HEADER
+#endif
+
+ShaderRegistry::Shader::Shader (std::string name, std::string_view source)
+    : name_ (std::move (name)), source_ (source) {
+}
+
+const ShaderRegistry::Shader::Metadata& ShaderRegistry::Shader::metadata () const {
+  std::call_once (metadataOnce_, [this] {
+    const PrecompiledShader* table = ShaderTable::find (name_);
+    if (table != nullptr && table->sourceHash == ShaderTable::hash (source_)) {
+      metadata_.cost = table->analysis.complexityScore;
+      for (unsigned channel = 0; channel < 8; ++channel) {
+        if (table->analysis.channelMask & (1u << channel)) {
+          metadata_.channels.push_back ("iChannel" + std::to_string (channel));
+        }
+      }
+      metadata_.precompiled = true;
+      return;
+    }
+    PROFILE_SCOPE ("ShaderRegistry: analyze");
+    ShaderConvertor convertor;
+    ShaderAnalysis analysis = convertor.analyzeShaderCode (std::string (source_));
+    metadata_.cost = analysis.complexityScore;
+    metadata_.channels = std::move (analysis.textureChannels);
+  });
+  return metadata_;
+}
+
+int ShaderRegistry::Shader::cost () const {
+  return metadata ().cost;
+}
+
+const std::vector<std::string>& ShaderRegistry::Shader::channels () const {
+  return metadata ().channels;
+}
+
+bool ShaderRegistry::Shader::precompiled () const {
+  return metadata ().precompiled;
+}
+
+const ShaderConversionResult& ShaderRegistry::Shader::conversion (ShaderTarget target,
+                                                                  ShaderQuality quality) const {
+  const std::size_t tier = static_cast<std::size_t> (quality);
+  const std::size_t index = static_cast<std::size_t> (target);
+  ShaderConversionResult& result = conversions_[tier][index];
+  std::call_once (conversionOnce_[tier][index], [this, target, quality, tier, index, &result] {
+    if (quality == ShaderQuality::High) {
+      if (auto precompiled = ShaderTable::lookup (name_, source_, target)) {
+        result = std::move (*precompiled);
+        converted_[tier][index].store (true, std::memory_order_release);
+        return;
+      }
+    }
+    PROFILE_SCOPE ("ShaderRegistry: convert");
+    LOG_D_STREAM << "Converting shader " << name_ << " for "
+                 << ShaderUtils::getShaderTargetString (target) << " ("
+                 << ShaderUtils::getShaderQualityString (quality) << ") at runtime" << std::endl;
+    ShaderConvertor convertor;
+    result = convertor.convertFromShaderToy (std::string (source_), target, quality);
+    converted_[tier][index].store (true, std::memory_order_release);
+  });
+  return result;
+}
+
+bool ShaderRegistry::Shader::converted (ShaderTarget target, ShaderQuality quality) const {
+  return converted_[static_cast<std::size_t> (quality)][static_cast<std::size_t> (target)].load (
+      std::memory_order_acquire);
+}
+
+ShaderRegistry& ShaderRegistry::instance () {
+  static ShaderRegistry& registry = [] () -> ShaderRegistry& {
+    static ShaderRegistry bundled;
+#ifdef SHADERTOY_SOURCES_HEADER
+    for (const ShadertoySources::Entry& entry : ShadertoySources::kBundled) {
+      bundled.add (entry.name, *entry.source);
+    }
+#endif
+    return bundled;
+  }();
+  return registry;
+}
+
+bool ShaderRegistry::add (std::string name, std::string_view source) {
+  std::lock_guard<std::mutex> lock (mutex_);
+  if (byName_.count (name) != 0) {
+    LOG_W_STREAM << "Shader " << name << " is already registered" << std::endl;
+    return false;
+  }
+  shaders_.push_back (std::make_unique<Shader> (std::move (name), source));
+  const Shader* shader = shaders_.back ().get ();
+  byName_.emplace (shader->name (), shader);
+  return true;
+}
+
+const ShaderRegistry::Shader* ShaderRegistry::find (std::string_view name) const {
+  std::lock_guard<std::mutex> lock (mutex_);
+  const auto it = byName_.find (name);
+  return it != byName_.end () ? it->second : nullptr;
+}
+
+std::size_t ShaderRegistry::size () const {
+  std::lock_guard<std::mutex> lock (mutex_);
+  return shaders_.size ();
+}
+
+const ShaderRegistry::Shader& ShaderRegistry::at (std::size_t index) const {
+  std::lock_guard<std::mutex> lock (mutex_);
+  return *shaders_[index];
+}
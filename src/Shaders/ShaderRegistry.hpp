@@ -0,0 +1,113 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// ShaderToy shaders by name, with their metadata and cached conversions
+
+#ifndef __SHADERREGISTRY_H__
+#define __SHADERREGISTRY_H__
+
+#include "ShaderConvertor.hpp"
+#include "ShaderTable.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// One place that knows every shader. The bundled ones (src/Shaders/Shadertoy/*.hpp, listed by
+// cmake/tmplt-shaders.cmake) are registered when instance () is first used, so consumers that
+// iterate during static initialization (benchmark registration) see them; other code adds its
+// own with REGISTER_SHADERTOY. Lookups by name are a hash map hit.
+//
+// Metadata and conversions are computed on first use and then shared by every consumer: from
+// the build-time ShaderTable when it holds the shader, otherwise by ShaderConvertor. Both are
+// safe to request from several threads.
+class ShaderRegistry {
+public:
+  class Shader {
+  public:
+    Shader (std::string name, std::string_view source);
+    Shader (const Shader&) = delete;
+    Shader& operator= (const Shader&) = delete;
+
+    const std::string& name () const {
+      return name_;
+    }
+
+    std::string_view source () const {
+      return source_;
+    }
+
+    // ShaderAnalysis::complexityScore, a relative cost for picking and budgeting
+    int cost () const;
+    // Texture channels the shader samples ("iChannel0", ...)
+    const std::vector<std::string>& channels () const;
+    // True when the conversions come from the build-time table
+    bool precompiled () const;
+
+    // High comes from the build-time table when possible, lower tiers are converted on demand
+    const ShaderConversionResult& conversion (ShaderTarget target,
+                                              ShaderQuality quality = ShaderQuality::High) const;
+    // True when conversion () returns without converting (or waiting for another thread to)
+    bool converted (ShaderTarget target, ShaderQuality quality = ShaderQuality::High) const;
+
+  private:
+    struct Metadata {
+      int cost = 0;
+      std::vector<std::string> channels;
+      bool precompiled = false;
+    };
+
+    const Metadata& metadata () const;
+
+    std::string name_;
+    std::string_view source_;
+    mutable std::once_flag metadataOnce_;
+    mutable Metadata metadata_;
+    mutable std::once_flag conversionOnce_[kShaderQualityCount][kShaderTargetCount];
+    mutable ShaderConversionResult conversions_[kShaderQualityCount][kShaderTargetCount];
+    mutable std::atomic<bool> converted_[kShaderQualityCount][kShaderTargetCount] = {};
+  };
+
+  // Registers on construction, for REGISTER_SHADERTOY
+  struct Registrar {
+    Registrar (const char* name, const char* source) {
+      ShaderRegistry::instance ().add (name, source);
+    }
+  };
+
+  ShaderRegistry () = default;
+  ShaderRegistry (const ShaderRegistry&) = delete;
+  ShaderRegistry& operator= (const ShaderRegistry&) = delete;
+
+  // The process wide registry, bundled shaders included
+  static ShaderRegistry& instance ();
+
+  // The source is referenced, not copied, and has to outlive the registry (string literals).
+  // Returns false when the name is taken.
+  bool add (std::string name, std::string_view source);
+
+  const Shader* find (std::string_view name) const;
+
+  // Registration order; shaders are never removed, references stay valid
+  std::size_t size () const;
+  const Shader& at (std::size_t index) const;
+
+private:
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<Shader>> shaders_;
+  std::unordered_map<std::string_view, const Shader*> byName_; // keys point into shaders_
+};
+
+#define SHADER_REGISTRY_CONCAT_(a, b) a##b
+#define SHADER_REGISTRY_CONCAT(a, b) SHADER_REGISTRY_CONCAT_ (a, b)
+
+// REGISTER_SHADERTOY ("Plasma", fragmentShaderToyPlasma); at namespace scope of any .cpp
+#define REGISTER_SHADERTOY(name, source)                                                        \
+  static const ShaderRegistry::Registrar SHADER_REGISTRY_CONCAT (shaderRegistrar_, __LINE__) (  \
+      name, source)
+
+#endif // __SHADERREGISTRY_H__
@@ -0,0 +1,205 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "ShaderTable.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <sstream>
+#include <stdexcept>
+
+// fullfilled from ../cmake/tmplt-shaders.cmake - the precompiled shader table
+#ifdef SHADER_TABLE_HEADER
+  #include SHADER_TABLE_HEADER
+#endif
+
+namespace {
+#ifdef SHADER_TABLE_HEADER
+  const PrecompiledShader* const tableBegin = std::begin (ShaderTableData::kShaders);
+  const std::size_t tableSize = std::size (ShaderTableData::kShaders);
+#else
+  const PrecompiledShader* const tableBegin = nullptr;
+  const std::size_t tableSize = 0;
+#endif
+
+  constexpr std::string_view kDefinition = "const char* fragmentShaderToy";
+  constexpr std::string_view kDelimiter = "glsl";
+  constexpr std::size_t kLiteralChunk = 4096; // MSVC rejects single literals over 16 KiB
+
+  // Adjacent raw literals, so nothing in the GLSL needs escaping
+  std::string rawLiteral (std::string_view text) {
+    const std::string terminator = ")" + std::string (kDelimiter) + "\"";
+    if (text.find (terminator) != std::string_view::npos) {
+      throw std::runtime_error ("shader source contains the raw string terminator " + terminator);
+    }
+    if (text.empty ()) {
+      return "\"\"";
+    }
+    std::string literal;
+    std::size_t offset = 0;
+    while (offset < text.size ()) {
+      // Never split a UTF-8 sequence (the sources carry author names in comments)
+      std::size_t end = std::min (offset + kLiteralChunk, text.size ());
+      while (end < text.size () && end > offset + 1
+             && (static_cast<unsigned char> (text[end]) & 0xC0) == 0x80) {
+        --end;
+      }
+      if (offset > 0) {
+        literal += "\n          ";
+      }
+      literal += "R\"" + std::string (kDelimiter) + "(";
+      literal += text.substr (offset, end - offset);
+      literal += terminator;
+      offset = end;
+    }
+    return literal;
+  }
+
+  std::string hexLiteral (std::uint64_t value) {
+    std::ostringstream out;
+    out << "0x" << std::hex << std::setw (16) << std::setfill ('0') << value << "ull";
+    return out.str ();
+  }
+} // namespace
+
+namespace ShaderTable {
+  std::size_t size () {
+    return tableSize;
+  }
+
+  const PrecompiledShader& at (std::size_t index) {
+    return tableBegin[index];
+  }
+
+  const PrecompiledShader* find (std::string_view name) {
+    const PrecompiledShader* end = tableBegin + tableSize;
+    const PrecompiledShader* it
+        = std::lower_bound (tableBegin, end, name, [] (const PrecompiledShader& shader,
+                                                       std::string_view key) {
+            return shader.name < key;
+          });
+    return it != end && it->name == name ? it : nullptr;
+  }
+
+  std::optional<ShaderConversionResult> lookup (std::string_view name, std::string_view source,
+                                                ShaderTarget target) {
+    const PrecompiledShader* shader = find (name);
+    if (shader == nullptr || shader->sourceHash != hash (source)) {
+      return std::nullopt;
+    }
+    const PrecompiledShaderVariant& variant = shader->variant (target);
+    ShaderConversionResult result;
+    result.targetUsed = target;
+    result.success = variant.ok ();
+    result.vertexShader = variant.vertex;
+    result.fragmentShader = variant.fragment;
+    result.errorMessage = variant.error;
+    result.analysis.complexityScore = shader->analysis.complexityScore;
+    result.analysis.estimatedInstructions = shader->analysis.estimatedInstructions;
+    for (unsigned channel = 0; channel < 8; ++channel) {
+      if (shader->analysis.channelMask & (1u << channel)) {
+        result.analysis.textureChannels.push_back ("iChannel" + std::to_string (channel));
+      }
+    }
+    result.analysis.hasTextureChannels = shader->analysis.channelMask != 0;
+    result.analysis.hasLoops = shader->analysis.hasLoops;
+    result.analysis.hasConditionals = shader->analysis.hasConditionals;
+    result.analysis.hasComplexMath = shader->analysis.hasComplexMath;
+    result.analysis.hasAdvancedGLSL = shader->analysis.hasAdvancedGLSL;
+    result.analysis.hasAudioFeatures = shader->analysis.hasAudioFeatures;
+    return result;
+  }
+
+  std::optional<Source> extractSource (std::string_view header) {
+    const std::size_t definition = header.find (kDefinition);
+    if (definition == std::string_view::npos) {
+      return std::nullopt;
+    }
+    const std::size_t nameBegin = definition + kDefinition.size ();
+    std::size_t nameEnd = nameBegin;
+    while (nameEnd < header.size ()
+           && (std::isalnum (static_cast<unsigned char> (header[nameEnd]))
+               || header[nameEnd] == '_')) {
+      ++nameEnd;
+    }
+    const std::string_view name = header.substr (nameBegin, nameEnd - nameBegin);
+    if (name.empty () || name == "Template") {
+      return std::nullopt;
+    }
+
+    // R"delimiter( ... )delimiter"
+    const std::size_t raw = header.find ("R\"", nameEnd);
+    const std::size_t open = raw == std::string_view::npos ? raw : header.find ('(', raw);
+    if (open == std::string_view::npos) {
+      return std::nullopt;
+    }
+    const std::string terminator
+        = ")" + std::string (header.substr (raw + 2, open - raw - 2)) + "\"";
+    const std::size_t close = header.find (terminator, open + 1);
+    if (close == std::string_view::npos) {
+      return std::nullopt;
+    }
+    return Source{ std::string (name), std::string (header.substr (open + 1, close - open - 1)) };
+  }
+
+  std::string generateHeader (std::vector<Source> sources) {
+    std::sort (sources.begin (), sources.end (),
+               [] (const Source& a, const Source& b) { return a.name < b.name; });
+    const auto duplicate
+        = std::adjacent_find (sources.begin (), sources.end (),
+                              [] (const Source& a, const Source& b) { return a.name == b.name; });
+    if (duplicate != sources.end ()) {
+      throw std::runtime_error ("shader defined twice: " + duplicate->name);
+    }
+
+    std::ostringstream out;
+    out << "// Generated by tools/ShaderTableTool.cpp - do not edit\n"
+        << "#ifndef SHADERS_GENERATED_SHADER_TABLE_HPP\n"
+        << "#define SHADERS_GENERATED_SHADER_TABLE_HPP\n\n"
+        << "#include \"Shaders/ShaderTable.hpp\"\n\n"
+        << "namespace ShaderTableData {\n"
+        << "  // Sorted by name, variants in ShaderTarget order\n"
+        << "  inline constexpr PrecompiledShader kShaders[] = {\n";
+
+    ShaderConvertor convertor;
+    for (const Source& source : sources) {
+      const ShaderAnalysis analysis = convertor.analyzeShaderCode (source.code);
+      unsigned channelMask = 0;
+      for (const std::string& channel : analysis.textureChannels) {
+        const int index = std::atoi (channel.c_str () + std::string_view ("iChannel").size ());
+        channelMask |= index >= 0 && index < 8 ? 1u << index : 0u;
+      }
+      out << "    { \"" << source.name << "\", " << hexLiteral (hash (source.code)) << ",\n"
+          << "      { " << analysis.complexityScore << ", " << analysis.estimatedInstructions
+          << "u, " << channelMask << "u, " << std::boolalpha
+          << analysis.hasLoops << ", " << analysis.hasConditionals << ", "
+          << analysis.hasComplexMath << ", " << analysis.hasAdvancedGLSL << ", "
+          << analysis.hasAudioFeatures << " },\n"
+          << "      {\n";
+      for (std::size_t target = 0; target < kShaderTargetCount; ++target) {
+        const ShaderConversionResult result
+            = convertor.convertFromShaderToy (source.code, static_cast<ShaderTarget> (target));
+        const std::string error
+            = result.success ? std::string ()
+                             : (result.errorMessage.empty () ? "conversion failed"
+                                                             : result.errorMessage);
+        const std::uint64_t variantHash
+            = result.success ? hash (result.fragmentShader, hash (result.vertexShader)) : 0;
+        out << "        { // "
+            << ShaderUtils::getShaderTargetString (static_cast<ShaderTarget> (target)) << "\n"
+            << "          " << rawLiteral (result.success ? result.vertexShader : "") << ",\n"
+            << "          " << rawLiteral (result.success ? result.fragmentShader : "") << ",\n"
+            << "          " << hexLiteral (variantHash) << ", " << rawLiteral (error) << " },\n";
+      }
+      out << "      } },\n";
+    }
+
+    out << "  };\n"
+        << "} // namespace ShaderTableData\n\n"
+        << "#endif // SHADERS_GENERATED_SHADER_TABLE_HPP\n";
+    return out.str ();
+  }
+} // namespace ShaderTable
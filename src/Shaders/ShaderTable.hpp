@@ -0,0 +1,95 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Bundled ShaderToy shaders converted for every ShaderTarget at build time
+
+#ifndef __SHADERTABLE_H__
+#define __SHADERTABLE_H__
+
+#include "ShaderConvertor.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// cmake/tmplt-shaders.cmake runs tools/ShaderTableTool.cpp over src/Shaders/Shadertoy/*.hpp and
+// compiles the result into CoreLib (SHADER_TABLE_HEADER). Every entry holds the converted
+// sources for all targets at ShaderQuality::High, so the runtime only looks them up and
+// compiles; lower quality tiers are converted when first asked for. Builds without the table
+// (cross compiling, Emscripten without a host tool) and sources that changed since the table was
+// generated fall back to converting at runtime.
+
+inline constexpr std::size_t kShaderTargetCount = 4; // indexed by static_cast<int> (ShaderTarget)
+
+struct PrecompiledShaderVariant {
+  std::string_view vertex;
+  std::string_view fragment;
+  std::uint64_t hash = 0; // ShaderTable::hash over vertex then fragment, 0 when failed
+  std::string_view error; // conversion error, empty on success
+
+  constexpr bool ok () const {
+    return error.empty ();
+  }
+};
+
+// The part of ShaderAnalysis the runtime uses to pick and budget shaders
+struct PrecompiledShaderAnalysis {
+  int complexityScore = 0;
+  std::size_t estimatedInstructions = 0;
+  std::uint8_t channelMask = 0; // bit i set when iChannel<i> is used
+  bool hasLoops = false;
+  bool hasConditionals = false;
+  bool hasComplexMath = false;
+  bool hasAdvancedGLSL = false;
+  bool hasAudioFeatures = false;
+};
+
+struct PrecompiledShader {
+  std::string_view name;   // "DyingUniverse" for fragmentShaderToyDyingUniverse
+  std::uint64_t sourceHash = 0; // ShaderTable::hash of the ShaderToy source
+  PrecompiledShaderAnalysis analysis;
+  PrecompiledShaderVariant variants[kShaderTargetCount];
+
+  constexpr const PrecompiledShaderVariant& variant (ShaderTarget target) const {
+    return variants[static_cast<std::size_t> (target)];
+  }
+};
+
+namespace ShaderTable {
+  // 64-bit FNV-1a, continuing from seed
+  constexpr std::uint64_t hash (std::string_view data,
+                                std::uint64_t seed = 0xcbf29ce484222325ull) {
+    std::uint64_t value = seed;
+    for (const char c : data) {
+      value = (value ^ static_cast<unsigned char> (c)) * 0x100000001b3ull;
+    }
+    return value;
+  }
+
+  // Runtime side. Entries are sorted by name; without the generated table there are none.
+  std::size_t size ();
+  const PrecompiledShader& at (std::size_t index);
+  const PrecompiledShader* find (std::string_view name);
+
+  // Converted sources of a bundled shader: from the table when it has the shader and its
+  // source hash still matches, otherwise std::nullopt and the caller converts at runtime
+  std::optional<ShaderConversionResult> lookup (std::string_view name, std::string_view source,
+                                                ShaderTarget target);
+
+  // Build side, used by tools/ShaderTableTool.cpp
+  struct Source {
+    std::string name;
+    std::string code;
+  };
+
+  // Finds `const char* fragmentShaderToy<Name> = R"(...)";` in a Shadertoy/*.hpp file. Templates
+  // (fragmentShaderToyTemplate) and files without such a definition give std::nullopt.
+  std::optional<Source> extractSource (std::string_view header);
+
+  // Converts every source for every target and returns the generated header, sorted by name
+  std::string generateHeader (std::vector<Source> sources);
+} // namespace ShaderTable
+
+#endif // __SHADERTABLE_H__
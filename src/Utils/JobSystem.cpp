@@ -0,0 +1,230 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "JobSystem.hpp"
+#include "Logger/Logger.hpp"
+#include <Utils/Profiler.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <string>
+
+namespace {
+  thread_local const JobSystem* tlsSystem = nullptr; // set on worker threads
+  thread_local std::size_t tlsWorker = 0;
+  thread_local std::uint32_t tlsVictim = 0;
+
+  std::atomic<std::size_t> sharedWorkers{ SIZE_MAX };
+}
+
+JobSystem::JobSystem (std::size_t workers) {
+  // Every deque exists before the first worker may steal from it
+  deques_.reserve (workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    deques_.push_back (std::make_unique<WorkStealingDeque<Task>> ());
+  }
+  workers_.reserve (workers);
+  for (std::size_t i = 0; i < workers; ++i) {
+    workers_.emplace_back ([this, i] { workerLoop (i); });
+  }
+}
+
+JobSystem::~JobSystem () {
+  {
+    std::lock_guard<std::mutex> lock (sleepMutex_);
+    stopping_.store (true);
+  }
+  wake_.notify_all ();
+  for (std::thread& worker : workers_) {
+    worker.join ();
+  }
+  while (Task* task = findWork ()) {
+    execute (task);
+  }
+  drainMainThread ();
+}
+
+std::size_t JobSystem::defaultWorkerCount () {
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+  return 0;
+#else
+  // The waiting thread runs jobs too
+  const std::size_t cores = std::max (1u, std::thread::hardware_concurrency ());
+  return std::min<std::size_t> (cores - 1, 15);
+#endif
+}
+
+JobSystem& JobSystem::shared () {
+  static JobSystem system (sharedWorkers.load () != SIZE_MAX ? sharedWorkers.load ()
+                                                              : defaultWorkerCount ());
+  return system;
+}
+
+void JobSystem::setSharedWorkerCount (std::size_t workers) {
+  sharedWorkers.store (workers);
+}
+
+bool JobSystem::isWorkerThread () const {
+  return tlsSystem == this;
+}
+
+void JobSystem::run (Job job, Counter* counter, Counter* dependency) {
+  Task* task = new Task{ std::move (job), counter };
+  if (counter != nullptr) {
+    counter->pending_.fetch_add (1, std::memory_order_relaxed);
+  }
+  if (dependency != nullptr) {
+    std::lock_guard<std::mutex> lock (dependency->mutex_);
+    if (!dependency->done ()) {
+      dependency->deferred_.push_back (task); // submitted by the job that zeroes it
+      return;
+    }
+  }
+  submit (task);
+}
+
+void JobSystem::submit (Task* task) {
+  if (isWorkerThread ()) {
+    if (!deques_[tlsWorker]->push (task)) {
+      execute (task); // deque full, the spawning job was going to wait for it anyway
+      return;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock (injectMutex_);
+    injected_.push_back (task);
+    injectedCount_.fetch_add (1);
+  }
+  wakeOne ();
+}
+
+void JobSystem::wakeOne () {
+  // Pairs with the fence in workerLoop: either the sleeper sees the job or we see the sleeper
+  std::atomic_thread_fence (std::memory_order_seq_cst);
+  if (sleepers_.load () > 0) {
+    std::lock_guard<std::mutex> lock (sleepMutex_);
+    wake_.notify_one ();
+  }
+}
+
+void JobSystem::execute (Task* task) {
+  try {
+    task->job ();
+  } catch (const std::exception& e) {
+    LOG_E_FMT ("Job failed: {}", e.what ());
+  }
+  Counter* counter = task->counter;
+  delete task;
+  if (counter == nullptr) {
+    return;
+  }
+
+  std::vector<Task*> ready;
+  {
+    // Decremented under the lock: wait () takes it before returning, so the counter cannot be
+    // destroyed while we still touch it
+    std::lock_guard<std::mutex> lock (counter->mutex_);
+    if (counter->pending_.fetch_sub (1, std::memory_order_acq_rel) == 1) {
+      ready.swap (counter->deferred_);
+      counter->zero_.notify_all ();
+    }
+  }
+  for (Task* deferred : ready) {
+    submit (deferred);
+  }
+}
+
+JobSystem::Task* JobSystem::findWork () {
+  const bool worker = isWorkerThread ();
+  if (worker) {
+    if (Task* task = deques_[tlsWorker]->pop ()) {
+      return task;
+    }
+  }
+  if (injectedCount_.load () > 0) {
+    std::lock_guard<std::mutex> lock (injectMutex_);
+    if (!injected_.empty ()) {
+      Task* task = injected_.front ();
+      injected_.pop_front ();
+      injectedCount_.fetch_sub (1);
+      return task;
+    }
+  }
+  const std::size_t count = deques_.size ();
+  const std::size_t start = tlsVictim++;
+  for (std::size_t i = 0; i < count; ++i) {
+    const std::size_t victim = (start + i) % count;
+    if (worker && victim == tlsWorker) {
+      continue;
+    }
+    if (Task* task = deques_[victim]->steal ()) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool JobSystem::hasWork () const {
+  if (injectedCount_.load () > 0) {
+    return true;
+  }
+  for (const auto& deque : deques_) {
+    if (!deque->empty ()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void JobSystem::workerLoop (std::size_t index) {
+  PROFILE_THREAD ("Job worker " + std::to_string (index));
+  tlsSystem = this;
+  tlsWorker = index;
+  tlsVictim = static_cast<std::uint32_t> (index + 1);
+
+  while (true) {
+    if (Task* task = findWork ()) {
+      execute (task);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock (sleepMutex_);
+    sleepers_.fetch_add (1);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    wake_.wait (lock, [this] { return stopping_.load () || hasWork (); });
+    sleepers_.fetch_sub (1);
+    if (stopping_.load () && !hasWork ()) {
+      return;
+    }
+  }
+}
+
+void JobSystem::wait (const Counter& counter) {
+  while (!counter.done ()) {
+    if (Task* task = findWork ()) {
+      execute (task);
+      continue;
+    }
+    // Nothing to help with; the remaining jobs run elsewhere or may still spawn work
+    std::unique_lock<std::mutex> lock (counter.mutex_);
+    counter.zero_.wait_for (lock, std::chrono::milliseconds (1), [&] { return counter.done (); });
+  }
+  std::lock_guard<std::mutex> lock (counter.mutex_);
+}
+
+void JobSystem::runOnMainThread (Job job) {
+  std::lock_guard<std::mutex> lock (mainMutex_);
+  mainQueue_.push_back (std::move (job));
+}
+
+std::size_t JobSystem::drainMainThread () {
+  std::vector<Job> jobs;
+  {
+    std::lock_guard<std::mutex> lock (mainMutex_);
+    jobs.swap (mainQueue_);
+  }
+  // Jobs queued while draining wait for the next frame
+  for (Job& job : jobs) {
+    job ();
+  }
+  return jobs.size ();
+}
@@ -0,0 +1,210 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Work-stealing job system: Chase-Lev deques, counters with dependencies, parallelFor, main queue
+
+#ifndef __JOBSYSTEM_H__
+#define __JOBSYSTEM_H__
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Chase-Lev deque of pointers with a fixed power of two capacity. The owning thread pushes and
+// pops at the bottom (LIFO, cache warm), any other thread steals from the top (FIFO, the oldest
+// and usually largest pieces of work). push () fails instead of growing when full.
+template <typename T> class WorkStealingDeque {
+public:
+  explicit WorkStealingDeque (std::size_t capacity = 4096)
+      : mask_ (capacity - 1), slots_ (new std::atomic<T*>[capacity]) {
+  }
+
+  // Owner only
+  bool push (T* item) {
+    const std::int64_t bottom = bottom_.load (std::memory_order_relaxed);
+    const std::int64_t top = top_.load (std::memory_order_acquire);
+    if (bottom - top > static_cast<std::int64_t> (mask_)) {
+      return false;
+    }
+    slots_[bottom & mask_].store (item, std::memory_order_release);
+    std::atomic_thread_fence (std::memory_order_release);
+    bottom_.store (bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Owner only
+  T* pop () {
+    const std::int64_t bottom = bottom_.load (std::memory_order_relaxed) - 1;
+    bottom_.store (bottom, std::memory_order_relaxed);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    std::int64_t top = top_.load (std::memory_order_relaxed);
+    if (top > bottom) {
+      bottom_.store (bottom + 1, std::memory_order_relaxed); // empty
+      return nullptr;
+    }
+    T* item = slots_[bottom & mask_].load (std::memory_order_acquire);
+    if (top == bottom) {
+      // Last item, race the thieves for it
+      if (!top_.compare_exchange_strong (top, top + 1, std::memory_order_seq_cst,
+                                         std::memory_order_relaxed)) {
+        item = nullptr;
+      }
+      bottom_.store (bottom + 1, std::memory_order_relaxed);
+    }
+    return item;
+  }
+
+  // Any thread
+  T* steal () {
+    std::int64_t top = top_.load (std::memory_order_acquire);
+    std::atomic_thread_fence (std::memory_order_seq_cst);
+    const std::int64_t bottom = bottom_.load (std::memory_order_acquire);
+    if (top >= bottom) {
+      return nullptr;
+    }
+    T* item = slots_[top & mask_].load (std::memory_order_acquire);
+    if (!top_.compare_exchange_strong (top, top + 1, std::memory_order_seq_cst,
+                                       std::memory_order_relaxed)) {
+      return nullptr; // lost to the owner or another thief
+    }
+    return item;
+  }
+
+  bool empty () const {
+    return top_.load (std::memory_order_acquire) >= bottom_.load (std::memory_order_acquire);
+  }
+
+private:
+  const std::size_t mask_;
+  std::unique_ptr<std::atomic<T*>[]> slots_;
+  alignas (64) std::atomic<std::int64_t> top_{ 0 };
+  alignas (64) std::atomic<std::int64_t> bottom_{ 0 };
+};
+
+// Fixed set of workers, one deque each. Jobs submitted from a worker go to its own deque, jobs
+// from other threads to a shared injection queue; idle workers steal. A thread that waits on a
+// counter runs jobs meanwhile instead of blocking, so jobs may wait on jobs they spawned.
+//
+// With zero workers (Emscripten without pthreads) every job runs inside wait ().
+class JobSystem {
+  struct Task;
+
+public:
+  using Job = std::function<void ()>;
+
+  // Number of unfinished jobs submitted against it. Jobs can be deferred until another counter
+  // reaches zero (run (job, &counter, &dependency)). Must outlive its jobs; wait () before
+  // destroying it.
+  class Counter {
+  public:
+    Counter () = default;
+    Counter (const Counter&) = delete;
+    Counter& operator= (const Counter&) = delete;
+
+    bool done () const {
+      return pending_.load (std::memory_order_acquire) == 0;
+    }
+
+  private:
+    friend class JobSystem;
+
+    std::atomic<std::size_t> pending_{ 0 };
+    mutable std::mutex mutex_;
+    mutable std::condition_variable zero_;
+    std::vector<Task*> deferred_; // waiting for this counter, guarded by mutex_
+  };
+
+  explicit JobSystem (std::size_t workers = defaultWorkerCount ());
+  // Runs what is still queued, then stops the workers
+  ~JobSystem ();
+
+  JobSystem (const JobSystem&) = delete;
+  JobSystem& operator= (const JobSystem&) = delete;
+
+  // counter (optional) counts the job until it finished; dependency (optional) delays its start
+  // until that counter reaches zero
+  void run (Job job, Counter* counter = nullptr, Counter* dependency = nullptr);
+
+  // Runs jobs on the calling thread until counter reaches zero
+  void wait (const Counter& counter);
+
+  // fn (first, last) over [begin, end) in chunks of at most grain indices (0: a few chunks per
+  // thread). The caller takes part; returns when every chunk finished.
+  template <typename Fn>
+  void parallelFor (std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn) {
+    if (begin >= end) {
+      return;
+    }
+    const std::size_t count = end - begin;
+    if (grain == 0) {
+      grain = std::max<std::size_t> (1, count / ((workers_.size () + 1) * 4));
+    }
+    if (count <= grain || workers_.empty ()) {
+      fn (begin, end);
+      return;
+    }
+    Counter counter;
+    for (std::size_t first = begin + grain; first < end; first += grain) {
+      const std::size_t last = std::min (end, first + grain);
+      run ([&fn, first, last] { fn (first, last); }, &counter);
+    }
+    fn (begin, begin + grain);
+    wait (counter);
+  }
+
+  // Queues job for the thread that owns the frame loop (PlatformManager drains it once per frame)
+  void runOnMainThread (Job job);
+  // Runs the main thread jobs queued so far, returns how many ran
+  std::size_t drainMainThread ();
+
+  std::size_t workerCount () const {
+    return workers_.size ();
+  }
+
+  // True on this system's worker threads
+  bool isWorkerThread () const;
+
+  static std::size_t defaultWorkerCount ();
+
+  // Process wide instance, created on first use with setSharedWorkerCount () workers (default:
+  // defaultWorkerCount ()). The override has no effect once shared () was called.
+  static JobSystem& shared ();
+  static void setSharedWorkerCount (std::size_t workers);
+
+private:
+  struct Task {
+    Job job;
+    Counter* counter;
+  };
+
+  void submit (Task* task);
+  void execute (Task* task);
+  Task* findWork ();
+  bool hasWork () const;
+  void wakeOne ();
+  void workerLoop (std::size_t index);
+
+  std::vector<std::unique_ptr<WorkStealingDeque<Task>>> deques_;
+  std::vector<std::thread> workers_;
+
+  mutable std::mutex injectMutex_;
+  std::deque<Task*> injected_; // guarded by injectMutex_
+  std::atomic<std::size_t> injectedCount_{ 0 };
+
+  std::mutex sleepMutex_;
+  std::condition_variable wake_;
+  std::atomic<int> sleepers_{ 0 };
+  std::atomic<bool> stopping_{ false };
+
+  std::mutex mainMutex_;
+  std::vector<Job> mainQueue_; // guarded by mainMutex_
+};
+
+#endif // __JOBSYSTEM_H__
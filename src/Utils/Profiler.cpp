@@ -0,0 +1,155 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+
+#include "Profiler.hpp"
+
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+
+namespace Profiler {
+  namespace {
+    struct Slot {
+      std::atomic<const char*> name{ nullptr };
+      std::atomic<std::uint64_t> beginNs{ 0 };
+      std::atomic<std::uint64_t> endNs{ 0 };
+    };
+
+    // Written by its thread only. head counts every zone ever recorded, the slot of zone i is
+    // i % kRingCapacity; readers validate their copy against head afterwards (seqlock style).
+    struct ThreadRing {
+      explicit ThreadRing (std::uint32_t id) : thread (id), slots (new Slot[kRingCapacity]) {
+      }
+      const std::uint32_t thread;
+      std::unique_ptr<Slot[]> slots;
+      std::atomic<std::uint64_t> head{ 0 };
+      std::atomic<std::uint64_t> floor{ 0 }; // clear () moves it to head
+      std::string name;                      // guarded by Registry::mutex
+    };
+
+    // Rings outlive their threads, so worker zones survive until the export
+    struct Registry {
+      std::mutex mutex;
+      std::vector<std::unique_ptr<ThreadRing>> rings;
+    };
+
+    Registry& registry () {
+      static Registry* instance = new Registry (); // never destroyed, threads may record at exit
+      return *instance;
+    }
+
+    ThreadRing& threadRing () {
+      thread_local ThreadRing* ring = [] {
+        Registry& reg = registry ();
+        std::lock_guard<std::mutex> lock (reg.mutex);
+        reg.rings.push_back (
+            std::make_unique<ThreadRing> (static_cast<std::uint32_t> (reg.rings.size ())));
+        return reg.rings.back ().get ();
+      }();
+      return *ring;
+    }
+  } // namespace
+
+  void record (const char* name, std::uint64_t beginNs, std::uint64_t endNs) {
+    ThreadRing& ring = threadRing ();
+    const std::uint64_t index = ring.head.load (std::memory_order_relaxed);
+    Slot& slot = ring.slots[index % kRingCapacity];
+    // Pairs with the acquire fence in snapshot (): a reader that sees any of these stores also
+    // sees head == index and drops the slot
+    std::atomic_thread_fence (std::memory_order_release);
+    slot.name.store (name, std::memory_order_relaxed);
+    slot.beginNs.store (beginNs, std::memory_order_relaxed);
+    slot.endNs.store (endNs, std::memory_order_relaxed);
+    ring.head.store (index + 1, std::memory_order_release);
+  }
+
+  void setThreadName (const std::string& name) {
+    ThreadRing& ring = threadRing ();
+    std::lock_guard<std::mutex> lock (registry ().mutex);
+    ring.name = name;
+  }
+
+  std::vector<Zone> snapshot () {
+    std::vector<Zone> zones;
+    Registry& reg = registry ();
+    std::lock_guard<std::mutex> lock (reg.mutex);
+    for (const auto& ring : reg.rings) {
+      const std::uint64_t head = ring->head.load (std::memory_order_acquire);
+      const std::uint64_t first
+          = std::max (ring->floor.load (std::memory_order_relaxed),
+                      head > kRingCapacity ? head - kRingCapacity : std::uint64_t{ 0 });
+      const std::size_t start = zones.size ();
+      for (std::uint64_t i = first; i < head; ++i) {
+        const Slot& slot = ring->slots[i % kRingCapacity];
+        zones.push_back ({ slot.name.load (std::memory_order_relaxed),
+                           slot.beginNs.load (std::memory_order_relaxed),
+                           slot.endNs.load (std::memory_order_relaxed), ring->thread });
+      }
+      // Zone i is overwritten by zone i + kRingCapacity, which may be in progress once head
+      // reached it
+      std::atomic_thread_fence (std::memory_order_acquire);
+      const std::uint64_t after = ring->head.load (std::memory_order_relaxed);
+      if (after >= kRingCapacity && after - kRingCapacity >= first) {
+        const std::uint64_t torn = std::min (after - kRingCapacity + 1, head) - first;
+        zones.erase (zones.begin () + static_cast<std::ptrdiff_t> (start),
+                     zones.begin () + static_cast<std::ptrdiff_t> (start + torn));
+      }
+      std::sort (zones.begin () + static_cast<std::ptrdiff_t> (start), zones.end (),
+                 [] (const Zone& a, const Zone& b) {
+                   return a.beginNs != b.beginNs ? a.beginNs < b.beginNs : a.endNs > b.endNs;
+                 });
+    }
+    return zones;
+  }
+
+  void clear () {
+    Registry& reg = registry ();
+    std::lock_guard<std::mutex> lock (reg.mutex);
+    for (const auto& ring : reg.rings) {
+      ring->floor.store (ring->head.load (std::memory_order_acquire), std::memory_order_relaxed);
+    }
+  }
+
+  std::string chromeTraceJson () {
+    const std::vector<Zone> zones = snapshot ();
+    std::uint64_t origin = UINT64_MAX;
+    for (const Zone& zone : zones) {
+      origin = std::min (origin, zone.beginNs);
+    }
+
+    nlohmann::json events = nlohmann::json::array ();
+    {
+      Registry& reg = registry ();
+      std::lock_guard<std::mutex> lock (reg.mutex);
+      for (const auto& ring : reg.rings) {
+        const std::string name
+            = ring->name.empty () ? "Thread " + std::to_string (ring->thread) : ring->name;
+        events.push_back ({ { "name", "thread_name" },
+                            { "ph", "M" },
+                            { "pid", 1 },
+                            { "tid", ring->thread },
+                            { "args", { { "name", name } } } });
+      }
+    }
+    // Complete events ("X"), timestamps in microseconds from the first zone
+    for (const Zone& zone : zones) {
+      events.push_back ({ { "name", zone.name != nullptr ? zone.name : "?" },
+                          { "cat", "CoreLib" },
+                          { "ph", "X" },
+                          { "ts", static_cast<double> (zone.beginNs - origin) / 1000.0 },
+                          { "dur", static_cast<double> (zone.endNs - zone.beginNs) / 1000.0 },
+                          { "pid", 1 },
+                          { "tid", zone.thread } });
+    }
+    return nlohmann::json{ { "displayTimeUnit", "ms" }, { "traceEvents", events } }.dump ();
+  }
+
+  bool writeChromeTrace (const std::string& path) {
+    std::ofstream out (path, std::ios::out | std::ios::trunc);
+    out << chromeTraceJson ();
+    return static_cast<bool> (out);
+  }
+} // namespace Profiler
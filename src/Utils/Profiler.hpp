@@ -0,0 +1,96 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Scoped CPU profiling zones in per-thread rings, exported as Chrome trace_event JSON
+
+#ifndef __PROFILER_H__
+#define __PROFILER_H__
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// PROFILE_SCOPE ("name") records one zone - begin and end on the steady clock - when the enclosing
+// scope ends. Only the name pointer is stored, so names must be string literals (or otherwise
+// outlive the export). Every thread writes into its own fixed ring, a full ring overwrites its
+// oldest zones; no locks or allocations after a thread's first zone.
+//
+// The macros compile to nothing unless CoreLib is built with -DENABLE_PROFILING=ON (defines
+// PROFILING_ENABLED). The API below stays available either way, an uninstrumented build simply
+// exports an empty trace. Open the exported file in chrome://tracing or ui.perfetto.dev.
+#ifdef PROFILING_ENABLED
+  #define PROFILE_CONCAT_INNER(a, b) a##b
+  #define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER (a, b)
+  #define PROFILE_SCOPE(name) ::Profiler::Scope PROFILE_CONCAT (profileScope_, __LINE__) (name)
+  #define PROFILE_FUNCTION() PROFILE_SCOPE (__func__)
+  #define PROFILE_THREAD(name) ::Profiler::setThreadName (name)
+#else
+  #define PROFILE_SCOPE(name) ((void)0)
+  #define PROFILE_FUNCTION() ((void)0)
+  #define PROFILE_THREAD(name) ((void)0)
+#endif
+
+namespace Profiler {
+  // Zones per thread ring
+  constexpr std::size_t kRingCapacity = std::size_t{ 1 } << 14;
+
+  struct Zone {
+    const char* name;
+    std::uint64_t beginNs;
+    std::uint64_t endNs;
+    std::uint32_t thread; // registration order, the main thread is usually 0
+  };
+
+  namespace detail {
+    inline std::atomic<bool> capturing{ true };
+  }
+
+  inline std::uint64_t now () {
+    return static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::nanoseconds> (
+                                           std::chrono::steady_clock::now ().time_since_epoch ())
+                                           .count ());
+  }
+
+  // Pausing only affects zones that begin afterwards
+  inline void setCapturing (bool capturing) {
+    detail::capturing.store (capturing, std::memory_order_relaxed);
+  }
+  inline bool capturing () {
+    return detail::capturing.load (std::memory_order_relaxed);
+  }
+
+  void record (const char* name, std::uint64_t beginNs, std::uint64_t endNs);
+  // Shown as the track name in the trace viewer
+  void setThreadName (const std::string& name);
+
+  // Zones still in the rings, per thread ordered by begin (enclosing zones first). Safe while
+  // other threads keep recording: zones that may be overwritten during the copy (always the
+  // oldest slot of a full ring) are dropped.
+  std::vector<Zone> snapshot ();
+  // Forgets the zones recorded so far; rings and thread names stay
+  void clear ();
+
+  std::string chromeTraceJson ();
+  bool writeChromeTrace (const std::string& path);
+
+  class Scope {
+  public:
+    explicit Scope (const char* name)
+        : name_ (capturing () ? name : nullptr), beginNs_ (name_ != nullptr ? now () : 0) {
+    }
+    ~Scope () {
+      if (name_ != nullptr) {
+        record (name_, beginNs_, now ());
+      }
+    }
+    Scope (const Scope&) = delete;
+    Scope& operator= (const Scope&) = delete;
+
+  private:
+    const char* name_;
+    std::uint64_t beginNs_;
+  };
+} // namespace Profiler
+
+#endif // __PROFILER_H__
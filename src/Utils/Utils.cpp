@@ -2,3 +2,17 @@
 // Copyright (c) 2024-2025 Tomáš Mark
 
 #include "Utils.hpp"
+#include <Assets/AssetContext.hpp>
+
+namespace DotNameUtils {
+  namespace JsonUtils {
+
+    // Out of line, AssetContext.hpp includes this header through AssetPack.hpp
+    CustomStrings& CustomStrings::assets () {
+      static CustomStrings store;
+      store.setFilePath (AssetContext::getAssetsPath () / CUSTOM_STRINGS_FILE);
+      return store;
+    }
+
+  } // namespace JsonUtils
+} // namespace DotNameUtils
@@ -8,16 +8,28 @@
 
 #include "Logger/Logger.hpp"
 #include <nlohmann/json.hpp>
-#include <Assets/AssetContext.hpp>
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <filesystem>
 #include <fstream>
+#include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <mutex>
 #include <sstream>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 #include <optional>
+#if __cplusplus >= 202002L && __has_include(<span>)
+  #include <span>
+#endif
 
 // fullfilled from ../cmake/tmplt-assets.cmake)
 #ifndef UTILS_ASSET_PATH
@@ -43,21 +55,196 @@
   #include <unistd.h>
 #endif
 
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+  #if !defined(__EMSCRIPTEN__)
+    #include <sys/mman.h>
+  #endif
+#endif
+
 namespace DotNameUtils {
 
   namespace FileIO {
-    inline std::string readFile (const std::filesystem::path& filePath) {
-      std::ifstream file (filePath, std::ios::in);
-      if (!file.is_open ()) {
-        throw std::ios_base::failure ("Failed to open file: " + filePath.string ());
+    // Read-only view of a whole file. Regular files are memory mapped (mmap / MapViewOfFile), so
+    // parsers read straight from the page cache without copying. Pipes, character devices and
+    // Emscripten's virtual FS fall back to one buffered read. The contents are binary, no newline
+    // translation.
+    class MappedFile {
+    public:
+      enum class Access {
+        Sequential, // one pass front to back (parsers, decoders) - aggressive readahead
+        Random      // lookups scattered over the file (archives, indexes)
+      };
+
+      MappedFile () = default;
+
+      explicit MappedFile (const std::filesystem::path& filePath,
+                           Access access = Access::Sequential) {
+        open (filePath, access);
       }
-      std::stringstream buffer;
-      buffer << file.rdbuf ();
-      return buffer.str ();
+
+      ~MappedFile () {
+        close ();
+      }
+
+      MappedFile (const MappedFile&) = delete;
+      MappedFile& operator= (const MappedFile&) = delete;
+
+      MappedFile (MappedFile&& other) noexcept {
+        *this = std::move (other);
+      }
+
+      MappedFile& operator= (MappedFile&& other) noexcept {
+        if (this != &other) {
+          close ();
+          data_ = std::exchange (other.data_, nullptr);
+          size_ = std::exchange (other.size_, 0);
+          mapped_ = std::exchange (other.mapped_, false);
+          buffer_ = std::move (other.buffer_);
+          if (!mapped_) {
+            data_ = buffer_.data ();
+          }
+          other.buffer_.clear ();
+        }
+        return *this;
+      }
+
+      const char* data () const {
+        return data_ != nullptr ? data_ : "";
+      }
+
+      std::size_t size () const {
+        return size_;
+      }
+
+      bool empty () const {
+        return size_ == 0;
+      }
+
+      // False when the buffered fallback was used
+      bool isMapped () const {
+        return mapped_;
+      }
+
+      std::string_view view () const {
+        return std::string_view (data (), size_);
+      }
+
+      const unsigned char* bytes () const {
+        return reinterpret_cast<const unsigned char*> (data ());
+      }
+
+#if __cplusplus >= 202002L && __has_include(<span>)
+      std::span<const std::byte> span () const {
+        return std::span<const std::byte> (reinterpret_cast<const std::byte*> (data ()), size_);
+      }
+#endif
+
+    private:
+      void open (const std::filesystem::path& filePath, Access access) {
+#if defined(_WIN32)
+        HANDLE file = CreateFileW (filePath.wstring ().c_str (), GENERIC_READ, FILE_SHARE_READ,
+                                   nullptr, OPEN_EXISTING,
+                                   access == Access::Sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                                                                : FILE_FLAG_RANDOM_ACCESS,
+                                   nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+          throw std::ios_base::failure ("Failed to open file: " + filePath.string ());
+        }
+        LARGE_INTEGER fileSize{};
+        if (GetFileType (file) == FILE_TYPE_DISK && GetFileSizeEx (file, &fileSize)) {
+          size_ = static_cast<std::size_t> (fileSize.QuadPart);
+          if (size_ == 0) {
+            CloseHandle (file);
+            return;
+          }
+          HANDLE mapping = CreateFileMappingW (file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+          if (mapping != nullptr) {
+            data_ = static_cast<const char*> (MapViewOfFile (mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle (mapping); // the view keeps the mapping alive
+          }
+          if (data_ != nullptr) {
+            mapped_ = true;
+            CloseHandle (file);
+            return;
+          }
+        }
+        CloseHandle (file);
+        readBuffered (filePath);
+#else
+        const int fd = ::open (filePath.c_str (), O_RDONLY);
+        if (fd < 0) {
+          throw std::ios_base::failure ("Failed to open file: " + filePath.string ());
+        }
+        struct stat info{};
+        // Zero-sized "regular" files (procfs, sysfs) are read buffered as well
+        if (::fstat (fd, &info) == 0 && S_ISREG (info.st_mode) && info.st_size > 0) {
+          size_ = static_cast<std::size_t> (info.st_size);
+  #if !defined(__EMSCRIPTEN__)
+          void* address = ::mmap (nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+          if (address != MAP_FAILED) {
+            // Advice values are not flags, sequential access gets both hints separately
+            if (access == Access::Sequential) {
+              ::madvise (address, size_, MADV_SEQUENTIAL);
+              ::madvise (address, size_, MADV_WILLNEED);
+            } else {
+              ::madvise (address, size_, MADV_RANDOM);
+            }
+            data_ = static_cast<const char*> (address);
+            mapped_ = true;
+            ::close (fd); // the mapping stays valid
+            return;
+          }
+  #else
+          (void)access;
+  #endif
+        }
+        ::close (fd);
+        readBuffered (filePath);
+#endif
+      }
+
+      void readBuffered (const std::filesystem::path& filePath) {
+        std::ifstream file (filePath, std::ios::in | std::ios::binary);
+        if (!file.is_open ()) {
+          throw std::ios_base::failure ("Failed to open file: " + filePath.string ());
+        }
+        buffer_.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+        data_ = buffer_.data ();
+        size_ = buffer_.size ();
+        mapped_ = false;
+      }
+
+      void close () {
+        if (mapped_ && data_ != nullptr) {
+#if defined(_WIN32)
+          UnmapViewOfFile (data_);
+#elif !defined(__EMSCRIPTEN__)
+          ::munmap (const_cast<char*> (data_), size_);
+#endif
+        }
+        data_ = nullptr;
+        size_ = 0;
+        mapped_ = false;
+        buffer_.clear ();
+      }
+
+      const char* data_ = nullptr;
+      std::size_t size_ = 0;
+      bool mapped_ = false;
+      std::string buffer_; // fallback storage
+    };
+
+    // Whole file as a string, one copy out of the mapping
+    inline std::string readFile (const std::filesystem::path& filePath) {
+      MappedFile file (filePath);
+      return std::string (file.view ());
     }
 
     inline void writeFile (const std::filesystem::path& filePath, const std::string& content) {
-      std::ofstream file (filePath, std::ios::out | std::ios::trunc);
+      std::ofstream file (filePath, std::ios::out | std::ios::trunc | std::ios::binary);
       if (!file.is_open ()) {
         throw std::ios_base::failure ("Failed to open file: " + filePath.string ());
       }
@@ -126,6 +313,50 @@ namespace DotNameUtils {
     }
   } // namespace FileManager
 
+  // Build-time asset list. The sorted paths and sizes are constexpr data in a source generated per
+  // executable by cmake/tmplt-assets.cmake (generate_asset_index), a lookup is a binary search and
+  // nothing is parsed at startup. A target that uses the index compiles that source.
+  namespace AssetIndex {
+    struct Entry {
+      std::string_view path; // relative to the asset directory
+      std::uint64_t size = 0; // bytes at build time, 0 when unknown
+    };
+
+    namespace detail {
+      struct Table {
+        const std::string_view* paths = nullptr;
+        const std::uint64_t* sizes = nullptr;
+        std::size_t count = 0;
+      };
+
+      // Defined in the generated AssetIndex.cpp of the executable
+      const Table& table ();
+    } // namespace detail
+
+    inline std::size_t size () {
+      return detail::table ().count;
+    }
+
+    inline Entry at (std::size_t index) {
+      const auto& table = detail::table ();
+      return Entry{ table.paths[index], table.sizes != nullptr ? table.sizes[index] : 0 };
+    }
+
+    inline std::optional<Entry> find (std::string_view path) {
+      const auto& table = detail::table ();
+      const std::string_view* end = table.paths + table.count;
+      const std::string_view* it = std::lower_bound (table.paths, end, path);
+      if (it == end || *it != path) {
+        return std::nullopt;
+      }
+      return at (static_cast<std::size_t> (it - table.paths));
+    }
+
+    inline bool contains (std::string_view path) {
+      return find (path).has_value ();
+    }
+  } // namespace AssetIndex
+
   namespace Dots {
     inline std::string addDots (const std::string& str) {
       std::string result;
@@ -156,8 +387,8 @@ namespace DotNameUtils {
       }
 
       try {
-        std::string content = FileIO::readFile (filePath);
-        return nlohmann::json::parse (content);
+        FileIO::MappedFile file (filePath);
+        return nlohmann::json::parse (file.data (), file.data () + file.size ());
       } catch (const nlohmann::json::parse_error& e) {
         throw std::runtime_error ("JSON parse error in file " + filePath.string () + ": "
                                   + e.what ());
@@ -190,41 +421,388 @@ namespace DotNameUtils {
       return defaultValue;
     }
 
-    // Get nested value with path (e.g., "strings/0/data/en")
-    template <typename T>
-    inline T getNestedValue (const nlohmann::json& json, const std::string& path,
-                             const T& defaultValue = T{}) {
-      try {
-        std::istringstream pathStream (path);
-        std::string segment;
-        nlohmann::json current = json;
-
-        while (std::getline (pathStream, segment, '/')) {
-          if (segment.empty ())
-            continue;
-
-          // Check if segment is numeric (array index)
-          if (std::all_of (segment.begin (), segment.end (), ::isdigit)) {
-            size_t index = std::stoull (segment);
-            if (current.is_array () && index < current.size ()) {
-              current = current[index];
-            } else {
-              return defaultValue;
+    // Path segments like "a/0/b" resolved against a document by const reference, so a lookup
+    // costs proportionally to the depth, never to the size of the subtrees it walks through.
+    // A numeric segment indexes an array, or is used as a key on an object.
+    namespace detail {
+      template <typename Segment>
+      inline const nlohmann::json* resolvePath (const nlohmann::json& json, const Segment* begin,
+                                                const Segment* end) {
+        const nlohmann::json* current = &json;
+        for (const Segment* segment = begin; segment != end; ++segment) {
+          if (segment->isIndex && current->is_array ()) {
+            if (segment->index >= current->size ()) {
+              return nullptr;
             }
+            current = &(*current)[segment->index];
+          } else if (current->is_object ()) {
+            const auto it = current->find (std::string_view (segment->key));
+            if (it == current->end ()) {
+              return nullptr;
+            }
+            current = &*it;
           } else {
-            // Object key
-            if (current.contains (segment)) {
-              current = current[segment];
-            } else {
-              return defaultValue;
+            return nullptr;
+          }
+        }
+        return current;
+      }
+
+      template <typename T>
+      inline T getOr (const nlohmann::json* value, const T& defaultValue) {
+        if (value == nullptr) {
+          return defaultValue;
+        }
+        try {
+          return value->get<T> ();
+        } catch (const std::exception&) {
+          return defaultValue;
+        }
+      }
+
+      constexpr bool isIndexSegment (std::string_view segment, std::size_t& index) {
+        if (segment.empty ()) {
+          return false;
+        }
+        std::size_t value = 0;
+        for (char c : segment) {
+          if (c < '0' || c > '9') {
+            return false;
+          }
+          value = value * 10 + static_cast<std::size_t> (c - '0');
+        }
+        index = value;
+        return true;
+      }
+    } // namespace detail
+
+    // Path parsed once at runtime, reuse it for repeated lookups
+    class JsonPath {
+    public:
+      struct Segment {
+        std::string key;
+        std::size_t index = 0;
+        bool isIndex = false;
+      };
+
+      JsonPath () = default;
+
+      explicit JsonPath (std::string_view path) {
+        std::size_t start = 0;
+        while (start <= path.size ()) {
+          std::size_t end = path.find ('/', start);
+          if (end == std::string_view::npos) {
+            end = path.size ();
+          }
+          const std::string_view segment = path.substr (start, end - start);
+          if (!segment.empty ()) { // empty segments ("a//b", leading '/') are skipped
+            Segment parsed;
+            parsed.key.assign (segment.data (), segment.size ());
+            parsed.isIndex = detail::isIndexSegment (segment, parsed.index);
+            segments_.push_back (std::move (parsed));
+          }
+          start = end + 1;
+        }
+      }
+
+      const nlohmann::json* resolve (const nlohmann::json& json) const {
+        return detail::resolvePath (json, segments_.data (),
+                                    segments_.data () + segments_.size ());
+      }
+
+      template <typename T> T get (const nlohmann::json& json, const T& defaultValue = T{}) const {
+        return detail::getOr (resolve (json), defaultValue);
+      }
+
+      const std::vector<Segment>& segments () const {
+        return segments_;
+      }
+
+    private:
+      std::vector<Segment> segments_;
+    };
+
+    // Path parsed at compile time from a literal:
+    //   static constexpr JsonUtils::LiteralJsonPath kWidth ("window/size/0");
+    //   int width = kWidth.get<int> (config, 800);
+    class LiteralJsonPath {
+    public:
+      static constexpr std::size_t kMaxSegments = 16;
+
+      struct Segment {
+        std::string_view key;
+        std::size_t index = 0;
+        bool isIndex = false;
+      };
+
+      constexpr explicit LiteralJsonPath (std::string_view path) {
+        std::size_t start = 0;
+        while (start <= path.size ()) {
+          std::size_t end = path.find ('/', start);
+          if (end == std::string_view::npos) {
+            end = path.size ();
+          }
+          const std::string_view segment = path.substr (start, end - start);
+          if (!segment.empty ()) {
+            if (count_ == kMaxSegments) {
+              throw std::length_error ("LiteralJsonPath: too many segments");
             }
+            Segment& parsed = segments_[count_++];
+            parsed.key = segment;
+            parsed.isIndex = detail::isIndexSegment (segment, parsed.index);
           }
+          start = end + 1;
         }
+      }
 
-        return current.get<T> ();
-      } catch (const std::exception&) {
-        return defaultValue;
+      constexpr std::size_t size () const {
+        return count_;
+      }
+
+      constexpr const Segment& operator[] (std::size_t i) const {
+        return segments_[i];
+      }
+
+      const nlohmann::json* resolve (const nlohmann::json& json) const {
+        return detail::resolvePath (json, segments_.data (), segments_.data () + count_);
+      }
+
+      template <typename T> T get (const nlohmann::json& json, const T& defaultValue = T{}) const {
+        return detail::getOr (resolve (json), defaultValue);
+      }
+
+    private:
+      std::array<Segment, kMaxSegments> segments_{};
+      std::size_t count_ = 0;
+    };
+
+    // Streaming loader for large documents (asset manifests, shader catalogs). Built on the
+    // nlohmann SAX interface: no DOM is built for the document, only the values under bound
+    // paths are materialized and handed to their handler, everything else is tokenized and
+    // dropped. Patterns use JsonPath syntax, "*" matches any key or array index:
+    //   JsonStreamLoader loader;
+    //   loader.on ("shaders/*/name", [&] (const nlohmann::json& name, std::string_view path) {...});
+    //   loader.parseFile (manifest);
+    class JsonStreamLoader {
+    public:
+      using Handler = std::function<void (const nlohmann::json& value, std::string_view path)>;
+
+      JsonStreamLoader& on (std::string_view pattern, Handler handler) {
+        bindings_.push_back (Binding{ JsonPath (pattern), std::move (handler) });
+        return *this;
+      }
+
+      // Call from a handler to end parsing early, parse () then returns false
+      void stop () {
+        stopped_ = true;
+      }
+
+      // Returns false when stopped by a handler. Throws std::runtime_error on malformed input.
+      bool parse (std::string_view text) {
+        Sax sax (*this);
+        stopped_ = false;
+        const bool completed = nlohmann::json::sax_parse (text.begin (), text.end (), &sax);
+        if (!sax.error.empty ()) {
+          throw std::runtime_error ("JSON parse error: " + sax.error);
+        }
+        return completed && !stopped_;
+      }
+
+      bool parseFile (const std::filesystem::path& filePath) {
+        FileIO::MappedFile file (filePath);
+        try {
+          return parse (file.view ());
+        } catch (const std::runtime_error& e) {
+          throw std::runtime_error ("In file " + filePath.string () + ": " + e.what ());
+        }
       }
+
+    private:
+      struct Binding {
+        JsonPath pattern;
+        Handler handler;
+      };
+
+      // Tracks the path of the current value and builds a DOM only while inside a bound value
+      class Sax : public nlohmann::json_sax<nlohmann::json> {
+      public:
+        explicit Sax (JsonStreamLoader& loader) : loader_ (loader) {
+        }
+
+        bool null () override {
+          return scalar (nullptr);
+        }
+        bool boolean (bool value) override {
+          return scalar (value);
+        }
+        bool number_integer (number_integer_t value) override {
+          return scalar (value);
+        }
+        bool number_unsigned (number_unsigned_t value) override {
+          return scalar (value);
+        }
+        bool number_float (number_float_t value, const string_t&) override {
+          return scalar (value);
+        }
+        bool string (string_t& value) override {
+          return scalar (std::move (value));
+        }
+        bool binary (binary_t& value) override {
+          return scalar (nlohmann::json::binary (std::move (value)));
+        }
+
+        bool start_object (std::size_t) override {
+          beginValue (nlohmann::json::object ());
+          frames_.push_back (Frame{ false, 0, {} });
+          return true;
+        }
+        bool key (string_t& value) override {
+          frames_.back ().key = std::move (value);
+          return true;
+        }
+        bool end_object () override {
+          frames_.pop_back ();
+          return endContainer ();
+        }
+
+        bool start_array (std::size_t) override {
+          beginValue (nlohmann::json::array ());
+          frames_.push_back (Frame{ true, 0, {} });
+          return true;
+        }
+        bool end_array () override {
+          frames_.pop_back ();
+          return endContainer ();
+        }
+
+        bool parse_error (std::size_t, const std::string&,
+                          const nlohmann::detail::exception& e) override {
+          error = e.what ();
+          return false;
+        }
+
+        std::string error;
+
+      private:
+        struct Frame {
+          bool isArray;
+          std::size_t index; // of the next element
+          std::string key;   // of the current member
+        };
+
+        bool matches (const JsonPath& pattern) const {
+          const auto& segments = pattern.segments ();
+          if (segments.size () != frames_.size ()) {
+            return false;
+          }
+          for (std::size_t i = 0; i < segments.size (); ++i) {
+            const auto& segment = segments[i];
+            const Frame& frame = frames_[i];
+            if (segment.key == "*") {
+              continue;
+            }
+            if (frame.isArray ? !(segment.isIndex && segment.index == frame.index)
+                              : segment.key != frame.key) {
+              return false;
+            }
+          }
+          return true;
+        }
+
+        std::string currentPath () const {
+          std::string path;
+          for (const Frame& frame : frames_) {
+            if (!path.empty ()) {
+              path += '/';
+            }
+            path += frame.isArray ? std::to_string (frame.index) : frame.key;
+          }
+          return path;
+        }
+
+        // Inserts into the capture or starts a new one if a binding matches this position
+        void beginValue (nlohmann::json&& value) {
+          if (!capture_.empty ()) {
+            nlohmann::json& parent = *capture_.back ();
+            nlohmann::json* slot = parent.is_array () ? &parent.emplace_back (std::move (value))
+                                                      : &(parent[frames_.back ().key]
+                                                          = std::move (value));
+            if (slot->is_structured ()) {
+              capture_.push_back (slot);
+            }
+            return;
+          }
+          for (std::size_t i = 0; i < loader_.bindings_.size (); ++i) {
+            if (matches (loader_.bindings_[i].pattern)) {
+              root_ = std::move (value);
+              binding_ = i;
+              capture_.push_back (&root_);
+              return;
+            }
+          }
+        }
+
+        template <typename T> bool scalar (T&& value) {
+          if (!capture_.empty ()) {
+            nlohmann::json& parent = *capture_.back ();
+            if (parent.is_array ()) {
+              parent.emplace_back (std::forward<T> (value));
+            } else {
+              parent[frames_.back ().key] = std::forward<T> (value);
+            }
+            return advance ();
+          }
+          for (std::size_t i = 0; i < loader_.bindings_.size (); ++i) {
+            if (matches (loader_.bindings_[i].pattern)) {
+              root_ = std::forward<T> (value);
+              binding_ = i;
+              deliver ();
+              break;
+            }
+          }
+          return advance ();
+        }
+
+        bool endContainer () {
+          if (!capture_.empty ()) {
+            capture_.pop_back ();
+            if (capture_.empty ()) {
+              deliver ();
+            }
+          }
+          return advance ();
+        }
+
+        void deliver () {
+          loader_.bindings_[binding_].handler (root_, currentPath ());
+          root_ = nullptr;
+        }
+
+        // Value finished, move the enclosing array to its next index
+        bool advance () {
+          if (!frames_.empty () && frames_.back ().isArray) {
+            ++frames_.back ().index;
+          }
+          return !loader_.stopped_;
+        }
+
+        JsonStreamLoader& loader_;
+        std::vector<Frame> frames_;
+        std::vector<nlohmann::json*> capture_; // open containers of the captured value
+        nlohmann::json root_;
+        std::size_t binding_ = 0;
+      };
+
+      std::vector<Binding> bindings_;
+      bool stopped_ = false;
+    };
+
+    // Get nested value using path (e.g., "user/profile/name"). For repeated lookups keep a
+    // JsonPath or LiteralJsonPath instead of re-parsing the string.
+    template <typename T>
+    inline T getNestedValue (const nlohmann::json& json, const std::string& path,
+                             const T& defaultValue = T{}) {
+      return JsonPath (path).get<T> (json, defaultValue);
     }
 
     // Find item by id in array
@@ -245,13 +823,28 @@ namespace DotNameUtils {
       return std::nullopt;
     }
 
+    // Same as findById without copying the item, nullptr when not found
+    inline const nlohmann::json* findItemById (const nlohmann::json& jsonArray,
+                                               const std::string& id,
+                                               const std::string& idField = "id") {
+      if (jsonArray.is_array ()) {
+        for (const auto& item : jsonArray) {
+          const auto field = item.find (idField);
+          if (field != item.end () && *field == id) {
+            return &item;
+          }
+        }
+      }
+      return nullptr;
+    }
+
     // Get localized string from your custom format
     inline std::optional<std::string> getLocalizedString (const nlohmann::json& stringsJson,
                                                           const std::string& id,
                                                           const std::string& locale = "en") {
       try {
         if (stringsJson.contains ("strings") && stringsJson["strings"].is_array ()) {
-          auto item = findById (stringsJson["strings"], id);
+          const nlohmann::json* item = findItemById (stringsJson["strings"], id);
           if (item && item->contains ("data")) {
             const auto& data = (*item)["data"];
             if (data.contains (locale)) {
@@ -274,7 +867,7 @@ namespace DotNameUtils {
                                                 const std::string& id) {
       try {
         if (stringsJson.contains ("strings") && stringsJson["strings"].is_array ()) {
-          auto item = findById (stringsJson["strings"], id);
+          const nlohmann::json* item = findItemById (stringsJson["strings"], id);
           if (item && item->contains ("data")) {
             const auto& data = (*item)["data"];
             if (data.contains ("email")) {
@@ -293,7 +886,7 @@ namespace DotNameUtils {
                                               const std::string& id) {
       try {
         if (stringsJson.contains ("strings") && stringsJson["strings"].is_array ()) {
-          auto item = findById (stringsJson["strings"], id);
+          const nlohmann::json* item = findItemById (stringsJson["strings"], id);
           if (item && item->contains ("data")) {
             const auto& data = (*item)["data"];
             if (data.contains ("url")) {
@@ -312,7 +905,7 @@ namespace DotNameUtils {
                                               const std::string& id) {
       try {
         if (stringsJson.contains ("strings") && stringsJson["strings"].is_array ()) {
-          auto item = findById (stringsJson["strings"], id);
+          const nlohmann::json* item = findItemById (stringsJson["strings"], id);
           if (item && item->contains ("data")) {
             const auto& data = (*item)["data"];
             if (data.contains ("tel")) {
@@ -353,49 +946,244 @@ namespace DotNameUtils {
       return result;
     }
 
+    // Parsed customstrings.json. The file is parsed once into an immutable snapshot: every id,
+    // key and value lives in one arena, ids are found through a flat open-addressing hash table
+    // and each id owns a short run of (key, value) fields - locales, "email", "url", "tel".
+    // Lookups return views into the arena, valid as long as the snapshot is held.
+    class CustomStrings {
+    public:
+      class Snapshot {
+      public:
+        explicit Snapshot (const nlohmann::json& json) {
+          const auto strings = json.find ("strings");
+          if (strings == json.end () || !strings->is_array ()) {
+            return;
+          }
+
+          // First pass sizes the arena so the views never move
+          std::size_t arenaSize = 0;
+          std::size_t fieldCount = 0;
+          forEachItem (*strings, [&] (const std::string& id, const nlohmann::json& data) {
+            arenaSize += id.size ();
+            for (const auto& [key, value] : data.items ()) {
+              if (value.is_string ()) {
+                arenaSize += key.size () + value.get_ref<const std::string&> ().size ();
+                ++fieldCount;
+              }
+            }
+          });
+          arena_.reset (new char[arenaSize > 0 ? arenaSize : 1]);
+          fields_.reserve (fieldCount);
+
+          std::size_t used = 0;
+          auto store = [&] (const std::string& text) {
+            std::copy (text.begin (), text.end (), arena_.get () + used);
+            std::string_view view (arena_.get () + used, text.size ());
+            used += text.size ();
+            return view;
+          };
+
+          std::size_t capacity = 8;
+          while (capacity < strings->size () * 2) {
+            capacity *= 2;
+          }
+          slots_.assign (capacity, 0);
+
+          forEachItem (*strings, [&] (const std::string& id, const nlohmann::json& data) {
+            if (find (id) != nullptr) {
+              return; // first occurrence wins, as with findById
+            }
+            Item item;
+            item.id = store (id);
+            item.first = static_cast<std::uint32_t> (fields_.size ());
+            for (const auto& [key, value] : data.items ()) {
+              if (value.is_string ()) {
+                fields_.push_back (
+                    Field{ store (key), store (value.get_ref<const std::string&> ()) });
+              }
+            }
+            item.count = static_cast<std::uint32_t> (fields_.size ()) - item.first;
+            items_.push_back (item);
+
+            std::size_t slot = hash (item.id) & (slots_.size () - 1);
+            while (slots_[slot] != 0) {
+              slot = (slot + 1) & (slots_.size () - 1);
+            }
+            slots_[slot] = static_cast<std::uint32_t> (items_.size ());
+          });
+        }
+
+        Snapshot (const Snapshot&) = delete;
+        Snapshot& operator= (const Snapshot&) = delete;
+
+        std::optional<std::string_view> get (std::string_view id, std::string_view key) const {
+          if (const Item* item = find (id)) {
+            for (std::uint32_t i = item->first; i < item->first + item->count; ++i) {
+              if (fields_[i].key == key) {
+                return fields_[i].value;
+              }
+            }
+          }
+          return std::nullopt;
+        }
+
+        // Falls back to English like getLocalizedString
+        std::optional<std::string_view> localized (std::string_view id,
+                                                   std::string_view locale = "en") const {
+          if (auto value = get (id, locale)) {
+            return value;
+          }
+          if (locale != "en") {
+            return get (id, "en");
+          }
+          return std::nullopt;
+        }
+
+        std::optional<std::string_view> email (std::string_view id) const {
+          return get (id, "email");
+        }
+
+        std::optional<std::string_view> url (std::string_view id) const {
+          return get (id, "url");
+        }
+
+        std::optional<std::string_view> tel (std::string_view id) const {
+          return get (id, "tel");
+        }
+
+        std::size_t size () const {
+          return items_.size ();
+        }
+
+      private:
+        struct Field {
+          std::string_view key;
+          std::string_view value;
+        };
+
+        struct Item {
+          std::string_view id;
+          std::uint32_t first = 0;
+          std::uint32_t count = 0;
+        };
+
+        template <typename Fn> static void forEachItem (const nlohmann::json& strings, Fn&& fn) {
+          for (const auto& item : strings) {
+            const auto id = item.find ("id");
+            const auto data = item.find ("data");
+            if (id != item.end () && id->is_string () && data != item.end ()
+                && data->is_object ()) {
+              fn (id->get_ref<const std::string&> (), *data);
+            }
+          }
+        }
+
+        // FNV-1a
+        static std::uint64_t hash (std::string_view text) {
+          std::uint64_t value = 14695981039346656037ull;
+          for (char c : text) {
+            value = (value ^ static_cast<unsigned char> (c)) * 1099511628211ull;
+          }
+          return value;
+        }
+
+        const Item* find (std::string_view id) const {
+          if (slots_.empty ()) {
+            return nullptr;
+          }
+          std::size_t slot = hash (id) & (slots_.size () - 1);
+          while (slots_[slot] != 0) {
+            const Item& item = items_[slots_[slot] - 1];
+            if (item.id == id) {
+              return &item;
+            }
+            slot = (slot + 1) & (slots_.size () - 1);
+          }
+          return nullptr;
+        }
+
+        std::unique_ptr<char[]> arena_;
+        std::vector<Field> fields_;
+        std::vector<Item> items_;
+        std::vector<std::uint32_t> slots_; // items_ index + 1, 0 = empty
+      };
+
+      explicit CustomStrings (std::filesystem::path filePath = {})
+          : filePath_ (std::move (filePath)) {
+      }
+
+      void setFilePath (const std::filesystem::path& filePath) {
+        std::lock_guard<std::mutex> lock (mutex_);
+        if (filePath != filePath_) {
+          filePath_ = filePath;
+          snapshot_.reset ();
+        }
+      }
+
+      // Parses on first use and again only when the file's mtime changes. A failed reload keeps
+      // the previous snapshot; a failed first load throws like loadFromFile.
+      std::shared_ptr<const Snapshot> snapshot () {
+        std::lock_guard<std::mutex> lock (mutex_);
+        std::error_code error;
+        const auto modified = std::filesystem::last_write_time (filePath_, error);
+        if (snapshot_ && (error || modified == modified_)) {
+          return snapshot_;
+        }
+        try {
+          snapshot_ = std::make_shared<const Snapshot> (loadFromFile (filePath_));
+          ++loadCount_;
+        } catch (const std::exception& e) {
+          if (!snapshot_) {
+            throw;
+          }
+          LOG_W_STREAM << "Keeping previous custom strings, reload failed: " << e.what ()
+                       << std::endl;
+        }
+        modified_ = modified;
+        return snapshot_;
+      }
+
+      std::size_t loadCount () const {
+        std::lock_guard<std::mutex> lock (mutex_);
+        return loadCount_;
+      }
+
+      // Store for CUSTOM_STRINGS_FILE in the current assets directory
+      static CustomStrings& assets ();
+
+    private:
+      mutable std::mutex mutex_;
+      std::filesystem::path filePath_;
+      std::filesystem::file_time_type modified_{};
+      std::shared_ptr<const Snapshot> snapshot_;
+      std::size_t loadCount_ = 0;
+    };
+
     // get Author, Email, Phone, Website, GitHub, ...
     inline std::string getCustomStringSign () {
       std::string result;
       try {
-        auto customStrings = loadFromFile (AssetContext::getAssetsPath () / CUSTOM_STRINGS_FILE);
-        auto authorEn = getLocalizedString (customStrings, "Author", "en");
-        auto authorCs = getLocalizedString (customStrings, "Author", "cs");
-        auto email = getEmail (customStrings, "Email");
-        auto phone = getTel (customStrings, "Phone");
-        auto website = getUrl (customStrings, "Website");
-        auto github = getUrl (customStrings, "GitHub");
-        auto linkedin = getUrl (customStrings, "LinkedIn");
-        auto discord = getUrl (customStrings, "Discord");
-
-        if (email)
-          result += "Email: " + *email + "\n";
-        else
-          result += "No email provided.\n";
-
-        if (phone)
-          result += "Phone: " + *phone + "\n";
-        else
-          result += "No phone provided.\n";
-
-        if (website)
-          result += "Website: " + *website + "\n";
-        else
-          result += "No website provided.\n";
-
-        if (github)
-          result += "GitHub: " + *github + "\n";
-        else
-          result += "No GitHub provided.\n";
-
-        if (linkedin)
-          result += "LinkedIn: " + *linkedin + "\n";
-        else
-          result += "No LinkedIn provided.\n";
-
-        if (discord)
-          result += "Discord: " + *discord;
-        else
-          result += "No Discord provided.";
+        const auto strings = CustomStrings::assets ().snapshot ();
+        auto line = [&] (const char* label, std::optional<std::string_view> value,
+                         const char* missing) {
+          if (value) {
+            result.append (label).append (": ").append (*value);
+          } else {
+            result.append (missing);
+          }
+        };
+
+        line ("Email", strings->email ("Email"), "No email provided.");
+        result += "\n";
+        line ("Phone", strings->tel ("Phone"), "No phone provided.");
+        result += "\n";
+        line ("Website", strings->url ("Website"), "No website provided.");
+        result += "\n";
+        line ("GitHub", strings->url ("GitHub"), "No GitHub provided.");
+        result += "\n";
+        line ("LinkedIn", strings->url ("LinkedIn"), "No LinkedIn provided.");
+        result += "\n";
+        line ("Discord", strings->url ("Discord"), "No Discord provided.");
 
       } catch (const std::exception& e) {
         result = "Error loading custom strings: " + std::string (e.what ());
@@ -405,34 +1193,6 @@ namespace DotNameUtils {
 
   } // namespace JsonUtils
 
-  namespace Performance {
-    inline void simpleCpuBenchmark (std::chrono::microseconds duration
-                                    = std::chrono::microseconds (1000000)) {
-      LOG_I_STREAM << "Simple CPU benchmark" << std::endl;
-      LOG_I_STREAM << "CPU cores: " << std::thread::hardware_concurrency () << std::endl;
-      auto start = std::chrono::high_resolution_clock::now ();
-      auto end = start + duration;
-      long int iterations = 0;
-      while (std::chrono::high_resolution_clock::now () < end) {
-#if defined(__GNUC__) || defined(__clang__)
-        asm volatile ("nop");
-#elif defined(_MSC_VER)
-        __nop ();
-#else
-        // Fallback for unsupported platforms
-        std::this_thread::yield ();
-#endif
-        ++iterations;
-      }
-      auto actualEnd = std::chrono::high_resolution_clock::now ();
-      auto actualDuration
-          = std::chrono::duration_cast<std::chrono::milliseconds> (actualEnd - start);
-      std::string iterationsStr = std::to_string (iterations);
-      LOG_I_STREAM << "CPU benchmark duration: " << actualDuration.count () << " ms" << std::endl;
-      LOG_I_STREAM << "Total iterations: " << Dots::addDots (iterationsStr) << std::endl;
-    }
-  } // namespace Performance
-
 } // namespace DotNameUtils
 
 #endif // UTILS_HPP
\ No newline at end of file
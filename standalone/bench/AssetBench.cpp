@@ -0,0 +1,256 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// JSON lookups, file reads, image decode and block transcode
+
+#include <Assets/BlockCompression.hpp>
+#include <Assets/ImageDecoder.hpp>
+#include <Utils/Utils.hpp>
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+using namespace DotNameUtils;
+
+namespace {
+  // ---- JSON ------------------------------------------------------------------------------------
+
+  // A settings document with a shader catalog, roughly the shape of what the app loads
+  const nlohmann::json& settingsDocument () {
+    static const nlohmann::json document = [] {
+      nlohmann::json doc;
+      doc["window"]["size"] = { 1920, 1080 };
+      doc["window"]["title"] = "index2";
+      doc["render"]["quality"]["tier"] = 2;
+      for (int i = 0; i < 256; ++i) {
+        doc["shaders"].push_back ({ { "name", "shader" + std::to_string (i) },
+                                    { "complexity", i % 17 },
+                                    { "channels", { "noise.png", "rgba.png" } } });
+      }
+      return doc;
+    }();
+    return document;
+  }
+
+  const nlohmann::json& customStringsDocument () {
+    static const nlohmann::json document = [] {
+      nlohmann::json doc;
+      for (int i = 0; i < 64; ++i) {
+        doc["strings"].push_back ({ { "id", "Item" + std::to_string (i) },
+                                    { "data",
+                                      { { "en", "English" },
+                                        { "cs", "Česky" },
+                                        { "email", "item@example.com" } } } });
+      }
+      return doc;
+    }();
+    return document;
+  }
+
+  void jsonNestedValue (benchmark::State& state) {
+    const nlohmann::json& doc = settingsDocument ();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize (JsonUtils::getNestedValue<int> (doc, "shaders/200/complexity", 0));
+    }
+  }
+  BENCHMARK (jsonNestedValue)->Name ("Json/NestedValueString");
+
+  void jsonCompiledPath (benchmark::State& state) {
+    const nlohmann::json& doc = settingsDocument ();
+    const JsonUtils::JsonPath path ("shaders/200/complexity");
+    for (auto _ : state) {
+      benchmark::DoNotOptimize (path.get<int> (doc, 0));
+    }
+  }
+  BENCHMARK (jsonCompiledPath)->Name ("Json/JsonPath");
+
+  void jsonLiteralPath (benchmark::State& state) {
+    static constexpr JsonUtils::LiteralJsonPath kPath ("shaders/200/complexity");
+    const nlohmann::json& doc = settingsDocument ();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize (kPath.get<int> (doc, 0));
+    }
+  }
+  BENCHMARK (jsonLiteralPath)->Name ("Json/LiteralJsonPath");
+
+  void jsonCustomStrings (benchmark::State& state) {
+    const JsonUtils::CustomStrings::Snapshot snapshot (customStringsDocument ());
+    for (auto _ : state) {
+      benchmark::DoNotOptimize (snapshot.localized ("Item42", "cs"));
+      benchmark::DoNotOptimize (snapshot.email ("Item63"));
+    }
+  }
+  BENCHMARK (jsonCustomStrings)->Name ("Json/CustomStringsLookup");
+
+  void jsonParseDom (benchmark::State& state) {
+    const std::string text = settingsDocument ().dump ();
+    for (auto _ : state) {
+      benchmark::DoNotOptimize (nlohmann::json::parse (text));
+    }
+    state.SetBytesProcessed (static_cast<int64_t> (state.iterations ()) * text.size ());
+  }
+  BENCHMARK (jsonParseDom)->Name ("Json/ParseDom")->Unit (benchmark::kMicrosecond);
+
+  void jsonParseStream (benchmark::State& state) {
+    const std::string text = settingsDocument ().dump ();
+    for (auto _ : state) {
+      int total = 0;
+      JsonUtils::JsonStreamLoader loader;
+      loader.on ("shaders/*/complexity", [&] (const nlohmann::json& value, std::string_view) {
+        total += value.get<int> ();
+      });
+      loader.parse (text);
+      benchmark::DoNotOptimize (total);
+    }
+    state.SetBytesProcessed (static_cast<int64_t> (state.iterations ()) * text.size ());
+  }
+  BENCHMARK (jsonParseStream)->Name ("Json/StreamLoader")->Unit (benchmark::kMicrosecond);
+
+  // ---- File reads ------------------------------------------------------------------------------
+
+  std::filesystem::path benchFile (std::size_t bytes) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path ()
+                                       / ("corelib_bench_" + std::to_string (bytes) + ".bin");
+    if (!std::filesystem::exists (path) || std::filesystem::file_size (path) != bytes) {
+      std::ofstream out (path, std::ios::binary | std::ios::trunc);
+      std::vector<char> chunk (1 << 16);
+      for (std::size_t i = 0; i < chunk.size (); ++i) {
+        chunk[i] = static_cast<char> (i * 31);
+      }
+      for (std::size_t written = 0; written < bytes; written += chunk.size ()) {
+        out.write (chunk.data (),
+                   static_cast<std::streamsize> (std::min (chunk.size (), bytes - written)));
+      }
+    }
+    return path;
+  }
+
+  void fileReadString (benchmark::State& state) {
+    const std::filesystem::path path = benchFile (static_cast<std::size_t> (state.range (0)));
+    for (auto _ : state) {
+      std::string content = FileIO::readFile (path);
+      benchmark::DoNotOptimize (content.data ());
+    }
+    state.SetBytesProcessed (static_cast<int64_t> (state.iterations ()) * state.range (0));
+  }
+  BENCHMARK (fileReadString)->Name ("FileRead/ReadFile")->Arg (64 << 10)->Arg (16 << 20);
+
+  void fileReadMapped (benchmark::State& state) {
+    const std::filesystem::path path = benchFile (static_cast<std::size_t> (state.range (0)));
+    for (auto _ : state) {
+      FileIO::MappedFile file (path);
+      // Touch every page, a mapping alone reads nothing
+      unsigned sum = 0;
+      for (std::size_t i = 0; i < file.size (); i += 4096) {
+        sum += static_cast<unsigned char> (file.data ()[i]);
+      }
+      benchmark::DoNotOptimize (sum);
+    }
+    state.SetBytesProcessed (static_cast<int64_t> (state.iterations ()) * state.range (0));
+  }
+  BENCHMARK (fileReadMapped)->Name ("FileRead/MappedFile")->Arg (64 << 10)->Arg (16 << 20);
+
+  // ---- Texture decode --------------------------------------------------------------------------
+
+  constexpr int kImageSize = 1024;
+
+  std::vector<unsigned char> procedural (int size) {
+    std::vector<unsigned char> rgba (static_cast<std::size_t> (size) * size * 4);
+    for (int y = 0; y < size; ++y) {
+      for (int x = 0; x < size; ++x) {
+        unsigned char* texel = rgba.data () + (static_cast<std::size_t> (y) * size + x) * 4;
+        texel[0] = static_cast<unsigned char> (x ^ y);
+        texel[1] = static_cast<unsigned char> ((x * y) >> 6);
+        texel[2] = static_cast<unsigned char> (x + y);
+        texel[3] = 255;
+      }
+    }
+    return rgba;
+  }
+
+  void appendBytes (void* context, void* data, int size) {
+    auto* out = static_cast<std::vector<unsigned char>*> (context);
+    out->insert (out->end (), static_cast<unsigned char*> (data),
+                 static_cast<unsigned char*> (data) + size);
+  }
+
+  const std::vector<unsigned char>& encodedImage (bool jpeg) {
+    static const std::vector<unsigned char> rgba = procedural (kImageSize);
+    static const std::vector<unsigned char> png = [] {
+      std::vector<unsigned char> out;
+      stbi_write_png_to_func (appendBytes, &out, kImageSize, kImageSize, 4, rgba.data (),
+                              kImageSize * 4);
+      return out;
+    }();
+    static const std::vector<unsigned char> jpg = [] {
+      std::vector<unsigned char> out;
+      stbi_write_jpg_to_func (appendBytes, &out, kImageSize, kImageSize, 4, rgba.data (), 90);
+      return out;
+    }();
+    return jpeg ? jpg : png;
+  }
+
+  void decodeImage (benchmark::State& state, bool jpeg) {
+    const std::vector<unsigned char>& encoded = encodedImage (jpeg);
+    const ImageDecodeJob job{ encoded.data (), encoded.size (), 4, false };
+    for (auto _ : state) {
+      DecodedPixels image = ImageDecoder::decode (job);
+      if (!image.ok ()) {
+        state.SkipWithError (image.error.c_str ());
+        break;
+      }
+      benchmark::DoNotOptimize (image.pixels.data ());
+    }
+    state.SetItemsProcessed (state.iterations ());
+  }
+  BENCHMARK_CAPTURE (decodeImage, png, false)
+      ->Name ("Decode/Png1024")
+      ->Unit (benchmark::kMillisecond);
+  BENCHMARK_CAPTURE (decodeImage, jpeg, true)
+      ->Name ("Decode/Jpeg1024")
+      ->Unit (benchmark::kMillisecond);
+
+  // A shader's four channel textures; 0 workers decodes on the calling thread only
+  void decodeBatch (benchmark::State& state) {
+    const std::vector<unsigned char>& encoded = encodedImage (false);
+    const std::vector<ImageDecodeJob> jobs (4, ImageDecodeJob{ encoded.data (), encoded.size () });
+    ImageDecoder decoder (static_cast<std::size_t> (state.range (0)));
+    for (auto _ : state) {
+      std::vector<DecodedPixels> images = decoder.decodeBatch (jobs);
+      benchmark::DoNotOptimize (images.data ());
+    }
+    state.SetItemsProcessed (static_cast<int64_t> (state.iterations ()) * jobs.size ());
+  }
+  BENCHMARK (decodeBatch)
+      ->Name ("Decode/Batch4xPng1024")
+      ->ArgName ("workers")
+      ->Arg (0)
+      ->Arg (static_cast<int64_t> (ImageDecoder::defaultWorkerCount ()))
+      ->Unit (benchmark::kMillisecond)
+      ->UseRealTime ();
+
+  // CPU fallback for KTX2 textures the GPU cannot sample
+  void transcodeBlocks (benchmark::State& state, BlockCompression::Format format) {
+    static const std::vector<unsigned char> rgba = procedural (kImageSize);
+    const std::vector<std::uint8_t> blocks = BlockCompression::compress (format, rgba.data (),
+                                                                         kImageSize, kImageSize);
+    std::vector<std::uint8_t> out (rgba.size ());
+    for (auto _ : state) {
+      BlockCompression::decompress (format, blocks.data (), kImageSize, kImageSize, out.data ());
+      benchmark::DoNotOptimize (out.data ());
+    }
+    state.SetBytesProcessed (static_cast<int64_t> (state.iterations ()) * out.size ());
+  }
+  BENCHMARK_CAPTURE (transcodeBlocks, bc1, BlockCompression::Format::Bc1)
+      ->Name ("Transcode/Bc1_1024")
+      ->Unit (benchmark::kMillisecond);
+  BENCHMARK_CAPTURE (transcodeBlocks, etc2rgba, BlockCompression::Format::Etc2Rgba)
+      ->Name ("Transcode/Etc2Rgba1024")
+      ->Unit (benchmark::kMillisecond);
+} // namespace
@@ -0,0 +1,130 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Logger throughput per output mode, single and multi-threaded producers
+
+#include <Logger/Logger.hpp>
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <iostream>
+#include <streambuf>
+
+namespace {
+  enum class LogMode { Filtered, Console, SyncFile, AsyncFile, FlightRecorder, ConsoleAndFile };
+
+  constexpr const char* kLogFile = "corelib_bench_log.txt";
+  constexpr const char* kCrashFile = "corelib_bench_crash.txt";
+
+  // Console output goes here, so the terminal does not dominate the measurement
+  class NullBuffer : public std::streambuf {
+  protected:
+    int overflow (int c) override {
+      return c;
+    }
+    std::streamsize xsputn (const char*, std::streamsize n) override {
+      return n;
+    }
+  };
+
+  NullBuffer g_nullBuffer;
+  std::streambuf* g_coutBuffer = nullptr;
+  Logger::Level g_previousLevel = Logger::Level::LOG_INFO;
+
+  // Called once before the producer threads start
+  template <LogMode Mode> void setupLogger (const benchmark::State&) {
+    Logger& logger = Logger::getInstance ();
+    g_previousLevel = logger.getLevel ();
+    logger.setConsoleOutput (false);
+    logger.setLevel (Logger::Level::LOG_DEBUG);
+    switch (Mode) {
+    case LogMode::Filtered:
+      logger.setLevel (Logger::Level::LOG_ERROR); // every LOG_I is rejected
+      break;
+    case LogMode::Console:
+      g_coutBuffer = std::cout.rdbuf (&g_nullBuffer);
+      logger.setConsoleOutput (true);
+      break;
+    case LogMode::SyncFile:
+      logger.enableFileLogging (kLogFile);
+      break;
+    case LogMode::AsyncFile:
+      logger.enableFileLogging (kLogFile);
+      logger.setAsync (true);
+      break;
+    case LogMode::FlightRecorder:
+      logger.enableFlightRecorder (kCrashFile);
+      break;
+    case LogMode::ConsoleAndFile:
+      g_coutBuffer = std::cout.rdbuf (&g_nullBuffer);
+      logger.setConsoleOutput (true);
+      logger.enableFileLogging (kLogFile);
+      break;
+    }
+  }
+
+  void teardownLogger (const benchmark::State&) {
+    Logger& logger = Logger::getInstance ();
+    logger.flush ();
+    logger.setAsync (false);
+    logger.disableFileLogging ();
+    logger.disableFlightRecorder ();
+    if (g_coutBuffer != nullptr) {
+      std::cout.rdbuf (g_coutBuffer);
+      g_coutBuffer = nullptr;
+    }
+    logger.setConsoleOutput (true);
+    logger.setLevel (g_previousLevel);
+    std::remove (kLogFile);
+    std::remove (kCrashFile);
+  }
+
+  // Producer side cost; in async mode the writer thread drains in the background and teardown
+  // waits for it
+  void logLines (benchmark::State& state) {
+    std::int64_t line = 0;
+    for (auto _ : state) {
+      LOG_I_FMT ("benchmark line {} value {}", line, line * 3);
+      ++line;
+    }
+    state.SetItemsProcessed (state.iterations ());
+  }
+} // namespace
+
+BENCHMARK (logLines)
+    ->Name ("Logger/Filtered")
+    ->Setup (setupLogger<LogMode::Filtered>)
+    ->Teardown (teardownLogger)
+    ->Threads (1)
+    ->Threads (4);
+BENCHMARK (logLines)
+    ->Name ("Logger/Console")
+    ->Setup (setupLogger<LogMode::Console>)
+    ->Teardown (teardownLogger)
+    ->Threads (1)
+    ->Threads (4);
+BENCHMARK (logLines)
+    ->Name ("Logger/SyncFile")
+    ->Setup (setupLogger<LogMode::SyncFile>)
+    ->Teardown (teardownLogger)
+    ->Threads (1)
+    ->Threads (4)
+    ->Threads (8);
+BENCHMARK (logLines)
+    ->Name ("Logger/AsyncFile")
+    ->Setup (setupLogger<LogMode::AsyncFile>)
+    ->Teardown (teardownLogger)
+    ->Threads (1)
+    ->Threads (4)
+    ->Threads (8);
+BENCHMARK (logLines)
+    ->Name ("Logger/FlightRecorder")
+    ->Setup (setupLogger<LogMode::FlightRecorder>)
+    ->Teardown (teardownLogger)
+    ->Threads (1)
+    ->Threads (4);
+// The header timestamp is rendered for the console and for the file on every line, the path the
+// per-thread timestamp cache speeds up (before/after numbers in tests/README_LoggerTest.md)
+BENCHMARK (logLines)
+    ->Name ("Logger/ConsoleAndFile")
+    ->Setup (setupLogger<LogMode::ConsoleAndFile>)
+    ->Teardown (teardownLogger)
+    ->Threads (1);
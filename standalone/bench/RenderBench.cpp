@@ -0,0 +1,205 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Headless frame rendering: converted shaders drawn into an offscreen framebuffer
+
+#include <Shaders/ShaderRegistry.hpp>
+#include <benchmark/benchmark.h>
+
+#define SDL_MAIN_HANDLED
+#include <GL/glew.h>
+#include <SDL.h>
+
+#include <memory>
+#include <string>
+
+namespace {
+  constexpr int kWidth = 1280;
+  constexpr int kHeight = 720;
+
+  // Hidden window with a GL 3.3 core context and a framebuffer of the bench size. Created on
+  // first use; benchmarks are skipped where no display or GL driver is available (CI).
+  class HeadlessGl {
+  public:
+    static HeadlessGl* instance () {
+      static std::unique_ptr<HeadlessGl> gl = [] {
+        auto created = std::make_unique<HeadlessGl> ();
+        return created->init () ? std::move (created) : nullptr;
+      }();
+      return gl.get ();
+    }
+
+    ~HeadlessGl () {
+      if (context_ != nullptr) {
+        glDeleteFramebuffers (1, &framebuffer_);
+        glDeleteTextures (1, &colorTexture_);
+        glDeleteBuffers (1, &vbo_);
+        glDeleteVertexArrays (1, &vao_);
+        SDL_GL_DeleteContext (context_);
+      }
+      if (window_ != nullptr) {
+        SDL_DestroyWindow (window_);
+      }
+      SDL_Quit ();
+    }
+
+    GLuint compile (const std::string& vertexSource, const std::string& fragmentSource) {
+      const GLuint vertex = compileStage (GL_VERTEX_SHADER, vertexSource);
+      const GLuint fragment = compileStage (GL_FRAGMENT_SHADER, fragmentSource);
+      GLuint program = 0;
+      if (vertex != 0 && fragment != 0) {
+        program = glCreateProgram ();
+        glAttachShader (program, vertex);
+        glAttachShader (program, fragment);
+        glLinkProgram (program);
+        GLint linked = GL_FALSE;
+        glGetProgramiv (program, GL_LINK_STATUS, &linked);
+        if (linked != GL_TRUE) {
+          glDeleteProgram (program);
+          program = 0;
+        }
+      }
+      glDeleteShader (vertex);
+      glDeleteShader (fragment);
+      return program;
+    }
+
+    void bindTarget () {
+      glBindFramebuffer (GL_FRAMEBUFFER, framebuffer_);
+      glViewport (0, 0, kWidth, kHeight);
+      glBindVertexArray (vao_);
+    }
+
+  private:
+    bool init () {
+      SDL_SetMainReady ();
+      if (SDL_Init (SDL_INIT_VIDEO) != 0) {
+        return false;
+      }
+      SDL_GL_SetAttribute (SDL_GL_CONTEXT_PROFILE_MASK, SDL_GL_CONTEXT_PROFILE_CORE);
+      SDL_GL_SetAttribute (SDL_GL_CONTEXT_MAJOR_VERSION, 3);
+      SDL_GL_SetAttribute (SDL_GL_CONTEXT_MINOR_VERSION, 3);
+      window_ = SDL_CreateWindow ("corelib_bench", SDL_WINDOWPOS_UNDEFINED,
+                                  SDL_WINDOWPOS_UNDEFINED, 64, 64,
+                                  SDL_WINDOW_OPENGL | SDL_WINDOW_HIDDEN);
+      context_ = window_ != nullptr ? SDL_GL_CreateContext (window_) : nullptr;
+      if (context_ == nullptr) {
+        return false;
+      }
+      SDL_GL_MakeCurrent (window_, context_);
+      SDL_GL_SetSwapInterval (0);
+      glewExperimental = GL_TRUE;
+      if (glewInit () != GLEW_OK) {
+        return false;
+      }
+
+      glGenTextures (1, &colorTexture_);
+      glBindTexture (GL_TEXTURE_2D, colorTexture_);
+      glTexImage2D (GL_TEXTURE_2D, 0, GL_RGBA8, kWidth, kHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE,
+                    nullptr);
+      glGenFramebuffers (1, &framebuffer_);
+      glBindFramebuffer (GL_FRAMEBUFFER, framebuffer_);
+      glFramebufferTexture2D (GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTexture_,
+                              0);
+      if (glCheckFramebufferStatus (GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        return false;
+      }
+
+      // Two triangles over the viewport, like PlatformManager::setupQuad
+      const float quad[] = { -1.f, -1.f, 1.f, -1.f, 1.f, 1.f, -1.f, -1.f, 1.f, 1.f, -1.f, 1.f };
+      glGenVertexArrays (1, &vao_);
+      glBindVertexArray (vao_);
+      glGenBuffers (1, &vbo_);
+      glBindBuffer (GL_ARRAY_BUFFER, vbo_);
+      glBufferData (GL_ARRAY_BUFFER, sizeof quad, quad, GL_STATIC_DRAW);
+      glEnableVertexAttribArray (0);
+      glVertexAttribPointer (0, 2, GL_FLOAT, GL_FALSE, 2 * sizeof (float), nullptr);
+      return true;
+    }
+
+    static GLuint compileStage (GLenum stage, const std::string& source) {
+      const GLuint shader = glCreateShader (stage);
+      const char* text = source.c_str ();
+      glShaderSource (shader, 1, &text, nullptr);
+      glCompileShader (shader);
+      GLint compiled = GL_FALSE;
+      glGetShaderiv (shader, GL_COMPILE_STATUS, &compiled);
+      if (compiled != GL_TRUE) {
+        glDeleteShader (shader);
+        return 0;
+      }
+      return shader;
+    }
+
+    SDL_Window* window_ = nullptr;
+    SDL_GLContext context_ = nullptr;
+    GLuint framebuffer_ = 0;
+    GLuint colorTexture_ = 0;
+    GLuint vao_ = 0;
+    GLuint vbo_ = 0;
+  };
+
+  // One full frame per iteration; glFinish makes the GPU time part of the measurement
+  void renderFrame (benchmark::State& state, const char* shaderName,
+                    ShaderQuality quality = ShaderQuality::High) {
+    HeadlessGl* gl = HeadlessGl::instance ();
+    if (gl == nullptr) {
+      state.SkipWithError ("no GL context (headless machine?)");
+      return;
+    }
+    const ShaderRegistry::Shader* shader = ShaderRegistry::instance ().find (shaderName);
+    if (shader == nullptr) {
+      state.SkipWithError ("shader not registered");
+      return;
+    }
+    const ShaderConversionResult& converted
+        = shader->conversion (ShaderTarget::Desktop330, quality);
+    const GLuint program = converted.success
+                               ? gl->compile (converted.vertexShader, converted.fragmentShader)
+                               : 0;
+    if (program == 0) {
+      state.SkipWithError ("shader failed to convert or compile");
+      return;
+    }
+
+    gl->bindTarget ();
+    glUseProgram (program);
+    glUniform3f (glGetUniformLocation (program, "iResolution"), kWidth, kHeight, 1.0f);
+    const GLint timeLocation = glGetUniformLocation (program, "iTime");
+    float time = 0.0f;
+    for (auto _ : state) {
+      glUniform1f (timeLocation, time += 1.0f / 60.0f);
+      glDrawArrays (GL_TRIANGLES, 0, 6);
+      glFinish ();
+    }
+    glDeleteProgram (program);
+    state.counters["fps"] = benchmark::Counter (static_cast<double> (state.iterations ()),
+                                                benchmark::Counter::kIsRate);
+    state.counters["scaled"] = converted.qualityScaledBounds;
+  }
+
+  BENCHMARK_CAPTURE (renderFrame, Seascape, "Seascape")
+      ->Name ("RenderFrame/Seascape720p")
+      ->Unit (benchmark::kMillisecond)
+      ->UseRealTime ();
+  // Lower quality tiers of the same shaders, what the governor trades for frame time
+  BENCHMARK_CAPTURE (renderFrame, SeascapeMedium, "Seascape", ShaderQuality::Medium)
+      ->Name ("RenderFrame/Seascape720p/Medium")
+      ->Unit (benchmark::kMillisecond)
+      ->UseRealTime ();
+  BENCHMARK_CAPTURE (renderFrame, SeascapeLow, "Seascape", ShaderQuality::Low)
+      ->Name ("RenderFrame/Seascape720p/Low")
+      ->Unit (benchmark::kMillisecond)
+      ->UseRealTime ();
+  BENCHMARK_CAPTURE (renderFrame, Fireflame, "Fireflame")
+      ->Name ("RenderFrame/Fireflame720p")
+      ->Unit (benchmark::kMillisecond)
+      ->UseRealTime ();
+  BENCHMARK_CAPTURE (renderFrame, FireflameLow, "Fireflame", ShaderQuality::Low)
+      ->Name ("RenderFrame/Fireflame720p/Low")
+      ->Unit (benchmark::kMillisecond)
+      ->UseRealTime ();
+  BENCHMARK_CAPTURE (renderFrame, Tunnel, "Tunnel")
+      ->Name ("RenderFrame/Tunnel720p")
+      ->Unit (benchmark::kMillisecond)
+      ->UseRealTime ();
+} // namespace
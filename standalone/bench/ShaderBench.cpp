@@ -0,0 +1,44 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// ShaderToy -> GLSL conversion, one benchmark per shader and target
+
+#include <Shaders/ShaderRegistry.hpp>
+#include <benchmark/benchmark.h>
+#include <string>
+
+namespace {
+  const ShaderTarget kTargets[] = { ShaderTarget::WebGL1, ShaderTarget::WebGL2,
+                                    ShaderTarget::Desktop330, ShaderTarget::Desktop420 };
+
+  // One convertor per benchmark; converts every iteration, the registry's cached conversion
+  // is not used
+  void convertShader (benchmark::State& state, const ShaderRegistry::Shader* shader,
+                      ShaderTarget target) {
+    ShaderConvertor convertor;
+    const std::string code (shader->source ());
+    for (auto _ : state) {
+      ShaderConversionResult result = convertor.convertFromShaderToy (code, target);
+      benchmark::DoNotOptimize (result.fragmentShader.data ());
+      if (!result.success) {
+        state.SkipWithError (result.errorMessage.c_str ());
+        break;
+      }
+    }
+    state.SetBytesProcessed (static_cast<int64_t> (state.iterations ()) * code.size ());
+  }
+
+  // ShaderConvert/<shader>/<target> for every registered shader
+  [[maybe_unused]] const bool kRegistered = [] {
+    const ShaderRegistry& registry = ShaderRegistry::instance ();
+    for (std::size_t i = 0; i < registry.size (); ++i) {
+      const ShaderRegistry::Shader& shader = registry.at (i);
+      for (ShaderTarget target : kTargets) {
+        const std::string name = "ShaderConvert/" + shader.name () + "/"
+                                 + ShaderUtils::getShaderTargetString (target);
+        benchmark::RegisterBenchmark (name.c_str (), convertShader, &shader, target)
+            ->Unit (benchmark::kMicrosecond);
+      }
+    }
+    return true;
+  }();
+} // namespace
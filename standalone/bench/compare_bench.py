@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+# MIT License
+# Copyright (c) 2024-2025 Tomáš Mark
+# Compares two corelib_bench JSON results (--benchmark_out_format=json) and fails on regressions
+
+import argparse
+import json
+import re
+import sys
+
+
+def load(path, metric):
+    """benchmark name -> time in ns; mean aggregates win over single runs"""
+    with open(path, encoding="utf-8") as handle:
+        data = json.load(handle)
+    scale = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+    results = {}
+    for entry in data.get("benchmarks", []):
+        if entry.get("error_occurred"):
+            continue
+        kind = entry.get("run_type", "iteration")
+        if kind == "aggregate" and entry.get("aggregate_name") != "mean":
+            continue
+        name = entry.get("run_name", entry["name"])
+        if name in results and kind != "aggregate":
+            continue
+        results[name] = entry[metric] * scale[entry.get("time_unit", "ns")]
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("baseline", help="stored JSON result")
+    parser.add_argument("current", help="fresh JSON result")
+    parser.add_argument("--metric", choices=("real_time", "cpu_time"), default="real_time")
+    parser.add_argument("--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    parser.add_argument("--filter", default="", help="regex, compare matching benchmarks only")
+    args = parser.parse_args()
+
+    if not args.baseline:
+        print("compare_bench: no baseline given (set BENCH_BASELINE)", file=sys.stderr)
+        return 2
+
+    baseline = load(args.baseline, args.metric)
+    current = load(args.current, args.metric)
+    pattern = re.compile(args.filter)
+    names = sorted(n for n in baseline.keys() & current.keys() if pattern.search(n))
+
+    regressions = 0
+    width = max((len(n) for n in names), default=9)
+    print(f"{'benchmark':<{width}} {'baseline':>12} {'current':>12} {'change':>8}")
+    for name in names:
+        before, after = baseline[name], current[name]
+        change = (after - before) / before * 100.0 if before > 0 else 0.0
+        mark = ""
+        if change > args.threshold:
+            mark = "  REGRESSION"
+            regressions += 1
+        print(f"{name:<{width}} {before:>10.0f}ns {after:>10.0f}ns {change:>+7.1f}%{mark}")
+
+    for name in sorted(baseline.keys() - current.keys()):
+        if pattern.search(name):
+            print(f"{name:<{width}} missing in current run")
+
+    print(f"\n{len(names)} compared, {regressions} slower than {args.threshold:g}%")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -4,6 +4,8 @@
 #include "CoreLib/CoreLib.hpp"
 #include "Logger/Logger.hpp"
 #include "Utils/Utils.hpp"
+#include "Utils/Profiler.hpp"
+#include "ShaderCli.hpp"
 
 #include <cxxopts.hpp>
 #include <filesystem>
@@ -30,11 +32,12 @@ namespace AppContext {
 }
 
 std::unique_ptr<dotname::CoreLib> uniqueLib;
+std::string tracePath;
 
 int handlesArguments (int argc, const char* argv[]) {
   try {
     auto options = std::make_unique<cxxopts::Options> (argv[0], AppContext::standaloneName);
-    options->positional_help ("[optional args]").show_positional_help ();
+    options->positional_help ("[optional args] | convert|bench <shaders> --help").show_positional_help ();
     options->set_width (80);
     options->set_tab_expansion ();
     options->add_options () ("h,help", "Show help");
@@ -42,6 +45,12 @@ int handlesArguments (int argc, const char* argv[]) {
                              cxxopts::value<bool> ()->default_value ("false"));
     options->add_options () ("2,log2file", "Log to file",
                              cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("3,trace", "Write a Chrome trace (needs -DENABLE_PROFILING=ON)",
+                             cxxopts::value<std::string> ());
+    options->add_options () ("4,render-thread", "Render on a separate thread (desktop)",
+                             cxxopts::value<bool> ()->default_value ("false"));
+    options->add_options () ("5,jobs", "Job system worker threads (0 = one per core)",
+                             cxxopts::value<unsigned> ()->default_value ("0"));
     const auto result = options->parse (argc, argv);
 
     if (result.count ("help")) {
@@ -51,12 +60,21 @@ int handlesArguments (int argc, const char* argv[]) {
 
     if (result["log2file"].as<bool> ()) {
       LOG.enableFileLogging (std::string (AppContext::standaloneName) + ".log");
+      // File output stays buffered, the last records survive a crash via the flight recorder
+      LOG.enableFlightRecorder (std::string (AppContext::standaloneName) + ".crash.log");
       LOG_D_STREAM << "Logging to file enabled [-2]" << std::endl;
     }
 
+    if (result.count ("trace")) {
+      tracePath = result["trace"].as<std::string> ();
+    }
+
     if (!result.count ("omit")) {
       // uniqueLib = std::make_unique<dotname::DotNameLib> ();
-      uniqueLib = std::make_unique<dotname::CoreLib> (AppContext::assetsPath);
+      dotname::CoreLibOptions libOptions;
+      libOptions.threadedRendering = result["render-thread"].as<bool> ();
+      libOptions.jobWorkers = result["jobs"].as<unsigned> ();
+      uniqueLib = std::make_unique<dotname::CoreLib> (AppContext::assetsPath, libOptions);
     } else {
       LOG_D_STREAM << "Loading library omitted [-1]" << std::endl;
     }
@@ -78,19 +96,15 @@ int handlesArguments (int argc, const char* argv[]) {
 
 // unused right now
 int printAssets (const std::filesystem::path& assetsPath) {
-  try {
-    auto files = FileManager::listFiles (assetsPath);
-    if (files.empty ()) {
-      LOG_D_STREAM << "No assets found in " << assetsPath << std::endl;
-      return 0;
-    }
+  // Build-time index, no directory listing needed
+  if (AssetIndex::size () == 0) {
+    LOG_D_STREAM << "No assets found in " << assetsPath << std::endl;
+    return 0;
+  }
 
-    for (const auto& file : files) {
-      LOG_D_STREAM << file << std::endl;
-    }
-  } catch (const std::exception& e) {
-    std::cerr << "Error: " << e.what () << std::endl;
-    return 1;
+  for (std::size_t i = 0; i < AssetIndex::size (); ++i) {
+    const auto entry = AssetIndex::at (i);
+    LOG_D_STREAM << (assetsPath / entry.path) << " (" << entry.size << " B)" << std::endl;
   }
   return 0;
 }
@@ -108,15 +122,26 @@ int runApp (int argc, const char* argv[]) {
   LOG_I_STREAM << "Emscripten C++ with pthreads support" << std::endl;
 #endif
 
+  // Headless shader tools, no library and no window
+  if (argc > 1 && ShaderCli::isCommand (argv[1])) {
+    return ShaderCli::run (argc - 1, argv + 1);
+  }
+
   if (handlesArguments (argc, argv) != 0) {
     return 1;
   }
 
-  // Performance::simpleCpuBenchmark (); // default is off
-
   // I know it is smartpointer, but ... why not
   uniqueLib = nullptr;
 
+  if (!tracePath.empty ()) {
+    if (Profiler::writeChromeTrace (tracePath)) {
+      LOG_I_STREAM << "Trace written to " << tracePath << " [-3]" << std::endl;
+    } else {
+      LOG_E_STREAM << "Cannot write trace " << tracePath << std::endl;
+    }
+  }
+
   // demo error
   LOG_E_STREAM << "This is a demo error message" << std::endl;
 
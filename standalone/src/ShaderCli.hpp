@@ -0,0 +1,395 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Headless shader tools: index2 convert / index2 bench
+
+#ifndef __SHADERCLI_H__
+#define __SHADERCLI_H__
+
+#include "Logger/Logger.hpp"
+#include "Shaders/ShaderConvertor.hpp"
+#include "Utils/JobSystem.hpp"
+#include "Utils/Utils.hpp"
+
+#include <cxxopts.hpp>
+#include <nlohmann/json.hpp>
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <filesystem>
+#include <iostream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Both commands take ShaderToy .glsl files or directories of them, convert every file for the
+// selected targets on the job system and report per file timings plus the analysis as JSON.
+// Neither creates a window or a GL context, so they run on build machines.
+namespace ShaderCli {
+  namespace detail {
+    using Clock = std::chrono::steady_clock;
+
+    inline double millisecondsSince (Clock::time_point start) {
+      return std::chrono::duration<double, std::milli> (Clock::now () - start).count ();
+    }
+
+    const ShaderTarget kAllTargets[] = { ShaderTarget::WebGL1, ShaderTarget::WebGL2,
+                                         ShaderTarget::Desktop330, ShaderTarget::Desktop420 };
+
+    // Files as given, *.glsl below directories; sorted so reports are stable
+    inline std::vector<std::filesystem::path> collectInputs (
+        const std::vector<std::string>& inputs) {
+      std::vector<std::filesystem::path> files;
+      for (const std::string& input : inputs) {
+        const std::filesystem::path path (input);
+        if (!std::filesystem::is_directory (path)) {
+          files.push_back (path);
+          continue;
+        }
+        for (const auto& entry : std::filesystem::recursive_directory_iterator (path)) {
+          if (entry.is_regular_file () && entry.path ().extension () == ".glsl") {
+            files.push_back (entry.path ());
+          }
+        }
+      }
+      std::sort (files.begin (), files.end ());
+      return files;
+    }
+
+    // "all" or names as printed by ShaderUtils::getShaderTargetString
+    inline std::optional<std::vector<ShaderTarget>> parseTargets (
+        const std::vector<std::string>& names) {
+      std::vector<ShaderTarget> targets;
+      for (const std::string& name : names) {
+        if (name == "all") {
+          targets.assign (std::begin (kAllTargets), std::end (kAllTargets));
+          continue;
+        }
+        // parseShaderTarget falls back to Desktop330 for anything it does not know
+        const ShaderTarget target = ShaderUtils::parseShaderTarget (name);
+        if (ShaderUtils::getShaderTargetString (target) != name) {
+          LOG_E_STREAM << "Unknown shader target: " << name << std::endl;
+          return std::nullopt;
+        }
+        if (std::find (targets.begin (), targets.end (), target) == targets.end ()) {
+          targets.push_back (target);
+        }
+      }
+      return targets;
+    }
+
+    // Include guard / identifier stem: "dying-universe.glsl" -> DYING_UNIVERSE
+    inline std::string headerName (const std::filesystem::path& file) {
+      std::string name = file.stem ().string ();
+      for (char& c : name) {
+        c = std::isalnum (static_cast<unsigned char> (c))
+                ? static_cast<char> (std::toupper (static_cast<unsigned char> (c)))
+                : '_';
+      }
+      return name;
+    }
+
+    inline nlohmann::json analysisSummary (const ShaderAnalysis& analysis) {
+      return { { "complexityScore", analysis.complexityScore },
+               { "estimatedInstructions", analysis.estimatedInstructions },
+               { "hasLoops", analysis.hasLoops },
+               { "hasConditionals", analysis.hasConditionals },
+               { "hasComplexMath", analysis.hasComplexMath },
+               { "hasAdvancedGLSL", analysis.hasAdvancedGLSL },
+               { "hasCustomFunctions", analysis.hasCustomFunctions },
+               { "hasAudioFeatures", analysis.hasAudioFeatures },
+               { "textureChannels", analysis.textureChannels },
+               { "customFunctions", analysis.customFunctions.size () },
+               { "warnings", analysis.warnings },
+               { "errors", analysis.errors } };
+    }
+
+    // fn (index, file report) for every input; jobs 0 uses the shared job system, otherwise jobs
+    // threads including the calling one. An exception fails only its own file.
+    template <typename Fn>
+    void forEachInput (std::vector<nlohmann::json>& files, std::vector<char>& failed,
+                       unsigned jobs, Fn&& fn) {
+      const auto chunk = [&] (std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+          try {
+            if (!fn (i, files[i])) {
+              failed[i] = 1;
+            }
+          } catch (const std::exception& e) {
+            files[i]["error"] = e.what ();
+            failed[i] = 1;
+          }
+        }
+      };
+      const std::size_t count = files.size ();
+      if (jobs == 0) {
+        JobSystem::shared ().parallelFor (0, count, 1, chunk);
+        return;
+      }
+      JobSystem local (jobs - 1);
+      local.parallelFor (0, count, 1, chunk);
+    }
+
+    // "-" prints to stdout, an empty path only logs the summary
+    inline bool writeReport (const nlohmann::json& report, const std::string& path) {
+      if (path.empty ()) {
+        return true;
+      }
+      if (path == "-") {
+        std::cout << report.dump (2) << std::endl;
+        return true;
+      }
+      try {
+        DotNameUtils::JsonUtils::saveToFile (path, report);
+      } catch (const std::exception& e) {
+        LOG_E_STREAM << e.what () << std::endl;
+        return false;
+      }
+      return true;
+    }
+
+    inline void addCommonOptions (cxxopts::Options& options, const char* defaultJobs) {
+      options.positional_help ("<file.glsl|directory>...").show_positional_help ();
+      options.set_width (80);
+      options.add_options () ("h,help", "Show help");
+      options.add_options () ("inputs", "ShaderToy sources",
+                              cxxopts::value<std::vector<std::string>> ());
+      options.add_options () ("t,targets", "WebGL1,WebGL2,Desktop330,Desktop420 or all",
+                              cxxopts::value<std::vector<std::string>> ()->default_value ("all"));
+      options.add_options () ("r,report", "JSON report file (- for stdout)",
+                              cxxopts::value<std::string> ()->default_value (""));
+      options.add_options () ("j,jobs", "Threads (0 = one per core)",
+                              cxxopts::value<unsigned> ()->default_value (defaultJobs));
+      options.parse_positional ({ "inputs" });
+    }
+
+    // Shared start of both commands: parsed options, inputs and targets, or an exit code
+    struct Invocation {
+      cxxopts::ParseResult options;
+      std::vector<std::filesystem::path> inputs;
+      std::vector<ShaderTarget> targets;
+    };
+
+    inline std::optional<Invocation> parse (cxxopts::Options& options, int argc,
+                                            const char* argv[], int& exitCode) {
+      exitCode = 1;
+      try {
+        Invocation invocation{ options.parse (argc, argv), {}, {} };
+        if (invocation.options.count ("help") || !invocation.options.count ("inputs")) {
+          LOG_I_STREAM << options.help () << std::endl;
+          exitCode = invocation.options.count ("help") ? 0 : 1;
+          return std::nullopt;
+        }
+        invocation.inputs
+            = collectInputs (invocation.options["inputs"].as<std::vector<std::string>> ());
+        const auto targets
+            = parseTargets (invocation.options["targets"].as<std::vector<std::string>> ());
+        if (!targets) {
+          return std::nullopt;
+        }
+        if (invocation.inputs.empty ()) {
+          LOG_E_STREAM << "No .glsl files found" << std::endl;
+          return std::nullopt;
+        }
+        invocation.targets = *targets;
+        return invocation;
+      } catch (const std::exception& e) {
+        LOG_E_STREAM << "error parsing options: " << e.what () << std::endl;
+        return std::nullopt;
+      }
+    }
+
+    inline nlohmann::json targetNames (const std::vector<ShaderTarget>& targets) {
+      nlohmann::json names = nlohmann::json::array ();
+      for (ShaderTarget target : targets) {
+        names.push_back (ShaderUtils::getShaderTargetString (target));
+      }
+      return names;
+    }
+  } // namespace detail
+
+  inline bool isCommand (std::string_view arg) {
+    return arg == "convert" || arg == "bench";
+  }
+
+  // index2 convert <inputs> [-o dir] [-f header|glsl] [-t targets] [-r report.json] [-j n]
+  //   header: <output>/<stem>.hpp with every target (ShaderConvertor::generateHeaderFile), not
+  //           written when any target fails
+  //   glsl:   <output>/<stem>.<target>.vert / .frag
+  inline int convert (int argc, const char* argv[]) {
+    cxxopts::Options options ("index2 convert", "Convert ShaderToy shaders for GL targets");
+    detail::addCommonOptions (options, "0");
+    options.add_options () ("o,output", "Output directory",
+                            cxxopts::value<std::string> ()->default_value ("."));
+    options.add_options () ("f,format", "header or glsl",
+                            cxxopts::value<std::string> ()->default_value ("header"));
+    int exitCode = 0;
+    const auto invocation = detail::parse (options, argc, argv, exitCode);
+    if (!invocation) {
+      return exitCode;
+    }
+    const std::string format = invocation->options["format"].as<std::string> ();
+    if (format != "header" && format != "glsl") {
+      LOG_E_STREAM << "Unknown format: " << format << std::endl;
+      return 1;
+    }
+    const std::filesystem::path output = invocation->options["output"].as<std::string> ();
+    std::error_code error;
+    std::filesystem::create_directories (output, error);
+
+    const auto& inputs = invocation->inputs;
+    const auto& targets = invocation->targets;
+    std::vector<nlohmann::json> files (inputs.size ());
+    std::vector<char> failed (inputs.size (), 0);
+    const auto start = detail::Clock::now ();
+
+    const auto convertFile = [&] (std::size_t index, nlohmann::json& file) {
+      const std::filesystem::path& input = inputs[index];
+      file["file"] = input.generic_string ();
+      const auto fileStart = detail::Clock::now ();
+      // A header missing a target would only fail where it is compiled, so a failed file gets
+      // none, and a header left by an earlier run must not pass for this run's output
+      const std::filesystem::path header = output / (input.stem ().string () + ".hpp");
+      if (format == "header") {
+        std::error_code staleError;
+        std::filesystem::remove (header, staleError);
+      }
+      const std::string code = DotNameUtils::FileIO::readFile (input);
+      bool ok = true;
+
+      // One convertor per file, its regex cache is not shared between threads
+      ShaderConvertor convertor;
+      std::vector<ShaderConversionResult> results;
+      nlohmann::json perTarget = nlohmann::json::array ();
+      for (ShaderTarget target : targets) {
+        const auto targetStart = detail::Clock::now ();
+        results.push_back (convertor.convertFromShaderToy (code, target));
+        const ShaderConversionResult& result = results.back ();
+        nlohmann::json entry = { { "target", ShaderUtils::getShaderTargetString (target) },
+                                 { "ok", result.success },
+                                 { "ms", detail::millisecondsSince (targetStart) } };
+        if (!result.success) {
+          entry["error"] = result.errorMessage;
+          ok = false;
+        } else if (format == "glsl") {
+          const std::string base = (output / input.stem ()).string () + "."
+                                   + ShaderUtils::getShaderTargetString (target);
+          DotNameUtils::FileIO::writeFile (base + ".vert", result.vertexShader);
+          DotNameUtils::FileIO::writeFile (base + ".frag", result.fragmentShader);
+          entry["output"] = base + ".frag";
+        }
+        perTarget.push_back (std::move (entry));
+      }
+      if (format == "header" && ok) {
+        DotNameUtils::FileIO::writeFile (
+            header, convertor.generateHeaderFile (results, detail::headerName (input)));
+        file["output"] = header.generic_string ();
+      }
+      file["targets"] = std::move (perTarget);
+      file["analysis"] = detail::analysisSummary (convertor.analyzeShaderCode (code));
+      file["ms"] = detail::millisecondsSince (fileStart);
+      return ok;
+    };
+    detail::forEachInput (files, failed, invocation->options["jobs"].as<unsigned> (),
+                          convertFile);
+
+    const double wallMs = detail::millisecondsSince (start);
+    const auto failures = static_cast<std::size_t> (std::count (failed.begin (), failed.end (), 1));
+    nlohmann::json report = { { "command", "convert" },
+                              { "format", format },
+                              { "targets", detail::targetNames (targets) },
+                              { "files", files },
+                              { "summary",
+                                { { "files", inputs.size () },
+                                  { "failed", failures },
+                                  { "wallMs", wallMs } } } };
+    LOG_I_STREAM << "Converted " << inputs.size () - failures << " of " << inputs.size ()
+                 << " shaders for " << targets.size () << " targets in " << wallMs << " ms"
+                 << std::endl;
+    if (!detail::writeReport (report, invocation->options["report"].as<std::string> ())) {
+      return 1;
+    }
+    return failures == 0 ? 0 : 1;
+  }
+
+  // index2 bench <inputs> [-n iterations] [-t targets] [-r report.json] [-j n]
+  // Converts every file for every target n times without writing anything. One thread by
+  // default so the timings are not skewed by contention; -j measures batch throughput instead.
+  inline int bench (int argc, const char* argv[]) {
+    cxxopts::Options options ("index2 bench", "Time ShaderToy conversions");
+    detail::addCommonOptions (options, "1");
+    options.add_options () ("n,iterations", "Conversions per file and target",
+                            cxxopts::value<unsigned> ()->default_value ("10"));
+    int exitCode = 0;
+    const auto invocation = detail::parse (options, argc, argv, exitCode);
+    if (!invocation) {
+      return exitCode;
+    }
+    const unsigned iterations = std::max (1u, invocation->options["iterations"].as<unsigned> ());
+    const auto& inputs = invocation->inputs;
+    const auto& targets = invocation->targets;
+    std::vector<nlohmann::json> files (inputs.size ());
+    std::vector<char> failed (inputs.size (), 0);
+    const auto start = detail::Clock::now ();
+
+    const auto benchFile = [&] (std::size_t index, nlohmann::json& file) {
+      file["file"] = inputs[index].generic_string ();
+      const std::string code = DotNameUtils::FileIO::readFile (inputs[index]);
+      bool allOk = true;
+      ShaderConvertor convertor;
+      nlohmann::json perTarget = nlohmann::json::array ();
+      for (ShaderTarget target : targets) {
+        std::vector<double> samples;
+        samples.reserve (iterations);
+        bool ok = true;
+        for (unsigned i = 0; i < iterations && ok; ++i) {
+          const auto sampleStart = detail::Clock::now ();
+          ok = convertor.convertFromShaderToy (code, target).success;
+          samples.push_back (detail::millisecondsSince (sampleStart));
+        }
+        std::sort (samples.begin (), samples.end ());
+        double sum = 0.0;
+        for (double sample : samples) {
+          sum += sample;
+        }
+        perTarget.push_back ({ { "target", ShaderUtils::getShaderTargetString (target) },
+                               { "ok", ok },
+                               { "iterations", samples.size () },
+                               { "minMs", samples.front () },
+                               { "medianMs", samples[samples.size () / 2] },
+                               { "meanMs", sum / static_cast<double> (samples.size ()) } });
+        allOk = allOk && ok;
+      }
+      file["targets"] = std::move (perTarget);
+      file["analysis"] = detail::analysisSummary (convertor.analyzeShaderCode (code));
+      return allOk;
+    };
+    detail::forEachInput (files, failed, invocation->options["jobs"].as<unsigned> (), benchFile);
+
+    const double wallMs = detail::millisecondsSince (start);
+    const auto failures = static_cast<std::size_t> (std::count (failed.begin (), failed.end (), 1));
+    nlohmann::json report = { { "command", "bench" },
+                              { "iterations", iterations },
+                              { "targets", detail::targetNames (targets) },
+                              { "files", files },
+                              { "summary",
+                                { { "files", inputs.size () },
+                                  { "failed", failures },
+                                  { "wallMs", wallMs } } } };
+    LOG_I_STREAM << "Benchmarked " << inputs.size () << " shaders x " << targets.size ()
+                 << " targets x " << iterations << " in " << wallMs << " ms" << std::endl;
+    if (!detail::writeReport (report, invocation->options["report"].as<std::string> ())) {
+      return 1;
+    }
+    return failures == 0 ? 0 : 1;
+  }
+
+  // argv[0] is the command name
+  inline int run (int argc, const char* argv[]) {
+    const std::string_view command = argv[0];
+    return command == "convert" ? convert (argc, argv) : bench (argc, argv);
+  }
+} // namespace ShaderCli
+
+#endif // __SHADERCLI_H__
@@ -0,0 +1,91 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Byte-budgeted LRU cache of decoded assets
+
+#include "../../src/Assets/AssetCache.hpp"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+namespace {
+  struct Pixels {
+    std::vector<unsigned char> data;
+  };
+
+  std::pair<std::shared_ptr<const Pixels>, std::size_t> makePixels (std::size_t bytes) {
+    auto pixels = std::make_shared<Pixels> ();
+    pixels->data.resize (bytes);
+    return { pixels, bytes };
+  }
+}
+
+TEST (AssetCacheTest, HitsMissesAndLruEviction) {
+  AssetCache<Pixels> cache (300);
+  const std::string a = AssetCache<Pixels>::makeKey ("a.png", "c4");
+  const std::string b = AssetCache<Pixels>::makeKey ("b.png", "c4");
+  const std::string c = AssetCache<Pixels>::makeKey ("c.png", "c4");
+  EXPECT_EQ (a, "a.png#c4");
+
+  int decodes = 0;
+  auto decode = [&] {
+    ++decodes;
+    return makePixels (100);
+  };
+  cache.getOrCreate (a, decode);
+  cache.getOrCreate (b, decode);
+  cache.getOrCreate (c, decode);
+  EXPECT_EQ (decodes, 3);
+  EXPECT_EQ (cache.stats ().bytesResident, 300u);
+
+  // Same key with other decode parameters is a different entry
+  EXPECT_EQ (cache.find (AssetCache<Pixels>::makeKey ("a.png", "c3")), nullptr);
+
+  cache.getOrCreate (a, decode); // hit, a becomes most recent
+  EXPECT_EQ (decodes, 3);
+  cache.getOrCreate ("d.png#c4", decode); // over budget, b is least recent
+  EXPECT_EQ (cache.find (b), nullptr);
+  EXPECT_NE (cache.find (a), nullptr);
+  EXPECT_NE (cache.find (c), nullptr);
+
+  const auto stats = cache.stats ();
+  EXPECT_EQ (stats.evictions, 1u);
+  EXPECT_EQ (stats.entries, 3u);
+  EXPECT_EQ (stats.bytesResident, 300u);
+  EXPECT_EQ (stats.bytesBudget, 300u);
+  EXPECT_EQ (stats.hits, 3u);
+  EXPECT_EQ (stats.misses, 6u); // a, b, c, d, a#c3, b
+}
+
+TEST (AssetCacheTest, ReferencedEntriesSurviveEviction) {
+  AssetCache<Pixels> cache (250);
+  AssetCache<Pixels>::Handle held = cache.getOrCreate ("held", [] { return makePixels (200); });
+  cache.getOrCreate ("other", [] { return makePixels (100); });
+
+  // "held" is least recent but still in use, so "other" goes instead
+  cache.getOrCreate ("third", [] { return makePixels (10); });
+  EXPECT_NE (cache.find ("held"), nullptr);
+  EXPECT_EQ (cache.find ("other"), nullptr);
+
+  // Once released it can be evicted, the handle itself stays valid until then
+  EXPECT_EQ (held->data.size (), 200u);
+  held.reset ();
+  EXPECT_NE (cache.find ("third"), nullptr); // "held" becomes least recent
+  cache.setBudget (100);
+  EXPECT_EQ (cache.find ("held"), nullptr);
+  EXPECT_EQ (cache.stats ().bytesResident, 10u);
+  EXPECT_EQ (cache.stats ().evictions, 2u);
+
+  // Failed decodes are not cached
+  int attempts = 0;
+  auto fail = [&] () -> std::pair<std::shared_ptr<const Pixels>, std::size_t> {
+    ++attempts;
+    return { nullptr, 0 };
+  };
+  EXPECT_EQ (cache.getOrCreate ("broken", fail), nullptr);
+  EXPECT_EQ (cache.getOrCreate ("broken", fail), nullptr);
+  EXPECT_EQ (attempts, 2);
+
+  cache.clear ();
+  EXPECT_EQ (cache.stats ().entries, 0u);
+  EXPECT_EQ (cache.stats ().bytesResident, 0u);
+}
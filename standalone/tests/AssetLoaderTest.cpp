@@ -0,0 +1,117 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Asynchronous asset loader: deduplication, priorities and render thread callbacks
+
+#include "../../src/Assets/AssetLoader.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class AssetLoaderTest : public ::testing::Test {
+protected:
+  void SetUp () override {
+    fs::remove_all (root_);
+    fs::create_directories (root_);
+    for (const char* name : { "a.txt", "b.txt", "c.txt" }) {
+      DotNameUtils::FileIO::writeFile (root_ / name, std::string ("content of ") + name);
+    }
+    AssetContext::setAssetsPath (root_);
+  }
+
+  void TearDown () override {
+    AssetContext::clearAssetsPath ();
+    fs::remove_all (root_);
+  }
+
+  const fs::path root_ = "test_asset_loader";
+};
+
+TEST_F (AssetLoaderTest, DeduplicatesAndRunsCallbacksOnPump) {
+  AssetLoader loader (4);
+  const std::thread::id owner = std::this_thread::get_id ();
+  int callbacks = 0;
+
+  std::vector<std::shared_future<AssetLoader::Asset>> futures;
+  for (int i = 0; i < 16; ++i) {
+    futures.push_back (loader.request ("a.txt"));
+    loader.request ("a.txt", AssetPriority::Background, [&] (const AssetLoader::Asset& asset) {
+      EXPECT_EQ (std::this_thread::get_id (), owner);
+      ASSERT_NE (asset, nullptr);
+      EXPECT_EQ (asset->view (), "content of a.txt");
+      ++callbacks;
+    });
+  }
+  for (auto& future : futures) {
+    EXPECT_EQ (future.get ()->view (), "content of a.txt");
+  }
+
+  // Nothing runs until the owner pumps
+  EXPECT_EQ (callbacks, 0);
+  while (callbacks < 16) {
+    loader.pump ();
+    std::this_thread::yield ();
+  }
+
+  const AssetLoader::Stats stats = loader.stats ();
+  EXPECT_EQ (stats.requested, 32u);
+  EXPECT_EQ (stats.loaded + stats.deduplicated, 32u);
+  EXPECT_GE (stats.deduplicated, 1u);
+  EXPECT_EQ (stats.failed, 0u);
+  EXPECT_EQ (stats.queued, 0u);
+}
+
+TEST_F (AssetLoaderTest, PriorityOrderAndPromotion) {
+  AssetLoader loader (0); // loads run inside pump(), deterministic order
+  std::vector<std::string> order;
+  auto track = [&] (const char* name) {
+    return [&order, name] (const AssetLoader::Asset&) { order.push_back (name); };
+  };
+
+  loader.request ("a.txt", AssetPriority::Background, track ("a"));
+  loader.request ("b.txt", AssetPriority::Background, track ("b"));
+  loader.request ("c.txt", AssetPriority::Prefetch, track ("c"));
+  loader.request ("b.txt", AssetPriority::Immediate, track ("b")); // promotes the queued load
+  EXPECT_EQ (loader.stats ().queued, 3u);
+
+  EXPECT_EQ (loader.pump (), 4u);
+  EXPECT_EQ (order, (std::vector<std::string>{ "b", "b", "c", "a" }));
+  EXPECT_EQ (loader.stats ().loaded, 3u);
+}
+
+TEST_F (AssetLoaderTest, LoadBlocksAndReportsFailures) {
+  AssetLoader loader (0);
+  // No worker: load() runs on the calling thread instead of waiting for pump()
+  EXPECT_EQ (loader.load ("c.txt")->view (), "content of c.txt");
+
+  bool failedCallback = false;
+  auto future = loader.request ("missing.png", AssetPriority::Prefetch);
+  loader.request ("missing.png", AssetPriority::Prefetch,
+                  [&] (const AssetLoader::Asset& asset) { failedCallback = asset == nullptr; });
+  loader.pump ();
+  EXPECT_TRUE (failedCallback);
+  EXPECT_THROW (future.get (), std::ios_base::failure);
+  EXPECT_THROW (loader.load ("missing.png"), std::ios_base::failure);
+  EXPECT_EQ (loader.stats ().failed, 2u);
+
+  // Loads that never started fail when the loader goes away, and callbacks that were not pumped
+  // yet still run: with the asset when it loaded, with nullptr when it never started
+  std::shared_future<AssetLoader::Asset> orphan;
+  std::vector<std::string> results;
+  auto track = [&results] (const AssetLoader::Asset& asset) {
+    results.push_back (asset ? std::string (asset->view ()) : "null");
+  };
+  {
+    AssetLoader stopped (0);
+    orphan = stopped.request ("a.txt");
+    stopped.request ("a.txt", AssetPriority::Background, track);
+    stopped.request ("b.txt", AssetPriority::Background, track);
+    stopped.load ("b.txt");
+    EXPECT_TRUE (results.empty ());
+  }
+  EXPECT_THROW (orphan.get (), std::runtime_error);
+  EXPECT_EQ (results, (std::vector<std::string>{ "content of b.txt", "null" }));
+}
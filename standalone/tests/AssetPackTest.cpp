@@ -0,0 +1,119 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Asset pack format, reader and pack-first AssetContext lookup
+
+#include "../../src/Assets/AssetContext.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+
+namespace fs = std::filesystem;
+
+class AssetPackTest : public ::testing::Test {
+protected:
+  void SetUp () override {
+    fs::remove_all (root_);
+    fs::create_directories (root_ / "fonts");
+    DotNameUtils::FileIO::writeFile (root_ / "customstrings.json", "{\"strings\":[]}");
+    DotNameUtils::FileIO::writeFile (root_ / "fonts" / "a.otf", std::string (1000, 'f'));
+    DotNameUtils::FileIO::writeFile (root_ / "empty.txt", "");
+    const char raw[] = "PNG\0\r\n";
+    DotNameUtils::FileIO::writeFile (root_ / "logo.png", std::string (raw, sizeof (raw) - 1));
+  }
+
+  void TearDown () override {
+    AssetContext::clearAssetsPath ();
+    fs::remove_all (root_);
+  }
+
+  const fs::path root_ = "test_asset_pack";
+};
+
+TEST_F (AssetPackTest, WriteAndReadBack) {
+  std::string error;
+  // Trailing separator as passed by the CMake build step
+  ASSERT_TRUE (AssetPackFormat::writePack (root_.string () + "/", root_ / "assets.pack", &error))
+      << error;
+
+  AssetPack pack;
+  ASSERT_TRUE (pack.open (root_ / "assets.pack"));
+  ASSERT_EQ (pack.size (), 4u);
+
+  // Sorted TOC, aligned entries
+  EXPECT_EQ (pack.entry (0)->name, "customstrings.json");
+  EXPECT_EQ (pack.entry (1)->name, "empty.txt");
+  EXPECT_EQ (pack.entry (2)->name, "fonts/a.otf");
+  EXPECT_EQ (pack.entry (3)->name, "logo.png");
+  EXPECT_FALSE (pack.entry (4).has_value ());
+  const char* base = pack.entry (0)->data.data ();
+  for (std::size_t i = 0; i < pack.size (); ++i) {
+    EXPECT_EQ (static_cast<std::uint64_t> (pack.entry (i)->data.data () - base)
+                   % AssetPackFormat::kAlignment,
+               0u)
+        << i;
+  }
+
+  EXPECT_EQ (*pack.data ("fonts/a.otf"), std::string (1000, 'f'));
+  EXPECT_EQ (pack.data ("logo.png")->size (), 6u);
+  EXPECT_EQ (pack.data ("empty.txt")->size (), 0u);
+  EXPECT_TRUE (pack.contains ("customstrings.json"));
+  EXPECT_FALSE (pack.contains ("fonts"));
+  EXPECT_FALSE (pack.contains ("missing.png"));
+  EXPECT_FALSE (pack.contains (""));
+
+  // Rebuilding does not pack the previous pack
+  ASSERT_TRUE (AssetPackFormat::writePack (root_, root_ / "assets.pack", &error)) << error;
+  ASSERT_TRUE (pack.open (root_ / "assets.pack"));
+  EXPECT_EQ (pack.size (), 4u);
+}
+
+TEST_F (AssetPackTest, RejectsInvalidPacks) {
+  AssetPack pack;
+  EXPECT_FALSE (pack.open (root_ / "missing.pack"));
+  EXPECT_FALSE (pack.open (root_ / "customstrings.json"));
+  EXPECT_FALSE (pack.isOpen ());
+
+  std::string error;
+  ASSERT_TRUE (AssetPackFormat::writePack (root_, root_ / "assets.pack", &error)) << error;
+  std::string bytes = DotNameUtils::FileIO::readFile (root_ / "assets.pack");
+  DotNameUtils::FileIO::writeFile (root_ / "truncated.pack", bytes.substr (0, bytes.size () - 1));
+  EXPECT_FALSE (pack.open (root_ / "truncated.pack"));
+  bytes[8] = 99; // version
+  DotNameUtils::FileIO::writeFile (root_ / "future.pack", bytes);
+  EXPECT_FALSE (pack.open (root_ / "future.pack"));
+}
+
+TEST_F (AssetPackTest, AssetContextResolvesPackFirst) {
+  // Loose files only
+  AssetContext::setAssetsPath (root_);
+  EXPECT_EQ (AssetContext::getAssetPack (), nullptr);
+  AssetContext::AssetBlob loose = AssetContext::openAsset ("fonts/a.otf");
+  EXPECT_FALSE (loose.isPacked ());
+  EXPECT_EQ (loose.size (), 1000u);
+
+  std::string error;
+  ASSERT_TRUE (AssetPackFormat::writePack (root_, root_ / "assets.pack", &error)) << error;
+  DotNameUtils::FileIO::writeFile (root_ / "loose_only.txt", "not packed");
+  AssetContext::setAssetsPath (root_);
+  ASSERT_NE (AssetContext::getAssetPack (), nullptr);
+
+  AssetContext::AssetBlob packed = AssetContext::openAsset ("fonts/a.otf");
+  EXPECT_TRUE (packed.isPacked ());
+  EXPECT_EQ (packed.view (), std::string (1000, 'f'));
+
+  // Moving keeps the view valid for both kinds
+  AssetContext::AssetBlob moved = std::move (packed);
+  EXPECT_TRUE (moved.isPacked ());
+  EXPECT_EQ (moved.size (), 1000u);
+  auto fallback = AssetContext::tryOpenAsset ("loose_only.txt");
+  ASSERT_TRUE (fallback.has_value ());
+  AssetContext::AssetBlob movedLoose = std::move (*fallback);
+  EXPECT_FALSE (movedLoose.isPacked ());
+  EXPECT_EQ (movedLoose.view (), "not packed");
+
+  EXPECT_FALSE (AssetContext::tryOpenAsset ("missing.png").has_value ());
+  EXPECT_THROW (AssetContext::openAsset ("missing.png"), std::ios_base::failure);
+
+  AssetContext::clearAssetsPath ();
+  EXPECT_EQ (AssetContext::getAssetPack (), nullptr);
+}
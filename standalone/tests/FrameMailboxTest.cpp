@@ -0,0 +1,68 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Triple-buffered frame mailbox between UI and render thread
+
+#include "../../src/Gui/FrameMailbox.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST (FrameMailboxTest, NewestFrameWinsAndSlotsRotate) {
+  FrameMailbox<int> mailbox;
+  mailbox.back () = 1;
+  mailbox.publish ();
+  mailbox.back () = 2;
+  mailbox.publish (); // 1 was never picked up
+  EXPECT_EQ (mailbox.dropped (), 1u);
+
+  int* frame = mailbox.acquire ();
+  ASSERT_NE (frame, nullptr);
+  EXPECT_EQ (*frame, 2);
+
+  // The producer writes into a slot the consumer does not hold
+  mailbox.back () = 3;
+  EXPECT_EQ (*frame, 2);
+  mailbox.release ();
+  mailbox.publish ();
+  EXPECT_EQ (*mailbox.acquire (), 3);
+  mailbox.release ();
+
+  mailbox.close ();
+  EXPECT_EQ (mailbox.acquire (), nullptr);
+}
+
+TEST (FrameMailboxTest, ProducerAndConsumerThreads) {
+  FrameMailbox<std::vector<int>> mailbox;
+  constexpr int kFrames = 2000;
+  std::vector<int> seen;
+
+  std::thread consumer ([&] {
+    while (std::vector<int>* frame = mailbox.acquire ()) {
+      // Every slot is filled completely before it is published
+      for (int value : *frame) {
+        EXPECT_EQ (value, frame->front ());
+      }
+      seen.push_back (frame->front ());
+      mailbox.release ();
+    }
+  });
+
+  for (int i = 1; i <= kFrames; ++i) {
+    std::vector<int>& frame = mailbox.back ();
+    frame.assign (64, i);
+    const std::uint64_t sequence = mailbox.publish ();
+    if (i % 100 == 0) {
+      mailbox.waitConsumed (sequence); // like a frame with texture uploads
+    }
+  }
+  mailbox.waitConsumed (kFrames);
+  mailbox.close ();
+  consumer.join ();
+
+  ASSERT_FALSE (seen.empty ());
+  for (std::size_t i = 1; i < seen.size (); ++i) {
+    EXPECT_LT (seen[i - 1], seen[i]);
+  }
+  EXPECT_EQ (seen.back (), kFrames);
+  EXPECT_EQ (seen.size () + mailbox.dropped (), static_cast<std::size_t> (kFrames));
+}
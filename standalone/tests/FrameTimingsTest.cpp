@@ -0,0 +1,90 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Frame stage timings ring and percentiles
+
+#include "../../src/Gui/FrameTimings.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+  constexpr std::uint64_t kMs = 1000000;
+
+  // One frame with the given stage lengths in ms, stages in main loop order
+  std::uint64_t frame (FrameTimings& timings, std::uint64_t now, float events, float build,
+                       float background, float render) {
+    timings.beginFrame (now);
+    now += static_cast<std::uint64_t> (events * kMs);
+    timings.endStage (FrameStage::Events, now);
+    now += static_cast<std::uint64_t> (build * kMs);
+    timings.endStage (FrameStage::ImGuiBuild, now);
+    now += static_cast<std::uint64_t> (background * kMs);
+    timings.endStage (FrameStage::Background, now);
+    now += static_cast<std::uint64_t> (render * kMs);
+    timings.endStage (FrameStage::ImGuiRender, now);
+    return now;
+  }
+}
+
+TEST (FrameTimingsTest, StagesAndSwapWaitUntilNextFrame) {
+  FrameTimings timings;
+  std::uint64_t now = 1000 * kMs;
+  now = frame (timings, now, 1, 2, 3, 4);
+  EXPECT_EQ (timings.size (), 0u); // committed when the next frame begins
+
+  now += 23 * kMs; // swap + frame limiter
+  frame (timings, now, 1, 1, 1, 1);
+  ASSERT_EQ (timings.size (), 1u);
+  const FrameTimings::Sample& sample = timings.sample (0);
+  EXPECT_FLOAT_EQ (sample.stageMs[0], 1.0f);
+  EXPECT_FLOAT_EQ (sample.stageMs[1], 2.0f);
+  EXPECT_FLOAT_EQ (sample.stageMs[2], 3.0f);
+  EXPECT_FLOAT_EQ (sample.stageMs[3], 4.0f);
+  EXPECT_FLOAT_EQ (sample.stageMs[4], 23.0f);
+  EXPECT_FLOAT_EQ (sample.totalMs, 33.0f);
+}
+
+TEST (FrameTimingsTest, StageFromAnotherThread) {
+  FrameTimings timings;
+  timings.addStage (FrameStage::Background, 5.0f); // no frame yet, ignored
+  std::uint64_t now = 1000 * kMs;
+  timings.beginFrame (now);
+  now += 2 * kMs;
+  timings.endStage (FrameStage::ImGuiBuild, now);
+  timings.addStage (FrameStage::Background, 6.5f);
+  now += 1 * kMs;
+  timings.endStage (FrameStage::ImGuiRender, now); // the mark did not move
+  timings.beginFrame (now + 7 * kMs);
+
+  ASSERT_EQ (timings.size (), 1u);
+  const FrameTimings::Sample& sample = timings.sample (0);
+  EXPECT_FLOAT_EQ (sample.stageMs[static_cast<std::size_t> (FrameStage::Background)], 6.5f);
+  EXPECT_FLOAT_EQ (sample.stageMs[static_cast<std::size_t> (FrameStage::ImGuiRender)], 1.0f);
+  EXPECT_FLOAT_EQ (sample.totalMs, 10.0f);
+}
+
+TEST (FrameTimingsTest, RingAndPercentiles) {
+  FrameTimings timings;
+  EXPECT_EQ (timings.stats ().frames, 0u);
+
+  // Frame n takes n ms (all in swap/wait); more frames than the ring holds
+  std::uint64_t now = kMs;
+  const std::size_t frames = FrameTimings::kCapacity + 60;
+  for (std::size_t n = 1; n <= frames + 1; ++n) {
+    timings.beginFrame (now);
+    now += n * kMs;
+  }
+  ASSERT_EQ (timings.size (), FrameTimings::kCapacity);
+  EXPECT_FLOAT_EQ (timings.sample (0).totalMs, 61.0f); // the oldest 60 were overwritten
+  EXPECT_FLOAT_EQ (timings.sample (FrameTimings::kCapacity - 1).totalMs, float (frames));
+
+  // 61..300 ms, nearest rank
+  const FrameTimings::Stats stats = timings.stats ();
+  EXPECT_EQ (stats.frames, FrameTimings::kCapacity);
+  EXPECT_FLOAT_EQ (stats.p50, 180.0f);
+  EXPECT_FLOAT_EQ (stats.p95, 288.0f);
+  EXPECT_FLOAT_EQ (stats.p99, 298.0f);
+  EXPECT_FLOAT_EQ (stats.max, 300.0f);
+  EXPECT_NEAR (stats.stageAverageMs[static_cast<std::size_t> (FrameStage::SwapWait)], 180.5f, 1e-3);
+
+  timings.clear ();
+  EXPECT_EQ (timings.size (), 0u);
+}
@@ -0,0 +1,80 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Shadow GL state cache
+
+#include "../../src/Gui/GlStateCache.hpp"
+#include <gtest/gtest.h>
+
+TEST (GlStateCacheTest, SkipsRedundantChanges) {
+  GlStateCache cache;
+  EXPECT_TRUE (cache.useProgram (3)); // unknown at first
+  EXPECT_FALSE (cache.useProgram (3));
+  EXPECT_TRUE (cache.useProgram (4));
+
+  EXPECT_TRUE (cache.enable (GlStateCache::Cap::Blend, false));
+  EXPECT_FALSE (cache.enable (GlStateCache::Cap::Blend, false));
+  EXPECT_TRUE (cache.enable (GlStateCache::Cap::ScissorTest, false)); // per capability
+  EXPECT_TRUE (cache.enable (GlStateCache::Cap::Blend, true));
+
+  EXPECT_TRUE (cache.viewport (0, 0, 640, 480));
+  EXPECT_FALSE (cache.viewport (0, 0, 640, 480));
+  EXPECT_TRUE (cache.viewport (0, 0, 640, 481));
+  EXPECT_TRUE (cache.blendFunc (1, 2, 3, 4));
+  EXPECT_FALSE (cache.blendFunc (1, 2, 3, 4));
+
+  EXPECT_EQ (cache.skipped (), 4u);
+  EXPECT_EQ (cache.issued (), 8u);
+
+  // Invalidated values are issued again, counters keep going
+  cache.invalidate ();
+  EXPECT_TRUE (cache.useProgram (4));
+  EXPECT_TRUE (cache.viewport (0, 0, 640, 481));
+  EXPECT_EQ (cache.issued (), 10u);
+}
+
+TEST (GlStateCacheTest, TexturesPerUnitAndDeletes) {
+  GlStateCache cache;
+  // Active unit unknown: cannot tell which binding changes
+  EXPECT_TRUE (cache.bindTexture2D (7));
+  EXPECT_TRUE (cache.bindTexture2D (7));
+
+  EXPECT_TRUE (cache.activeTexture (GlStateCache::kTexture0));
+  EXPECT_TRUE (cache.bindTexture2D (7));
+  EXPECT_FALSE (cache.bindTexture2D (7));
+  EXPECT_TRUE (cache.activeTexture (GlStateCache::kTexture0 + 1));
+  EXPECT_TRUE (cache.bindTexture2D (7)); // other unit
+  EXPECT_TRUE (cache.activeTexture (GlStateCache::kTexture0));
+  EXPECT_FALSE (cache.bindTexture2D (7));
+
+  // A deleted texture is unbound; its name coming back from glGenTextures must bind again
+  cache.deleteTexture (7);
+  EXPECT_FALSE (cache.bindTexture2D (0));
+  EXPECT_TRUE (cache.bindTexture2D (7));
+
+  EXPECT_TRUE (cache.bindVertexArray (5));
+  cache.deleteVertexArray (5);
+  EXPECT_TRUE (cache.bindVertexArray (5));
+  EXPECT_TRUE (cache.bindArrayBuffer (2));
+  cache.deleteBuffer (3); // not bound, nothing changes
+  EXPECT_FALSE (cache.bindArrayBuffer (2));
+
+  // Deleted programs stay current until replaced
+  EXPECT_TRUE (cache.useProgram (9));
+  cache.deleteProgram (9);
+  EXPECT_TRUE (cache.useProgram (9));
+}
+
+TEST (GlStateCacheTest, PassThroughWithoutCurrentCache) {
+  GlStateCache::makeCurrent (nullptr);
+  GlStateCache& passThrough = GlStateCache::current ();
+  EXPECT_FALSE (passThrough.enabled ());
+  EXPECT_TRUE (passThrough.useProgram (1));
+  EXPECT_TRUE (passThrough.useProgram (1));
+
+  GlStateCache cache;
+  GlStateCache::makeCurrent (&cache);
+  EXPECT_EQ (&GlStateCache::current (), &cache);
+  EXPECT_TRUE (GlStateCache::current ().useProgram (1));
+  EXPECT_FALSE (GlStateCache::current ().useProgram (1));
+  GlStateCache::makeCurrent (nullptr);
+}
@@ -0,0 +1,124 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Work-stealing job system
+
+#include "../../src/Utils/JobSystem.hpp"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+TEST (JobSystemTest, DequeOwnerAndThieves) {
+  WorkStealingDeque<int> deque (8);
+  std::vector<int> items (10);
+  std::iota (items.begin (), items.end (), 0);
+  for (int i = 0; i < 8; ++i) {
+    EXPECT_TRUE (deque.push (&items[i]));
+  }
+  EXPECT_FALSE (deque.push (&items[8])); // full
+  EXPECT_EQ (*deque.steal (), 0);        // oldest from the top
+  EXPECT_EQ (*deque.pop (), 7);          // newest from the bottom
+
+  // Owner pops while thieves steal: every item comes out exactly once
+  constexpr int kItems = 100000;
+  WorkStealingDeque<int> shared (1024);
+  std::vector<int> values (kItems);
+  std::vector<std::atomic<int>> seen (kItems);
+  std::atomic<bool> producing{ true };
+  std::vector<std::thread> thieves;
+  for (int t = 0; t < 3; ++t) {
+    thieves.emplace_back ([&] {
+      while (producing.load () || !shared.empty ()) {
+        if (int* item = shared.steal ()) {
+          seen[*item].fetch_add (1);
+        }
+      }
+    });
+  }
+  for (int i = 0; i < kItems; ++i) {
+    values[i] = i;
+    while (!shared.push (&values[i])) {
+      if (int* item = shared.pop ()) {
+        seen[*item].fetch_add (1);
+      }
+    }
+    if (i % 3 == 0) {
+      if (int* item = shared.pop ()) {
+        seen[*item].fetch_add (1);
+      }
+    }
+  }
+  producing.store (false);
+  for (std::thread& thief : thieves) {
+    thief.join ();
+  }
+  for (int i = 0; i < kItems; ++i) {
+    ASSERT_EQ (seen[i].load (), 1) << "item " << i;
+  }
+}
+
+TEST (JobSystemTest, ParallelForAndNestedWaits) {
+  for (std::size_t workers : { 0u, 3u }) {
+    JobSystem jobs (workers);
+    EXPECT_EQ (jobs.workerCount (), workers);
+
+    std::vector<int> squares (10000);
+    jobs.parallelFor (0, squares.size (), 0, [&] (std::size_t first, std::size_t last) {
+      for (std::size_t i = first; i < last; ++i) {
+        squares[i] = static_cast<int> (i * i % 1000);
+      }
+    });
+    for (std::size_t i = 0; i < squares.size (); ++i) {
+      ASSERT_EQ (squares[i], static_cast<int> (i * i % 1000));
+    }
+
+    // Jobs that spawn and wait for jobs of their own
+    std::atomic<int> leaves{ 0 };
+    JobSystem::Counter counter;
+    for (int i = 0; i < 16; ++i) {
+      jobs.run (
+          [&] {
+            JobSystem::Counter inner;
+            for (int j = 0; j < 16; ++j) {
+              jobs.run ([&] { leaves.fetch_add (1); }, &inner);
+            }
+            jobs.wait (inner);
+          },
+          &counter);
+    }
+    jobs.wait (counter);
+    EXPECT_EQ (leaves.load (), 256);
+  }
+}
+
+TEST (JobSystemTest, DependenciesAndMainThreadQueue) {
+  JobSystem jobs (2);
+  std::atomic<int> stage{ 0 };
+  std::atomic<bool> ordered{ true };
+
+  JobSystem::Counter first, second;
+  for (int i = 0; i < 8; ++i) {
+    jobs.run (
+        [&] {
+          std::this_thread::sleep_for (std::chrono::milliseconds (2));
+          stage.fetch_add (1);
+        },
+        &first);
+  }
+  // Starts only once all eight finished
+  jobs.run ([&] { ordered = ordered && stage.load () == 8; }, &second, &first);
+  jobs.wait (second);
+  EXPECT_TRUE (first.done ());
+  EXPECT_TRUE (ordered.load ());
+
+  // Main thread jobs run only when the frame loop drains them
+  int onMain = 0;
+  JobSystem::Counter queued;
+  jobs.run ([&] { jobs.runOnMainThread ([&] { ++onMain; }); }, &queued);
+  jobs.wait (queued);
+  EXPECT_EQ (onMain, 0);
+  EXPECT_EQ (jobs.drainMainThread (), 1u);
+  EXPECT_EQ (onMain, 1);
+  EXPECT_EQ (jobs.drainMainThread (), 0u);
+}
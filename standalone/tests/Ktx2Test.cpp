@@ -0,0 +1,123 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Block compression round trips and the KTX2 container
+
+#include "../../src/Assets/Ktx2.hpp"
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using BlockCompression::Format;
+
+namespace {
+  // Smooth gradients with a soft alpha ramp, the typical content of a shader channel texture
+  std::vector<std::uint8_t> makeGradient (int width, int height) {
+    std::vector<std::uint8_t> rgba (static_cast<std::size_t> (width) * height * 4);
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        std::uint8_t* texel = rgba.data () + (static_cast<std::size_t> (y) * width + x) * 4;
+        texel[0] = static_cast<std::uint8_t> (x * 255 / std::max (1, width - 1));
+        texel[1] = static_cast<std::uint8_t> (y * 255 / std::max (1, height - 1));
+        texel[2] = 128;
+        texel[3] = static_cast<std::uint8_t> (255 - x - y);
+      }
+    }
+    return rgba;
+  }
+
+  double meanError (const std::vector<std::uint8_t>& a, const std::vector<std::uint8_t>& b,
+                    int channel) {
+    double total = 0;
+    for (std::size_t i = channel; i < a.size (); i += 4) {
+      total += std::abs (a[i] - b[i]);
+    }
+    return total / (a.size () / 4);
+  }
+}
+
+TEST (Ktx2Test, BlockFormatsRoundTrip) {
+  const int width = 62, height = 45; // not a multiple of the block size
+  const std::vector<std::uint8_t> source = makeGradient (width, height);
+
+  for (Format format : { Format::Bc1, Format::Bc3, Format::Etc2Rgb, Format::Etc2Rgba }) {
+    SCOPED_TRACE (static_cast<int> (format));
+    const std::vector<std::uint8_t> blocks = BlockCompression::compress (format, source.data (),
+                                                                         width, height);
+    ASSERT_EQ (blocks.size (), 16u * 12 * BlockCompression::blockBytes (format));
+    EXPECT_LT (blocks.size (), source.size () / 3); // 4 or 8 bits per texel instead of 32
+
+    std::vector<std::uint8_t> decoded (source.size ());
+    BlockCompression::decompress (format, blocks.data (), width, height, decoded.data ());
+    for (int channel = 0; channel < 3; ++channel) {
+      EXPECT_LT (meanError (source, decoded, channel), 6.0) << "channel " << channel;
+    }
+    if (BlockCompression::hasAlpha (format)) {
+      EXPECT_LT (meanError (source, decoded, 3), 3.0);
+    } else {
+      for (std::size_t i = 3; i < decoded.size (); i += 4) {
+        ASSERT_EQ (decoded[i], 255);
+      }
+    }
+  }
+}
+
+TEST (Ktx2Test, FlatBlocksAreNearlyExact) {
+  std::vector<std::uint8_t> flat (4 * 4 * 4);
+  for (std::size_t i = 0; i < flat.size (); i += 4) {
+    flat[i] = 200;
+    flat[i + 1] = 100;
+    flat[i + 2] = 50;
+    flat[i + 3] = 77;
+  }
+  for (Format format : { Format::Bc1, Format::Bc3, Format::Etc2Rgb, Format::Etc2Rgba }) {
+    const std::vector<std::uint8_t> block = BlockCompression::compress (format, flat.data (), 4, 4);
+    std::uint8_t texels[64];
+    BlockCompression::decodeBlock (format, block.data (), texels);
+    for (int i = 0; i < 16; ++i) {
+      EXPECT_NEAR (texels[i * 4], 200, 4);
+      EXPECT_NEAR (texels[i * 4 + 1], 100, 4);
+      EXPECT_NEAR (texels[i * 4 + 2], 50, 4);
+      EXPECT_EQ (texels[i * 4 + 3], BlockCompression::hasAlpha (format) ? 77 : 255);
+    }
+  }
+}
+
+TEST (Ktx2Test, WriteAndParse) {
+  const std::vector<std::uint8_t> source = makeGradient (16, 8);
+  std::vector<Ktx2::LevelData> levels;
+  levels.push_back ({ BlockCompression::compress (Format::Etc2Rgba, source.data (), 16, 8), 16, 8 });
+  levels.push_back ({ BlockCompression::compress (Format::Etc2Rgba, source.data (), 8, 4), 8, 4 });
+  const std::vector<std::uint8_t> file = Ktx2::write (Format::Etc2Rgba, true, true, levels);
+
+  Ktx2::Texture texture;
+  std::string error;
+  ASSERT_TRUE (Ktx2::parse (file.data (), file.size (), texture, &error)) << error;
+  EXPECT_EQ (texture.format, Format::Etc2Rgba);
+  EXPECT_TRUE (texture.srgb);
+  EXPECT_TRUE (texture.flippedVertically);
+  EXPECT_EQ (texture.width, 16);
+  EXPECT_EQ (texture.height, 8);
+  ASSERT_EQ (texture.levels.size (), 2u);
+  EXPECT_EQ (texture.levels[1].width, 8);
+  EXPECT_EQ (texture.levels[1].height, 4);
+  EXPECT_EQ (reinterpret_cast<std::uintptr_t> (texture.levels[0].data) % 16, 0u);
+  EXPECT_EQ (std::vector<std::uint8_t> (texture.levels[0].data,
+                                        texture.levels[0].data + texture.levels[0].size),
+             levels[0].blocks);
+  EXPECT_EQ (texture.bytes (), levels[0].blocks.size () + levels[1].blocks.size ());
+  EXPECT_EQ (BlockCompression::glInternalFormat (texture.format, texture.srgb), 0x9279u);
+
+  // Truncated, corrupted and supercompressed files are rejected
+  EXPECT_FALSE (Ktx2::parse (file.data (), file.size () - 1, texture, &error));
+  EXPECT_FALSE (Ktx2::parse (file.data (), 40, texture, &error));
+  std::vector<std::uint8_t> supercompressed = file;
+  supercompressed[44] = 2; // zstd
+  EXPECT_FALSE (Ktx2::parse (supercompressed.data (), supercompressed.size (), texture, &error));
+  EXPECT_NE (error.find ("supercompressed"), std::string::npos);
+  std::vector<std::uint8_t> notKtx = file;
+  notKtx[1] = 'X';
+  EXPECT_FALSE (Ktx2::parse (notKtx.data (), notKtx.size (), texture, &error));
+}
@@ -4,7 +4,10 @@
 
 #include "../../src/Logger/Logger.hpp"
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdio>
 #include <fstream>
+#include <streambuf>
 #include <thread>
 #include <chrono>
 #include <sstream>
@@ -215,3 +218,395 @@ TEST_F (LoggerTest, SingletonBehavior) {
   // instance proves it)
   EXPECT_EQ (&logger1, &logger2);
 }
+
+// Multi-threaded producers in synchronous and asynchronous (sharded) mode. Console output is
+// discarded, the file output is checked for completeness and per-thread ordering. Throughput is
+// measured by corelib_bench (Logger/SyncFile, Logger/AsyncFile).
+TEST_F (LoggerTest, MultiThreadedContention) {
+  struct NullBuffer : std::streambuf {
+    int overflow (int c) override {
+      return c;
+    }
+    std::streamsize xsputn (const char*, std::streamsize n) override {
+      return n;
+    }
+  } nullBuffer;
+
+  const int numThreads = 8;
+  const int messagesPerThread = 2000;
+  Logger& logger = Logger::getInstance ();
+
+  for (bool async : { false, true }) {
+    std::remove ("test_log.txt");
+    ASSERT_TRUE (logger.enableFileLogging ("test_log.txt"));
+    logger.setAsync (async);
+    EXPECT_EQ (logger.isAsync (), async);
+
+    std::streambuf* coutBuffer = std::cout.rdbuf (&nullBuffer);
+    std::atomic<bool> togglerDone{ false };
+    // Header setters race with the producers, readers must never block on them
+    std::thread toggler ([&] {
+      while (!togglerDone.load ()) {
+        logger.showHeaderTime (false);
+        logger.showHeaderTime (true);
+      }
+    });
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+      threads.emplace_back ([t, messagesPerThread] {
+        for (int i = 0; i < messagesPerThread; ++i) {
+          LOG_I_FMT ("mt {} {}", t, i);
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join ();
+    }
+    logger.flush ();
+
+    togglerDone = true;
+    toggler.join ();
+    logger.setAsync (false);
+    logger.disableFileLogging ();
+    std::cout.rdbuf (coutBuffer);
+
+    std::ifstream file ("test_log.txt");
+    ASSERT_TRUE (file.is_open ());
+    std::vector<int> lastIndex (numThreads, -1);
+    std::string line;
+    int lineCount = 0;
+    while (std::getline (file, line)) {
+      auto pos = line.find ("mt ");
+      ASSERT_NE (pos, std::string::npos);
+      int thread = 0, index = 0;
+      std::istringstream (line.substr (pos + 3)) >> thread >> index;
+      ASSERT_GE (thread, 0);
+      ASSERT_LT (thread, numThreads);
+      EXPECT_GT (index, lastIndex[thread]); // per-thread order is preserved
+      lastIndex[thread] = index;
+      ++lineCount;
+    }
+    EXPECT_EQ (lineCount, numThreads * messagesPerThread);
+  }
+}
+
+TEST_F (LoggerTest, KeyValueFieldsReachSinks) {
+  Logger& logger = Logger::getInstance ();
+  auto ring = std::make_shared<RingSink> (16);
+  logger.setConsoleOutput (false);
+  logger.addSink (ring);
+
+  const double dt = 16.5;
+  const int fps = 60;
+  LOG_I_KV ("frame", "ms", dt, "fps", fps, "vsync", true, "gpu", "test \"gpu\"");
+  logger.debug ("filtered out", "KeyValueFieldsReachSinks");
+
+  logger.removeSink (ring);
+  logger.setConsoleOutput (true);
+
+  auto records = ring->records ();
+  ASSERT_EQ (records.size (), 1u);
+  const LogRecord& record = records[0];
+  EXPECT_EQ (record.message, "frame");
+  ASSERT_EQ (record.fields.size (), 4u);
+  EXPECT_STREQ (record.fields[0].key, "ms");
+  EXPECT_DOUBLE_EQ (std::get<double> (record.fields[0].value), 16.5);
+  EXPECT_EQ (std::get<std::int64_t> (record.fields[1].value), 60);
+  EXPECT_TRUE (std::get<bool> (record.fields[2].value));
+
+  LogFormat::Buffer text;
+  LogFormat::appendText (text, record);
+  EXPECT_EQ (fmt::to_string (text), "frame ms=16.5 fps=60 vsync=true gpu=test \"gpu\"");
+
+  LogFormat::Buffer json;
+  LogFormat::appendJson (json, record);
+  const std::string line = fmt::to_string (json);
+  EXPECT_EQ (line.back (), '\n');
+  EXPECT_NE (line.find ("\"level\":\"INF\""), std::string::npos);
+  EXPECT_NE (line.find ("\"msg\":\"frame\",\"ms\":16.5,\"fps\":60,\"vsync\":true,"
+                        "\"gpu\":\"test \\\"gpu\\\"\"}"),
+             std::string::npos);
+}
+
+TEST_F (LoggerTest, NdjsonSinkOnAsyncWriter) {
+  Logger& logger = Logger::getInstance ();
+  std::remove ("test_log.ndjson");
+  auto ndjson = std::make_shared<NdjsonSink> ("test_log.ndjson");
+  ASSERT_TRUE (ndjson->isOpen ());
+  logger.setConsoleOutput (false);
+  logger.addSink (ndjson);
+  logger.setAsync (true);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back ([t] {
+      for (int i = 0; i < 100; ++i) {
+        LOG_W_KV ("tick", "thread", t, "i", i);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join ();
+  }
+  logger.setAsync (false);
+  logger.removeSink (ndjson);
+  logger.setConsoleOutput (true);
+  ndjson.reset ();
+
+  std::ifstream file ("test_log.ndjson");
+  ASSERT_TRUE (file.is_open ());
+  std::string line;
+  int lineCount = 0;
+  while (std::getline (file, line)) {
+    EXPECT_EQ (line.front (), '{');
+    EXPECT_EQ (line.back (), '}');
+    EXPECT_NE (line.find ("\"msg\":\"tick\",\"thread\":"), std::string::npos);
+    ++lineCount;
+  }
+  EXPECT_EQ (lineCount, 400);
+  file.close ();
+  std::remove ("test_log.ndjson");
+}
+
+TEST_F (LoggerTest, StoppingAsyncWriterKeepsEveryRecord) {
+  Logger& logger = Logger::getInstance ();
+  auto ring = std::make_shared<RingSink> (16);
+  logger.setConsoleOutput (false);
+  logger.addSink (ring);
+
+  // Producers outrun the writer and fill their rings while it is stopped underneath them; none
+  // may hang on a full ring and every record ends up in the sink, queued or written directly
+  constexpr int kThreads = 4;
+  constexpr int kMessages = 20000;
+  std::atomic<int> started{ 0 };
+  logger.setAsync (true);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; ++t) {
+    threads.emplace_back ([&started] {
+      started.fetch_add (1);
+      for (int i = 0; i < kMessages; ++i) {
+        LOG_I_KV ("load", "i", i);
+      }
+    });
+  }
+  while (started.load () < kThreads) {
+    std::this_thread::yield ();
+  }
+  logger.setAsync (false);
+  for (auto& thread : threads) {
+    thread.join ();
+  }
+  logger.removeSink (ring);
+  logger.setConsoleOutput (true);
+
+  EXPECT_EQ (ring->totalWritten (), static_cast<std::size_t> (kThreads * kMessages));
+}
+
+TEST_F (LoggerTest, RateLimitedLogging) {
+  Logger& logger = Logger::getInstance ();
+  auto ring = std::make_shared<RingSink> (64);
+  logger.setConsoleOutput (false);
+  logger.addSink (ring);
+
+  for (int i = 0; i < 100; ++i) {
+    LOG_I_EVERY_N (10, "every n {}", i);
+  }
+  auto records = ring->records ();
+  ASSERT_EQ (records.size (), 10u);
+  EXPECT_EQ (records[0].message, "every n 0");
+  EXPECT_TRUE (records[0].fields.empty ());
+  EXPECT_EQ (records[1].message, "every n 10");
+  ASSERT_EQ (records[1].fields.size (), 1u);
+  EXPECT_STREQ (records[1].fields[0].key, "suppressed");
+  EXPECT_EQ (std::get<std::uint64_t> (records[1].fields[0].value), 9u);
+
+  ring->clear ();
+  // Every thread counts its own calls of a site
+  auto everyThird = [] (int i) { LOG_I_EVERY_N (3, "per thread {}", i); };
+  everyThird (0);
+  everyThird (1);
+  std::thread other ([&everyThird] { everyThird (2); });
+  other.join ();
+  everyThird (3);
+  everyThird (4);
+  records = ring->records ();
+  ASSERT_EQ (records.size (), 3u);
+  EXPECT_EQ (records[1].message, "per thread 2");
+  EXPECT_EQ (records[2].message, "per thread 4");
+  ASSERT_EQ (records[2].fields.size (), 1u);
+  EXPECT_EQ (std::get<std::uint64_t> (records[2].fields[0].value), 2u);
+
+  ring->clear ();
+  for (int i = 0; i < 100; ++i) {
+    LOG_W_EVERY_MS (60 * 60 * 1000, "every ms {}", i);
+  }
+  EXPECT_EQ (ring->totalWritten (), 1u);
+
+  ring->clear ();
+  // Calls below the level are filtered before the limiter and do not use up its window
+  for (const Logger::Level level : { Logger::Level::LOG_ERROR, Logger::Level::LOG_INFO }) {
+    logger.setLevel (level);
+    for (int i = 0; i < 10; ++i) {
+      LOG_W_EVERY_MS (60 * 60 * 1000, "filtered first {}", i);
+    }
+  }
+  ASSERT_EQ (ring->totalWritten (), 1u);
+  EXPECT_EQ (ring->records ()[0].message, "filtered first 0");
+
+  ring->clear ();
+  // Burst of 5, refill far slower than the loop runs
+  for (int i = 0; i < 100; ++i) {
+    LOG_E_RATE (0.01, 5, "rate {}", i);
+  }
+  EXPECT_EQ (ring->totalWritten (), 5u);
+
+  logger.removeSink (ring);
+  logger.setConsoleOutput (true);
+}
+
+TEST_F (LoggerTest, FlightRecorderKeepsLastRecords) {
+  Logger& logger = Logger::getInstance ();
+  logger.setConsoleOutput (false);
+  logger.enableFlightRecorder ("test_crash.log", 8);
+  ASSERT_NE (logger.flightRecorder (), nullptr);
+
+  for (int i = 0; i < 20; ++i) {
+    LOG_I_FMT ("flight {}", i);
+  }
+  LOG_W_KV ("flight kv", "value", 42);
+
+  auto lines = logger.flightRecorder ()->snapshot ();
+  logger.disableFlightRecorder ();
+  logger.setConsoleOutput (true);
+
+  ASSERT_EQ (lines.size (), 8u);
+  EXPECT_NE (lines.front ().find ("flight 13"), std::string::npos);
+  EXPECT_NE (lines.back ().find ("[WRN]"), std::string::npos);
+  EXPECT_NE (lines.back ().find ("flight kv value=42"), std::string::npos);
+  EXPECT_EQ (lines.back ().back (), '\n');
+  EXPECT_EQ (logger.flightRecorder (), nullptr);
+}
+
+#if !defined(_WIN32) && !defined(__EMSCRIPTEN__)
+TEST_F (LoggerTest, FlightRecorderDumpsOnAbort) {
+  ::testing::FLAGS_gtest_death_test_style = "threadsafe";
+  std::remove ("test_crash.log");
+  EXPECT_DEATH (
+      {
+        Logger& logger = Logger::getInstance ();
+        logger.setConsoleOutput (false);
+        logger.enableFlightRecorder ("test_crash.log", 16);
+        logger.error ("last words before abort", "FlightRecorderDumpsOnAbort");
+        std::abort ();
+      },
+      "last words before abort");
+
+  std::ifstream crashFile ("test_crash.log");
+  ASSERT_TRUE (crashFile.is_open ());
+  std::stringstream content;
+  content << crashFile.rdbuf ();
+  EXPECT_NE (content.str ().find ("flight recorder"), std::string::npos);
+  EXPECT_NE (content.str ().find ("[ERR] [FlightRecorderDumpsOnAbort] last words before abort"),
+             std::string::npos);
+  crashFile.close ();
+  std::remove ("test_crash.log");
+}
+#endif
+
+TEST_F (LoggerTest, TimestampFormat) {
+  // 1970-01-01 00:00:01.234 UTC - only the sub-second part is timezone independent
+  std::string_view stamp = Logger::formatTimestamp (1234000000LL);
+  ASSERT_EQ (stamp.size (), 23u);
+  EXPECT_EQ (stamp.substr (19), ".234");
+  EXPECT_EQ (stamp[2], '-');
+  EXPECT_EQ (stamp[5], '-');
+
+  // Same second, different milliseconds reuses the cached prefix
+  std::string first (Logger::formatTimestamp (1000000000LL));
+  std::string second (Logger::formatTimestamp (1999000000LL));
+  EXPECT_EQ (first.substr (0, 19), second.substr (0, 19));
+  EXPECT_EQ (second.substr (19), ".999");
+}
+
+TEST_F (LoggerTest, FlightRecorderSnapshotNeverTorn) {
+  // 4 slots wrapped constantly by 4 writers of different line lengths; every line read back is
+  // one writer's line, whole
+  LogFlightRecorder recorder (4, "test_crash.log");
+  std::atomic<bool> stop{ false };
+  std::vector<std::thread> writers;
+  for (char fill = 'a'; fill < 'e'; ++fill) {
+    writers.emplace_back ([&recorder, &stop, fill] {
+      LogRecord record;
+      record.caller = "writer";
+      record.message.assign (static_cast<std::size_t> (fill - 'a' + 1) * 40, fill);
+      while (!stop.load (std::memory_order_relaxed)) {
+        recorder.record (record);
+      }
+    });
+  }
+
+  std::size_t lines = 0;
+  const auto until = std::chrono::steady_clock::now () + std::chrono::milliseconds (200);
+  while (std::chrono::steady_clock::now () < until) {
+    for (const std::string& line : recorder.snapshot ()) {
+      const std::string message = line.substr (line.find ("[writer] ") + 9);
+      ASSERT_EQ (message.size (), static_cast<std::size_t> (message[0] - 'a' + 1) * 40 + 1) << line;
+      EXPECT_EQ (message.find_first_not_of (message[0]), message.size () - 1) << line;
+      EXPECT_EQ (message.back (), '\n');
+      ++lines;
+    }
+  }
+  stop = true;
+  for (std::thread& writer : writers) {
+    writer.join ();
+  }
+  EXPECT_GT (lines, 0u);
+
+#ifdef LOG_FLIGHT_RECORDER_SIGNALS
+  // A thread that recorded a line has a signal stack for the crash handler
+  std::thread ([&recorder] {
+    stack_t before{};
+    sigaltstack (nullptr, &before);
+    EXPECT_NE (before.ss_flags & SS_DISABLE, 0);
+    recorder.record (LogRecord ());
+    stack_t after{};
+    sigaltstack (nullptr, &after);
+    EXPECT_EQ (after.ss_flags & SS_DISABLE, 0);
+  }).join ();
+#endif
+}
+
+TEST_F (LoggerTest, HeaderSettersWhileLogging) {
+  // Replaced header snapshots are freed while producers, sinks and getters keep reading
+  Logger& logger = Logger::getInstance ();
+  auto ring = std::make_shared<RingSink> (16);
+  logger.setConsoleOutput (false);
+  logger.addSink (ring);
+
+  std::atomic<bool> stop{ false };
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 2; ++t) {
+    threads.emplace_back ([&stop] {
+      while (!stop.load ()) {
+        LOG_I_FMT ("busy {}", Logger::isAddNewLine ());
+      }
+    });
+  }
+  while (ring->totalWritten () == 0) {
+    std::this_thread::yield ();
+  }
+  for (int i = 0; i < 2000; ++i) {
+    logger.showHeaderTime (i % 2 == 0);
+    Logger::setAddNewLine (true);
+  }
+  stop = true;
+  for (std::thread& thread : threads) {
+    thread.join ();
+  }
+  logger.showHeaderTime (true);
+  logger.removeSink (ring);
+  logger.setConsoleOutput (true);
+
+  EXPECT_TRUE (Logger::isAddNewLine ());
+}
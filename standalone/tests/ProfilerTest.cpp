@@ -0,0 +1,98 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Profiling zones, per-thread rings and Chrome trace export
+
+#include "../../src/Utils/Profiler.hpp"
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  std::vector<Profiler::Zone> zonesNamed (const std::string& prefix) {
+    std::vector<Profiler::Zone> out;
+    for (const Profiler::Zone& zone : Profiler::snapshot ()) {
+      if (zone.name != nullptr && std::string (zone.name).rfind (prefix, 0) == 0) {
+        out.push_back (zone);
+      }
+    }
+    return out;
+  }
+}
+
+TEST (ProfilerTest, NestedScopesOnSeveralThreads) {
+  Profiler::clear ();
+  auto work = [] {
+    Profiler::Scope outer ("test.outer");
+    for (int i = 0; i < 3; ++i) {
+      Profiler::Scope inner ("test.inner");
+    }
+  };
+  work ();
+  std::thread worker ([&] {
+    Profiler::setThreadName ("Test worker");
+    work ();
+  });
+  worker.join ();
+
+  const std::vector<Profiler::Zone> zones = zonesNamed ("test.");
+  ASSERT_EQ (zones.size (), 8u);
+  // Per thread the enclosing zone comes first and contains the inner ones
+  EXPECT_STREQ (zones[0].name, "test.outer");
+  for (int i = 1; i < 4; ++i) {
+    EXPECT_STREQ (zones[i].name, "test.inner");
+    EXPECT_EQ (zones[i].thread, zones[0].thread);
+    EXPECT_GE (zones[i].beginNs, zones[0].beginNs);
+    EXPECT_LE (zones[i].endNs, zones[0].endNs);
+  }
+  EXPECT_NE (zones[4].thread, zones[0].thread);
+
+  Profiler::setCapturing (false);
+  { Profiler::Scope ignored ("test.paused"); }
+  Profiler::setCapturing (true);
+  EXPECT_EQ (zonesNamed ("test.").size (), 8u);
+
+  Profiler::clear ();
+  EXPECT_TRUE (zonesNamed ("test.").empty ());
+}
+
+TEST (ProfilerTest, FullRingKeepsNewestZones) {
+  Profiler::clear ();
+  for (std::uint64_t i = 0; i < Profiler::kRingCapacity + 10; ++i) {
+    Profiler::record ("test.ring", i, i + 1);
+  }
+  const std::vector<Profiler::Zone> zones = zonesNamed ("test.ring");
+  // The oldest slot is the one the next zone overwrites, snapshot leaves it out
+  ASSERT_EQ (zones.size (), Profiler::kRingCapacity - 1);
+  EXPECT_EQ (zones.front ().beginNs, 11u);
+  EXPECT_EQ (zones.back ().beginNs, Profiler::kRingCapacity + 9);
+  Profiler::clear ();
+}
+
+TEST (ProfilerTest, ChromeTraceExport) {
+  Profiler::clear ();
+  Profiler::setThreadName ("Main");
+  Profiler::record ("test.frame", 5000, 21000);
+  Profiler::record ("test.swap \"quoted\"", 20000, 21000);
+
+  const nlohmann::json trace = nlohmann::json::parse (Profiler::chromeTraceJson ());
+  ASSERT_TRUE (trace["traceEvents"].is_array ());
+  bool named = false;
+  std::vector<nlohmann::json> complete;
+  for (const nlohmann::json& event : trace["traceEvents"]) {
+    if (event["ph"] == "M" && event["args"]["name"] == "Main") {
+      named = true;
+    } else if (event["ph"] == "X") {
+      complete.push_back (event);
+    }
+  }
+  EXPECT_TRUE (named);
+  ASSERT_EQ (complete.size (), 2u);
+  EXPECT_EQ (complete[0]["name"], "test.frame");
+  EXPECT_DOUBLE_EQ (complete[0]["ts"].get<double> (), 0.0);
+  EXPECT_DOUBLE_EQ (complete[0]["dur"].get<double> (), 16.0);
+  EXPECT_EQ (complete[1]["name"], "test.swap \"quoted\"");
+  EXPECT_DOUBLE_EQ (complete[1]["ts"].get<double> (), 15.0);
+  Profiler::clear ();
+}
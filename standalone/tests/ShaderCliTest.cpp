@@ -0,0 +1,173 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Headless convert / bench commands of index2
+
+#include "../src/ShaderCli.hpp"
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+  const char* kShader = R"(
+void mainImage(out vec4 fragColor, in vec2 fragCoord) {
+  vec2 uv = fragCoord / iResolution.xy;
+  fragColor = vec4(uv, 0.5 + 0.5 * sin(iTime), 1.0);
+}
+)";
+
+  nlohmann::json readReport (const fs::path& path) {
+    return nlohmann::json::parse (DotNameUtils::FileIO::readFile (path));
+  }
+}
+
+class ShaderCliTest : public ::testing::Test {
+protected:
+  void SetUp () override {
+    fs::remove_all (root_);
+    fs::create_directories (root_ / "shaders" / "more");
+    DotNameUtils::FileIO::writeFile (root_ / "shaders" / "wave.glsl", kShader);
+    DotNameUtils::FileIO::writeFile (root_ / "shaders" / "more" / "dying-universe.glsl", kShader);
+    DotNameUtils::FileIO::writeFile (root_ / "shaders" / "notes.txt", "not a shader");
+  }
+
+  void TearDown () override {
+    fs::remove_all (root_);
+  }
+
+  // argv[0] is the command, as index2 passes it
+  int run (std::vector<std::string> args) {
+    std::vector<const char*> argv;
+    for (const std::string& arg : args) {
+      argv.push_back (arg.c_str ());
+    }
+    return ShaderCli::run (static_cast<int> (argv.size ()), argv.data ());
+  }
+
+  std::string path (const fs::path& relative) const {
+    return (root_ / relative).string ();
+  }
+
+  const fs::path root_ = "test_shader_cli";
+};
+
+TEST_F (ShaderCliTest, ParseTargets) {
+  using ShaderCli::detail::parseTargets;
+  const auto all = parseTargets ({ "all" });
+  ASSERT_TRUE (all.has_value ());
+  EXPECT_EQ (all->size (), 4u);
+
+  const auto some = parseTargets ({ "WebGL2", "Desktop420", "WebGL2" });
+  ASSERT_TRUE (some.has_value ());
+  ASSERT_EQ (some->size (), 2u); // duplicates dropped, order kept
+  EXPECT_EQ ((*some)[0], ShaderTarget::WebGL2);
+  EXPECT_EQ ((*some)[1], ShaderTarget::Desktop420);
+
+  // parseShaderTarget maps these to Desktop330, the CLI has to reject them
+  EXPECT_FALSE (parseTargets ({ "Vulkan" }).has_value ());
+  EXPECT_FALSE (parseTargets ({ "webgl2" }).has_value ());
+  EXPECT_FALSE (parseTargets ({ "WebGL1", "" }).has_value ());
+}
+
+TEST_F (ShaderCliTest, HeaderName) {
+  using ShaderCli::detail::headerName;
+  EXPECT_EQ (headerName ("dying-universe.glsl"), "DYING_UNIVERSE");
+  EXPECT_EQ (headerName ("shaders/Wave 2.v1.glsl"), "WAVE_2_V1");
+  EXPECT_EQ (headerName ("plain"), "PLAIN");
+}
+
+TEST_F (ShaderCliTest, CollectInputs) {
+  const auto files = ShaderCli::detail::collectInputs (
+      { path ("shaders"), path ("shaders/notes.txt") });
+  // Only *.glsl below directories, files given explicitly as they are, sorted
+  ASSERT_EQ (files.size (), 3u);
+  EXPECT_EQ (files[0], root_ / "shaders" / "more" / "dying-universe.glsl");
+  EXPECT_EQ (files[1], root_ / "shaders" / "notes.txt");
+  EXPECT_EQ (files[2], root_ / "shaders" / "wave.glsl");
+}
+
+TEST_F (ShaderCliTest, ConvertWritesHeadersAndReport) {
+  EXPECT_EQ (run ({ "convert", path ("shaders"), "-o", path ("out"), "-t", "WebGL2,Desktop330",
+                    "-r", path ("report.json"), "-j", "2" }),
+             0);
+
+  const nlohmann::json report = readReport (root_ / "report.json");
+  EXPECT_EQ (report["command"], "convert");
+  EXPECT_EQ (report["format"], "header");
+  EXPECT_EQ (report["targets"], nlohmann::json ({ "WebGL2", "Desktop330" }));
+  EXPECT_EQ (report["summary"]["files"], 2);
+  EXPECT_EQ (report["summary"]["failed"], 0);
+  ASSERT_EQ (report["files"].size (), 2u);
+  for (const auto& file : report["files"]) {
+    ASSERT_EQ (file["targets"].size (), 2u);
+    EXPECT_TRUE (file["targets"][0]["ok"].get<bool> ());
+    EXPECT_TRUE (file["targets"][1]["ok"].get<bool> ());
+    EXPECT_TRUE (file["analysis"]["hasCustomFunctions"].is_boolean ());
+  }
+
+  const std::string header = DotNameUtils::FileIO::readFile (root_ / "out" / "dying-universe.hpp");
+  EXPECT_NE (header.find ("#ifndef __DYING_UNIVERSE_H__"), std::string::npos);
+  EXPECT_NE (header.find ("fragmentShader"), std::string::npos);
+  EXPECT_EQ (report["files"][0]["output"],
+             (root_ / "out" / "dying-universe.hpp").generic_string ());
+  EXPECT_TRUE (fs::exists (root_ / "out" / "wave.hpp"));
+}
+
+TEST_F (ShaderCliTest, ConvertWritesGlsl) {
+  EXPECT_EQ (run ({ "convert", path ("shaders/wave.glsl"), "-o", path ("out"), "-f", "glsl", "-t",
+                    "WebGL1", "-j", "1" }),
+             0);
+  EXPECT_TRUE (fs::exists (root_ / "out" / "wave.WebGL1.vert"));
+  const std::string fragment = DotNameUtils::FileIO::readFile (root_ / "out" / "wave.WebGL1.frag");
+  EXPECT_NE (fragment.find ("void main"), std::string::npos);
+  EXPECT_FALSE (fs::exists (root_ / "out" / "wave.hpp"));
+}
+
+TEST_F (ShaderCliTest, ConvertExitCodes) {
+  EXPECT_EQ (run ({ "convert", "--help" }), 0);
+  EXPECT_EQ (run ({ "convert" }), 1); // no inputs
+  EXPECT_EQ (run ({ "convert", path ("shaders"), "-t", "Vulkan" }), 1);
+  EXPECT_EQ (run ({ "convert", path ("shaders"), "-f", "spirv" }), 1);
+  EXPECT_EQ (run ({ "convert", path ("no_such_dir") }), 1); // nothing to convert
+
+  // One unreadable input fails the run and gets no header, not even one left by an earlier run;
+  // the others are still converted
+  fs::create_directories (root_ / "out");
+  DotNameUtils::FileIO::writeFile (root_ / "out" / "missing.hpp", "// stale");
+  EXPECT_EQ (run ({ "convert", path ("shaders/wave.glsl"), path ("missing.glsl"), "-o",
+                    path ("out"), "-t", "WebGL2", "-r", path ("report.json") }),
+             1);
+  const nlohmann::json report = readReport (root_ / "report.json");
+  EXPECT_EQ (report["summary"]["files"], 2);
+  EXPECT_EQ (report["summary"]["failed"], 1);
+  EXPECT_TRUE (report["files"][0].contains ("error"));
+  EXPECT_FALSE (fs::exists (root_ / "out" / "missing.hpp"));
+  EXPECT_TRUE (fs::exists (root_ / "out" / "wave.hpp"));
+}
+
+TEST_F (ShaderCliTest, BenchReportsTimings) {
+  EXPECT_EQ (run ({ "bench", path ("shaders"), "-n", "3", "-t", "WebGL2", "-r",
+                    path ("bench.json") }),
+             0);
+  const nlohmann::json report = readReport (root_ / "bench.json");
+  EXPECT_EQ (report["command"], "bench");
+  EXPECT_EQ (report["iterations"], 3);
+  EXPECT_EQ (report["summary"]["failed"], 0);
+  ASSERT_EQ (report["files"].size (), 2u);
+  for (const auto& file : report["files"]) {
+    ASSERT_EQ (file["targets"].size (), 1u);
+    const auto& target = file["targets"][0];
+    EXPECT_EQ (target["target"], "WebGL2");
+    EXPECT_TRUE (target["ok"].get<bool> ());
+    EXPECT_EQ (target["iterations"], 3);
+    EXPECT_LE (target["minMs"].get<double> (), target["medianMs"].get<double> ());
+  }
+  // bench writes nothing but the report
+  EXPECT_FALSE (fs::exists (root_ / "shaders" / "wave.hpp"));
+  EXPECT_FALSE (fs::exists ("wave.hpp"));
+
+  EXPECT_EQ (run ({ "bench", path ("missing.glsl"), "-n", "1" }), 1);
+  EXPECT_EQ (run ({ "bench", path ("shaders"), "-t", "all,Metal" }), 1);
+}
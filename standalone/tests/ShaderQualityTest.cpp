@@ -0,0 +1,160 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Shader quality tiers and the governor picking them
+
+#include "../../src/Gui/QualityGovernor.hpp"
+#include "../../src/Shaders/ShaderRegistry.hpp"
+#include <gtest/gtest.h>
+
+namespace {
+  const char* kRaymarch = R"(
+#define MAX_STEPS 96
+const int AA = 2;
+void mainImage(out vec4 fragColor, in vec2 fragCoord) {
+  vec3 color = vec3(0.0);
+  for (int i = 0; i < 64; i++) { color += vec3(0.01); }
+  for (int k = 0; k < 3; k++) { color[k] *= 0.5; }
+  for (float t = 0.; t++ < 1e2 && color.x < 1.0; ) { color += 0.001; }
+  fragColor = vec4(color, float(MAX_STEPS + AA));
+}
+)";
+
+  std::size_t count (const std::string& text, const std::string& needle) {
+    std::size_t found = 0;
+    for (std::size_t at = text.find (needle); at != std::string::npos;
+         at = text.find (needle, at + 1)) {
+      ++found;
+    }
+    return found;
+  }
+
+  // Samples of the same cost, returns how many of them changed the tier
+  int feed (QualityGovernor& governor, float ms, std::size_t samples) {
+    int changes = 0;
+    for (std::size_t i = 0; i < samples; ++i) {
+      changes += governor.addSample (ms) ? 1 : 0;
+    }
+    return changes;
+  }
+
+  QualityGovernor::Config testConfig () {
+    QualityGovernor::Config config;
+    config.budgetMs = 10.0f;
+    config.upshiftRatio = 0.4f;
+    config.windowFrames = 10;
+    config.holdFrames = 5;
+    config.upshiftWindows = 2;
+    config.maxUpshiftWindows = 8;
+    return config;
+  }
+}
+
+TEST (ShaderQualityTest, ScalesExposedLoopsAndSteps) {
+  ShaderConvertor convertor;
+  const ShaderConversionResult high
+      = convertor.convertFromShaderToy (kRaymarch, ShaderTarget::Desktop330, ShaderQuality::High);
+  const ShaderConversionResult medium
+      = convertor.convertFromShaderToy (kRaymarch, ShaderTarget::Desktop330, ShaderQuality::Medium);
+  const ShaderConversionResult low
+      = convertor.convertFromShaderToy (kRaymarch, ShaderTarget::Desktop330, ShaderQuality::Low);
+  ASSERT_TRUE (high.success && medium.success && low.success);
+
+  EXPECT_EQ (high.qualityUsed, ShaderQuality::High);
+  EXPECT_EQ (high.qualityScaledBounds, 0);
+  EXPECT_EQ (count (high.fragmentShader, "#define QUALITY 2\n"), 1u);
+  EXPECT_NE (high.fragmentShader.find ("i < 64;"), std::string::npos);
+  EXPECT_NE (high.fragmentShader.find ("#define MAX_STEPS 96"), std::string::npos);
+
+  EXPECT_EQ (count (medium.fragmentShader, "#define QUALITY 1\n"), 1u);
+  EXPECT_NE (medium.fragmentShader.find ("i < 32;"), std::string::npos);
+  EXPECT_NE (medium.fragmentShader.find ("#define MAX_STEPS 48"), std::string::npos);
+  EXPECT_NE (medium.fragmentShader.find ("t++ < 50.0 &&"), std::string::npos);
+  EXPECT_EQ (medium.qualityScaledBounds, 3);
+
+  EXPECT_EQ (count (low.fragmentShader, "#define QUALITY 0\n"), 1u);
+  EXPECT_NE (low.fragmentShader.find ("i < 16;"), std::string::npos);
+  EXPECT_NE (low.fragmentShader.find ("#define MAX_STEPS 24"), std::string::npos);
+  EXPECT_EQ (low.qualityScaledBounds, 3);
+
+  // Short loops and constants that are not step counts stay as written
+  for (const ShaderConversionResult* result : { &medium, &low }) {
+    EXPECT_NE (result->fragmentShader.find ("k < 3;"), std::string::npos);
+    EXPECT_NE (result->fragmentShader.find ("const int AA = 2;"), std::string::npos);
+  }
+}
+
+TEST (ShaderQualityTest, LeavesOwnQualityDefineAlone) {
+  const std::string source = std::string ("#define QUALITY 1\n") + kRaymarch;
+  ShaderConvertor convertor;
+  const ShaderConversionResult low
+      = convertor.convertFromShaderToy (source, ShaderTarget::WebGL2, ShaderQuality::Low);
+  ASSERT_TRUE (low.success);
+  EXPECT_EQ (count (low.fragmentShader, "#define QUALITY"), 1u);
+  EXPECT_FALSE (low.conversionWarnings.empty ());
+}
+
+TEST (ShaderQualityTest, RegistryCachesEveryTier) {
+  ShaderRegistry registry;
+  registry.add ("Raymarch", kRaymarch);
+  const ShaderRegistry::Shader& shader = *registry.find ("Raymarch");
+  EXPECT_FALSE (shader.converted (ShaderTarget::WebGL2, ShaderQuality::Low));
+  const ShaderConversionResult& low = shader.conversion (ShaderTarget::WebGL2, ShaderQuality::Low);
+  EXPECT_TRUE (shader.converted (ShaderTarget::WebGL2, ShaderQuality::Low));
+  EXPECT_FALSE (shader.converted (ShaderTarget::WebGL2, ShaderQuality::Medium));
+  EXPECT_EQ (&low, &shader.conversion (ShaderTarget::WebGL2, ShaderQuality::Low));
+  EXPECT_NE (&low, &shader.conversion (ShaderTarget::WebGL2));
+  EXPECT_EQ (low.qualityUsed, ShaderQuality::Low);
+  EXPECT_EQ (shader.conversion (ShaderTarget::WebGL2).qualityUsed, ShaderQuality::High);
+}
+
+TEST (ShaderQualityTest, GovernorStepsDownAndHoldsInDeadBand) {
+  QualityGovernor governor (testConfig ());
+  EXPECT_EQ (feed (governor, 15.0f, 9), 0); // the first window is not complete yet
+  EXPECT_EQ (feed (governor, 15.0f, 1), 1);
+  EXPECT_EQ (governor.quality (), ShaderQuality::Medium);
+  EXPECT_FLOAT_EQ (governor.averageMs (), 15.0f);
+
+  // Over budget during the hold after a switch counts for nothing
+  EXPECT_EQ (feed (governor, 50.0f, 5), 0);
+  // Between upshiftRatio * budget and the budget nothing changes, however long
+  EXPECT_EQ (feed (governor, 7.0f, 500), 0);
+  EXPECT_EQ (governor.quality (), ShaderQuality::Medium);
+
+  EXPECT_EQ (feed (governor, 30.0f, 10), 1);
+  EXPECT_EQ (governor.quality (), ShaderQuality::Low);
+  EXPECT_EQ (feed (governor, 30.0f, 100), 0); // nothing below Low
+}
+
+TEST (ShaderQualityTest, GovernorStepsUpAfterCalmWindows) {
+  QualityGovernor governor (testConfig (), ShaderQuality::Low);
+  EXPECT_EQ (feed (governor, 2.0f, 10), 0); // one calm window
+  EXPECT_EQ (feed (governor, 2.0f, 10), 1);
+  EXPECT_EQ (governor.quality (), ShaderQuality::Medium);
+  EXPECT_EQ (feed (governor, 2.0f, 5 + 20), 1);
+  EXPECT_EQ (governor.quality (), ShaderQuality::High);
+  EXPECT_EQ (feed (governor, 2.0f, 100), 0); // nothing above High
+}
+
+TEST (ShaderQualityTest, GovernorBacksOffFromTierThatDoesNotFit) {
+  // Cheap at Medium, over budget at High: every failed upshift doubles the calm windows needed
+  QualityGovernor governor (testConfig (), ShaderQuality::Medium);
+  auto cost = [&governor] {
+    return governor.quality () == ShaderQuality::High ? 12.0f : 3.0f;
+  };
+  std::size_t upshifts = 0;
+  for (int frame = 0; frame < 2000; ++frame) {
+    const ShaderQuality before = governor.quality ();
+    if (governor.addSample (cost ()) && governor.quality () > before) {
+      ++upshifts;
+    }
+  }
+  // Windows of 10 frames, patience 2, 4, 8, 8, ...: 2000 frames give a handful of retries
+  // instead of one every 3 windows
+  EXPECT_EQ (governor.upshiftWindows (), 8u);
+  EXPECT_LE (upshifts, 25u);
+  EXPECT_GE (upshifts, 3u);
+
+  governor.reset ();
+  EXPECT_EQ (governor.quality (), ShaderQuality::High);
+  EXPECT_EQ (governor.upshiftWindows (), 2u);
+}
@@ -0,0 +1,88 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Shader registry
+
+#include "../../src/Shaders/ShaderRegistry.hpp"
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+namespace {
+  const char* kGradient = R"(
+void mainImage(out vec4 fragColor, in vec2 fragCoord) {
+  fragColor = vec4(fragCoord / iResolution.xy, 0.5 + 0.5 * sin(iTime), 1.0);
+}
+)";
+
+  const char* kTextured = R"(
+void mainImage(out vec4 fragColor, in vec2 fragCoord) {
+  vec2 uv = fragCoord / iResolution.xy;
+  vec3 color = vec3(0.0);
+  for (int i = 0; i < 8; i++) {
+    color += texture(iChannel0, uv * float(i)).rgb * pow(0.5, float(i));
+  }
+  fragColor = vec4(color, 1.0);
+}
+)";
+}
+
+REGISTER_SHADERTOY ("RegistryTestGradient", kGradient);
+
+TEST (ShaderRegistryTest, LooksUpByName) {
+  ShaderRegistry registry;
+  EXPECT_TRUE (registry.add ("Gradient", kGradient));
+  EXPECT_TRUE (registry.add ("Textured", kTextured));
+  EXPECT_FALSE (registry.add ("Gradient", kTextured)); // name taken, first one stays
+
+  ASSERT_EQ (registry.size (), 2u);
+  EXPECT_EQ (registry.at (0).name (), "Gradient");
+  EXPECT_EQ (registry.at (1).name (), "Textured");
+  EXPECT_EQ (registry.find ("Textured"), &registry.at (1));
+  EXPECT_EQ (registry.find ("Gradient")->source (), kGradient);
+  EXPECT_EQ (registry.find ("Missing"), nullptr);
+}
+
+TEST (ShaderRegistryTest, MetadataAndSharedConversions) {
+  ShaderRegistry registry;
+  registry.add ("Gradient", kGradient);
+  registry.add ("Textured", kTextured);
+  const ShaderRegistry::Shader& gradient = *registry.find ("Gradient");
+  const ShaderRegistry::Shader& textured = *registry.find ("Textured");
+
+  EXPECT_FALSE (textured.precompiled ()); // not a bundled shader
+  EXPECT_EQ (textured.channels (), std::vector<std::string>{ "iChannel0" });
+  EXPECT_TRUE (gradient.channels ().empty ());
+  EXPECT_GT (textured.cost (), gradient.cost ());
+
+  // Every consumer gets the same converted artifact, however many ask at once
+  std::vector<const ShaderConversionResult*> seen (8, nullptr);
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < seen.size (); ++i) {
+    threads.emplace_back ([&, i] { seen[i] = &textured.conversion (ShaderTarget::WebGL2); });
+  }
+  for (std::thread& thread : threads) {
+    thread.join ();
+  }
+  for (const ShaderConversionResult* result : seen) {
+    EXPECT_EQ (result, seen.front ());
+  }
+  EXPECT_TRUE (seen.front ()->success) << seen.front ()->errorMessage;
+  EXPECT_EQ (seen.front ()->targetUsed, ShaderTarget::WebGL2);
+  EXPECT_NE (&textured.conversion (ShaderTarget::Desktop330), seen.front ());
+}
+
+TEST (ShaderRegistryTest, InstanceHoldsBundledAndRegisteredShaders) {
+  const ShaderRegistry& registry = ShaderRegistry::instance ();
+  EXPECT_NE (registry.find ("RegistryTestGradient"), nullptr);
+
+  // Listed from src/Shaders/Shadertoy by the build, none can be forgotten
+  for (const char* name : { "Singularity", "Chainy", "DyingUniverse", "Phosphor3" }) {
+    const ShaderRegistry::Shader* shader = registry.find (name);
+    ASSERT_NE (shader, nullptr) << name;
+    EXPECT_GT (shader->cost (), 0) << name;
+  }
+  for (std::size_t i = 0; i < registry.size (); ++i) {
+    EXPECT_EQ (registry.find (registry.at (i).name ()), &registry.at (i));
+  }
+  EXPECT_EQ (registry.find ("Template"), nullptr);
+}
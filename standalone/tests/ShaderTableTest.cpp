@@ -0,0 +1,79 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Build-time shader table
+
+#include "../../src/Shaders/ShaderTable.hpp"
+#include <gtest/gtest.h>
+#include <string>
+
+namespace {
+  const char* kShaderToyHeader = R"cpp(#ifndef __TEST_H__
+#define __TEST_H__
+
+const char* fragmentShaderToyTestGradient = R"(
+void mainImage(out vec4 fragColor, in vec2 fragCoord) {
+  fragColor = vec4(fragCoord / iResolution.xy, 0.5 + 0.5 * sin(iTime), 1.0); // "quoted" )
+}
+)";
+
+#endif
+)cpp";
+}
+
+TEST (ShaderTableTest, ExtractsShaderToySource) {
+  const auto source = ShaderTable::extractSource (kShaderToyHeader);
+  ASSERT_TRUE (source.has_value ());
+  EXPECT_EQ (source->name, "TestGradient");
+  EXPECT_EQ (source->code.front (), '\n');
+  EXPECT_NE (source->code.find ("void mainImage"), std::string::npos);
+  EXPECT_NE (source->code.find ("\"quoted\" )\n}"), std::string::npos);
+  EXPECT_EQ (source->code.find ("#endif"), std::string::npos);
+
+  EXPECT_FALSE (ShaderTable::extractSource ("const char* fragmentShaderToyTemplate = R\"()\";"));
+  EXPECT_FALSE (ShaderTable::extractSource ("const char* simpleFragmentShader = R\"()\";"));
+}
+
+TEST (ShaderTableTest, GeneratesSortedTableForEveryTarget) {
+  const auto source = ShaderTable::extractSource (kShaderToyHeader);
+  ASSERT_TRUE (source.has_value ());
+  const std::string table = ShaderTable::generateHeader (
+      { *source, ShaderTable::Source{ "Another", source->code } });
+
+  const std::size_t another = table.find ("{ \"Another\"");
+  const std::size_t gradient = table.find ("{ \"TestGradient\"");
+  ASSERT_NE (another, std::string::npos);
+  ASSERT_NE (gradient, std::string::npos);
+  EXPECT_LT (another, gradient);
+  EXPECT_NE (table.find ("// WebGL1"), std::string::npos);
+  EXPECT_NE (table.find ("// Desktop420"), std::string::npos);
+  EXPECT_NE (table.find ("void main"), std::string::npos);
+
+  EXPECT_THROW (ShaderTable::generateHeader ({ *source, *source }), std::runtime_error);
+  EXPECT_THROW (ShaderTable::generateHeader ({ { "Bad", "void mainImage() {} // )glsl\"" } }),
+                std::runtime_error);
+}
+
+TEST (ShaderTableTest, CompiledInTableIsConsistent) {
+  static_assert (ShaderTable::hash ("") == 0xcbf29ce484222325ull);
+  static_assert (ShaderTable::hash ("a") == 0xaf63dc4c8601ec8cull);
+
+  // Empty in builds without the generated table
+  for (std::size_t i = 0; i < ShaderTable::size (); ++i) {
+    const PrecompiledShader& shader = ShaderTable::at (i);
+    if (i > 0) {
+      EXPECT_LT (ShaderTable::at (i - 1).name, shader.name);
+    }
+    EXPECT_EQ (ShaderTable::find (shader.name), &shader);
+    for (const PrecompiledShaderVariant& variant : shader.variants) {
+      if (variant.ok ()) {
+        EXPECT_EQ (variant.hash, ShaderTable::hash (variant.fragment,
+                                                    ShaderTable::hash (variant.vertex)))
+            << shader.name;
+      }
+    }
+    // A source that no longer matches the table is converted at runtime instead
+    EXPECT_FALSE (ShaderTable::lookup (shader.name, "changed", ShaderTarget::Desktop330));
+  }
+  EXPECT_EQ (ShaderTable::find ("NoSuchShader"), nullptr);
+  EXPECT_FALSE (ShaderTable::lookup ("NoSuchShader", "", ShaderTarget::WebGL1));
+}
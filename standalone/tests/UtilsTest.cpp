@@ -0,0 +1,289 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Utils functionality tests
+
+#include "../../src/Utils/Utils.hpp"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+namespace FileIO = DotNameUtils::FileIO;
+namespace JsonUtils = DotNameUtils::JsonUtils;
+
+class UtilsTest : public ::testing::Test {
+protected:
+  void TearDown () override {
+    std::remove ("test_utils.txt");
+    std::remove ("test_utils_empty.txt");
+    std::remove ("test_utils.json");
+  }
+};
+
+TEST_F (UtilsTest, MappedFileReadsRegularFile) {
+  const char raw[] = "line 1\r\nline 2\n\0binary tail";
+  const std::string content (raw, sizeof (raw) - 1);
+  FileIO::writeFile ("test_utils.txt", content);
+
+  FileIO::MappedFile file ("test_utils.txt");
+#if !defined(__EMSCRIPTEN__)
+  EXPECT_TRUE (file.isMapped ());
+#endif
+  EXPECT_EQ (file.size (), content.size ());
+  EXPECT_EQ (file.view (), content); // binary, no newline translation
+  EXPECT_EQ (file.bytes ()[0], 'l');
+}
+
+TEST_F (UtilsTest, MappedFileEmptyAndMissing) {
+  FileIO::writeFile ("test_utils_empty.txt", "");
+  FileIO::MappedFile empty ("test_utils_empty.txt");
+  EXPECT_TRUE (empty.empty ());
+  EXPECT_NE (empty.data (), nullptr);
+  EXPECT_EQ (empty.view (), "");
+
+  EXPECT_THROW (FileIO::MappedFile ("does_not_exist.txt"), std::ios_base::failure);
+  EXPECT_THROW (FileIO::readFile ("does_not_exist.txt"), std::ios_base::failure);
+}
+
+TEST_F (UtilsTest, MappedFileMove) {
+  FileIO::writeFile ("test_utils.txt", "move me");
+  FileIO::MappedFile first ("test_utils.txt", FileIO::MappedFile::Access::Random);
+  FileIO::MappedFile second (std::move (first));
+  EXPECT_EQ (second.view (), "move me");
+  EXPECT_TRUE (first.empty ());
+
+  FileIO::MappedFile third;
+  third = std::move (second);
+  EXPECT_EQ (third.view (), "move me");
+}
+
+#if defined(__linux__)
+TEST_F (UtilsTest, MappedFileBufferedFallback) {
+  // procfs reports size 0 for a file with content, it has to be read buffered
+  FileIO::MappedFile status ("/proc/self/status");
+  EXPECT_FALSE (status.isMapped ());
+  EXPECT_NE (status.view ().find ("Name:"), std::string_view::npos);
+}
+#endif
+
+TEST_F (UtilsTest, ReadFileAndLoadJson) {
+  FileIO::writeFile ("test_utils.json", R"({"app": {"name": "index2", "version": 2}})");
+  EXPECT_EQ (FileIO::readFile ("test_utils.json").front (), '{');
+
+  nlohmann::json json = JsonUtils::loadFromFile ("test_utils.json");
+  EXPECT_EQ (json["app"]["name"], "index2");
+  EXPECT_EQ (JsonUtils::getNestedValue<int> (json, "app/version", 0), 2);
+
+  FileIO::writeFile ("test_utils.json", "{ broken");
+  EXPECT_THROW (JsonUtils::loadFromFile ("test_utils.json"), std::runtime_error);
+}
+
+TEST_F (UtilsTest, CustomStringsIndex) {
+  const auto json = nlohmann::json::parse (R"({"strings": [
+      {"id": "Author", "data": {"en": "Tomas Mark", "cs": "Tomáš Mark"}},
+      {"id": "Email", "data": {"en": "Email", "email": "someone@example.com"}},
+      {"id": "Phone", "data": {"tel": "+420 000"}},
+      {"id": "Site", "data": {"url": "https://example.com", "count": 3}},
+      {"id": "Author", "data": {"en": "Duplicate"}},
+      {"data": {"en": "no id"}}
+  ]})");
+  JsonUtils::CustomStrings::Snapshot strings (json);
+
+  EXPECT_EQ (strings.size (), 4u);
+  EXPECT_EQ (strings.localized ("Author", "cs"), "Tomáš Mark");
+  EXPECT_EQ (strings.localized ("Author", "de"), "Tomas Mark"); // English fallback
+  EXPECT_EQ (strings.email ("Email"), "someone@example.com");
+  EXPECT_EQ (strings.tel ("Phone"), "+420 000");
+  EXPECT_EQ (strings.url ("Site"), "https://example.com");
+  EXPECT_FALSE (strings.get ("Site", "count")); // non-string values are skipped
+  EXPECT_FALSE (strings.url ("Missing"));
+  EXPECT_FALSE (strings.localized ("Phone"));
+
+  // Same answers as the JSON based getters
+  EXPECT_EQ (JsonUtils::getLocalizedString (json, "Author", "cs"), "Tomáš Mark");
+  EXPECT_EQ (JsonUtils::getEmail (json, "Email"), "someone@example.com");
+}
+
+TEST_F (UtilsTest, CustomStringsReloadOnChange) {
+  FileIO::writeFile ("test_utils.json",
+                     R"({"strings": [{"id": "Web", "data": {"url": "https://one.example"}}]})");
+  JsonUtils::CustomStrings store ("test_utils.json");
+
+  auto first = store.snapshot ();
+  EXPECT_EQ (first->url ("Web"), "https://one.example");
+  EXPECT_EQ (store.snapshot (), first); // unchanged file, no reparse
+  EXPECT_EQ (store.loadCount (), 1u);
+
+  FileIO::writeFile ("test_utils.json",
+                     R"({"strings": [{"id": "Web", "data": {"url": "https://two.example"}}]})");
+  std::filesystem::last_write_time ("test_utils.json", std::filesystem::last_write_time (
+                                                           "test_utils.json")
+                                                           + std::chrono::seconds (1));
+  auto second = store.snapshot ();
+  EXPECT_EQ (second->url ("Web"), "https://two.example");
+  EXPECT_EQ (first->url ("Web"), "https://one.example"); // old snapshot stays valid
+  EXPECT_EQ (store.loadCount (), 2u);
+
+  // A broken file keeps the last good snapshot
+  FileIO::writeFile ("test_utils.json", "{ broken");
+  std::filesystem::last_write_time ("test_utils.json", std::filesystem::last_write_time (
+                                                           "test_utils.json")
+                                                           + std::chrono::seconds (2));
+  EXPECT_EQ (store.snapshot ()->url ("Web"), "https://two.example");
+
+  JsonUtils::CustomStrings missing ("does_not_exist.json");
+  EXPECT_THROW (missing.snapshot (), std::ios_base::failure);
+}
+
+TEST_F (UtilsTest, JsonPathLookup) {
+  const auto json = nlohmann::json::parse (R"({
+      "strings": [{"id": "Author", "data": {"en": "Tomas"}}],
+      "window": {"size": [1280, 720], "7": "numeric key"}
+  })");
+
+  JsonUtils::JsonPath path ("/strings/0/data/en");
+  ASSERT_EQ (path.segments ().size (), 4u);
+  EXPECT_TRUE (path.segments ()[1].isIndex);
+  EXPECT_EQ (path.get<std::string> (json), "Tomas");
+  EXPECT_EQ (path.resolve (json), &json["strings"][0]["data"]["en"]); // no copies
+
+  EXPECT_EQ (JsonUtils::getNestedValue<int> (json, "window/size/1", 0), 720);
+  EXPECT_EQ (JsonUtils::getNestedValue<int> (json, "window/size/2", -1), -1);
+  EXPECT_EQ (JsonUtils::getNestedValue<std::string> (json, "window/7", ""), "numeric key");
+  EXPECT_EQ (JsonUtils::getNestedValue<int> (json, "window/size/0/deeper", -1), -1);
+  EXPECT_EQ (JsonUtils::getNestedValue<int> (json, "strings/0/data/en", -1), -1); // type mismatch
+
+  static constexpr JsonUtils::LiteralJsonPath kWidth ("window/size/0");
+  static_assert (kWidth.size () == 3, "parsed at compile time");
+  static_assert (kWidth[2].isIndex && kWidth[2].index == 0, "parsed at compile time");
+  EXPECT_EQ (kWidth.get<int> (json, 0), 1280);
+}
+
+TEST_F (UtilsTest, JsonPathDoesNotCopySubtrees) {
+  // Large sibling subtree next to the looked-up key, the old traversal copied it on every step
+  nlohmann::json json;
+  for (int i = 0; i < 5000; ++i) {
+    json["config"]["bulk"].push_back ({ { "id", i }, { "name", "item" } });
+  }
+  json["config"]["value"] = 42;
+
+  // Traversal as it was before JsonPath: istringstream tokenizing and a copy per level
+  auto legacyLookup = [] (const nlohmann::json& root, const std::string& path) {
+    std::istringstream pathStream (path);
+    std::string segment;
+    nlohmann::json current = root;
+    while (std::getline (pathStream, segment, '/')) {
+      current = current[segment];
+    }
+    return current.get<int> ();
+  };
+
+  constexpr int kLookups = 20;
+  int sum = 0;
+  auto start = std::chrono::steady_clock::now ();
+  for (int i = 0; i < kLookups; ++i) {
+    sum += legacyLookup (json, "config/value");
+  }
+  std::chrono::duration<double, std::micro> legacy = std::chrono::steady_clock::now () - start;
+
+  static constexpr JsonUtils::LiteralJsonPath kValue ("config/value");
+  start = std::chrono::steady_clock::now ();
+  for (int i = 0; i < kLookups; ++i) {
+    sum += kValue.get<int> (json, 0);
+  }
+  std::chrono::duration<double, std::micro> compiled = std::chrono::steady_clock::now () - start;
+
+  std::printf ("[ BENCH    ] json path lookup legacy: %.2f us, compiled: %.2f us\n",
+               legacy.count () / kLookups, compiled.count () / kLookups);
+  EXPECT_EQ (sum, 2 * kLookups * 42);
+  EXPECT_LT (compiled.count (), legacy.count ());
+}
+
+TEST_F (UtilsTest, JsonStreamLoaderBindsPaths) {
+  const std::string manifest = R"({
+      "version": 3,
+      "shaders": [
+        {"name": "plasma", "tags": ["fast", "2d"], "params": {"speed": 1.5}},
+        {"name": "tunnel", "tags": [], "params": {"speed": 0.5}},
+        {"name": "clouds", "tags": ["slow"]}
+      ],
+      "unused": {"huge": [1, 2, 3, {"deep": [null, true]}]}
+  })";
+
+  std::vector<std::string> names;
+  std::vector<std::string> namePaths;
+  double secondSpeed = 0.0;
+  nlohmann::json firstTags;
+  int version = 0;
+
+  JsonUtils::JsonStreamLoader loader;
+  loader.on ("version", [&] (const nlohmann::json& value, std::string_view) { version = value; })
+      .on ("shaders/*/name",
+           [&] (const nlohmann::json& value, std::string_view path) {
+             names.push_back (value);
+             namePaths.emplace_back (path);
+           })
+      .on ("shaders/1/params/speed",
+           [&] (const nlohmann::json& value, std::string_view) { secondSpeed = value; })
+      .on ("shaders/0/tags", [&] (const nlohmann::json& value, std::string_view) {
+        firstTags = value;
+      });
+  EXPECT_TRUE (loader.parse (manifest));
+
+  EXPECT_EQ (version, 3);
+  EXPECT_EQ (names, (std::vector<std::string>{ "plasma", "tunnel", "clouds" }));
+  EXPECT_EQ (namePaths[2], "shaders/2/name");
+  EXPECT_DOUBLE_EQ (secondSpeed, 0.5);
+  EXPECT_EQ (firstTags, nlohmann::json::parse (R"(["fast", "2d"])"));
+
+  // Whole subtrees can be bound as well, the result equals the DOM parse
+  nlohmann::json unused;
+  JsonUtils::JsonStreamLoader subtree;
+  subtree.on ("unused", [&] (const nlohmann::json& value, std::string_view) { unused = value; });
+  EXPECT_TRUE (subtree.parse (manifest));
+  EXPECT_EQ (unused, nlohmann::json::parse (manifest)["unused"]);
+}
+
+TEST_F (UtilsTest, JsonStreamLoaderStopAndErrors) {
+  int seen = 0;
+  JsonUtils::JsonStreamLoader loader;
+  loader.on ("items/*", [&] (const nlohmann::json&, std::string_view) {
+    if (++seen == 2) {
+      loader.stop ();
+    }
+  });
+  EXPECT_FALSE (loader.parse (R"({"items": [1, 2, 3, 4]})"));
+  EXPECT_EQ (seen, 2);
+
+  EXPECT_THROW (loader.parse (R"({"items": [1, 2,)"), std::runtime_error);
+
+  FileIO::writeFile ("test_utils.json", R"({"items": [{"a": 1}, {"a": 2}]})");
+  JsonUtils::JsonStreamLoader fromFile;
+  int sum = 0;
+  fromFile.on ("items/*/a", [&] (const nlohmann::json& value, std::string_view) {
+    sum += value.get<int> ();
+  });
+  EXPECT_TRUE (fromFile.parseFile ("test_utils.json"));
+  EXPECT_EQ (sum, 3);
+}
+
+TEST_F (UtilsTest, AssetIndexLookup) {
+  // LibTester compiles the index of standalone/tests/fixtures/asset_index
+  namespace AssetIndex = DotNameUtils::AssetIndex;
+  ASSERT_EQ (AssetIndex::size (), 3u);
+  EXPECT_EQ (AssetIndex::at (0).path, "a.txt"); // sorted for binary search
+  EXPECT_EQ (AssetIndex::at (1).path, "shaders/wave.glsl");
+  EXPECT_EQ (AssetIndex::at (2).path, "z/last.json");
+  EXPECT_EQ (AssetIndex::at (0).size, 5u);
+
+  auto found = AssetIndex::find ("shaders/wave.glsl");
+  ASSERT_TRUE (found.has_value ());
+  EXPECT_EQ (found->path, "shaders/wave.glsl");
+  EXPECT_EQ (found->size, 15u);
+  EXPECT_EQ (AssetIndex::find ("z/last.json")->size, 2u);
+
+  EXPECT_FALSE (AssetIndex::contains ("shaders")); // directories are not entries
+  EXPECT_FALSE (AssetIndex::contains ("b.txt"));
+  EXPECT_FALSE (AssetIndex::contains ("no/such/asset.bin"));
+}
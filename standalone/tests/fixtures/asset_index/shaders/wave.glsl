@@ -0,0 +1 @@
+void main () {}
\ No newline at end of file
@@ -0,0 +1,21 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Build host tool: packs the asset directory into assets.pack (see cmake/tmplt-assets.cmake)
+
+#include <Assets/AssetPackFormat.hpp>
+
+#include <iostream>
+#include <string>
+
+int main (int argc, char** argv) {
+  if (argc != 3) {
+    std::cerr << "usage: " << argv[0] << " <asset directory> <output pack>" << std::endl;
+    return 2;
+  }
+  std::string error;
+  if (!AssetPackFormat::writePack (argv[1], argv[2], &error)) {
+    std::cerr << "assetpack: " << error << std::endl;
+    return 1;
+  }
+  return 0;
+}
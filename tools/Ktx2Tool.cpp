@@ -0,0 +1,124 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Build host tool: compresses PNG/JPEG assets into KTX2 (BC1/BC3 or ETC2), see
+// cmake/tmplt-assets.cmake
+
+#include <Assets/ImageDecoder.hpp>
+#include <Assets/Ktx2.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <system_error>
+#include <vector>
+
+namespace {
+  int usage (const char* program) {
+    std::cerr << "usage: " << program
+              << " [--format bc|etc2] [--mips] [--flip] [--srgb] <input image> <output.ktx2>"
+              << std::endl;
+    return 2;
+  }
+
+  // 2x2 box filter, odd edges repeat the last texel
+  std::vector<std::uint8_t> halve (const std::vector<std::uint8_t>& rgba, int width, int height) {
+    const int w = std::max (1, width / 2), h = std::max (1, height / 2);
+    std::vector<std::uint8_t> out (static_cast<std::size_t> (w) * h * 4);
+    for (int y = 0; y < h; ++y) {
+      for (int x = 0; x < w; ++x) {
+        const int x0 = std::min (2 * x, width - 1), x1 = std::min (2 * x + 1, width - 1);
+        const int y0 = std::min (2 * y, height - 1), y1 = std::min (2 * y + 1, height - 1);
+        for (int c = 0; c < 4; ++c) {
+          const auto at = [&] (int sx, int sy) {
+            return rgba[(static_cast<std::size_t> (sy) * width + sx) * 4 + c];
+          };
+          out[(static_cast<std::size_t> (y) * w + x) * 4 + c] = static_cast<std::uint8_t> (
+              (at (x0, y0) + at (x1, y0) + at (x0, y1) + at (x1, y1) + 2) / 4);
+        }
+      }
+    }
+    return out;
+  }
+}
+
+int main (int argc, char** argv) {
+  std::string family = "bc";
+  bool mips = false, flip = false, srgb = false;
+  std::vector<std::string> paths;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    if (arg == "--format" && i + 1 < argc) {
+      family = argv[++i];
+    } else if (arg == "--mips") {
+      mips = true;
+    } else if (arg == "--flip") {
+      flip = true;
+    } else if (arg == "--srgb") {
+      srgb = true;
+    } else {
+      paths.push_back (arg);
+    }
+  }
+  if (paths.size () != 2 || (family != "bc" && family != "etc2")) {
+    return usage (argv[0]);
+  }
+
+  std::ifstream in (paths[0], std::ios::binary);
+  const std::vector<char> encoded ((std::istreambuf_iterator<char> (in)),
+                                   std::istreambuf_iterator<char> ());
+  DecodedPixels image = ImageDecoder::decode (
+      ImageDecodeJob{ encoded.data (), encoded.size (), 4, flip });
+  if (!image.ok ()) {
+    std::cerr << "ktx2tool: " << paths[0] << ": " << (encoded.empty () ? "unreadable" : image.error)
+              << std::endl;
+    return 1;
+  }
+
+  // Opaque images take the 8 byte per block formats
+  bool opaque = true;
+  for (std::size_t i = 3; i < image.pixels.size () && opaque; i += 4) {
+    opaque = image.pixels.data ()[i] == 255;
+  }
+  using BlockCompression::Format;
+  const Format format = family == "bc" ? (opaque ? Format::Bc1 : Format::Bc3)
+                                       : (opaque ? Format::Etc2Rgb : Format::Etc2Rgba);
+
+  std::vector<Ktx2::LevelData> levels;
+  std::vector<std::uint8_t> rgba (image.pixels.data (), image.pixels.data () + image.pixels.size ());
+  int width = image.width, height = image.height;
+  while (true) {
+    levels.push_back ({ BlockCompression::compress (format, rgba.data (), width, height), width,
+                        height });
+    if (!mips || (width == 1 && height == 1)) {
+      break;
+    }
+    rgba = halve (rgba, width, height);
+    width = std::max (1, width / 2);
+    height = std::max (1, height / 2);
+  }
+  const std::vector<std::uint8_t> file = Ktx2::write (format, srgb, flip, levels);
+
+  // Same temporary + rename scheme as the asset pack, a failed build leaves no partial file
+  const std::filesystem::path output (paths[1]);
+  std::filesystem::path temporary = output;
+  temporary += ".tmp";
+  {
+    std::ofstream out (temporary, std::ios::out | std::ios::trunc | std::ios::binary);
+    out.write (reinterpret_cast<const char*> (file.data ()),
+               static_cast<std::streamsize> (file.size ()));
+    if (!out) {
+      std::cerr << "ktx2tool: cannot write " << temporary.string () << std::endl;
+      return 1;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename (temporary, output, ec);
+  if (ec) {
+    std::cerr << "ktx2tool: " << ec.message () << std::endl;
+    return 1;
+  }
+  return 0;
+}
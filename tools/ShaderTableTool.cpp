@@ -0,0 +1,47 @@
+// MIT License
+// Copyright (c) 2024-2025 Tomáš Mark
+// Build host tool: converts the bundled ShaderToy shaders into a constexpr table
+// (see cmake/tmplt-shaders.cmake)
+
+#include <Shaders/ShaderTable.hpp>
+
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+int main (int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "usage: " << argv[0] << " <output header> <Shadertoy/*.hpp>..." << std::endl;
+    return 2;
+  }
+  try {
+    std::vector<ShaderTable::Source> sources;
+    for (int i = 2; i < argc; ++i) {
+      std::ifstream file (argv[i], std::ios::binary);
+      if (!file) {
+        std::cerr << "shadertable: cannot read " << argv[i] << std::endl;
+        return 1;
+      }
+      const std::string header ((std::istreambuf_iterator<char> (file)),
+                                std::istreambuf_iterator<char> ());
+      if (auto source = ShaderTable::extractSource (header)) {
+        sources.push_back (std::move (*source));
+      }
+    }
+
+    const std::string table = ShaderTable::generateHeader (std::move (sources));
+    std::ofstream output (argv[1], std::ios::binary | std::ios::trunc);
+    output << table;
+    if (!output) {
+      std::cerr << "shadertable: cannot write " << argv[1] << std::endl;
+      return 1;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "shadertable: " << e.what () << std::endl;
+    return 1;
+  }
+  return 0;
+}